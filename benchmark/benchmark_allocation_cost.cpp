@@ -0,0 +1,70 @@
+#include "oakum/oakum_api.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Measures cost of a tracked allocation and deallocation pair for different configurations of the library. Allocations
+// are kept alive in batches, so the registry contains a realistic number of live allocations.
+//
+// Usage: OakumBenchmarkAllocationCost [iterations]
+
+constexpr static size_t batchSize = 1000;
+
+static double measure(const char *name, const OakumInitArgs *initArgs, size_t iterations) {
+    if (initArgs != nullptr && oakumInit(initArgs) != OAKUM_SUCCESS) {
+        std::cerr << "Failed to initialize Oakum for " << name << '\n';
+        return 0;
+    }
+
+    std::vector<char *> batch(batchSize);
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i += batchSize) {
+        for (char *&memory : batch) {
+            memory = new char[16];
+        }
+        for (char *memory : batch) {
+            delete[] memory;
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    if (initArgs != nullptr) {
+        oakumDeinit(false);
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+int main(int argc, char **argv) {
+    size_t iterations = 1000000;
+    if (argc > 1) {
+        iterations = std::stoul(argv[1]);
+    }
+
+    OakumInitArgs noStackTraces{};
+    OakumInitArgs callerStackTraces{};
+    callerStackTraces.trackStackTraces = true;
+    callerStackTraces.stackTraceMode = OAKUM_STACK_TRACE_MODE_CALLER;
+    OakumInitArgs adaptiveStackTraces{};
+    adaptiveStackTraces.trackStackTraces = true;
+    adaptiveStackTraces.stackTraceMode = OAKUM_STACK_TRACE_MODE_ADAPTIVE;
+    OakumInitArgs fullStackTraces{};
+    fullStackTraces.trackStackTraces = true;
+    fullStackTraces.stackTraceMode = OAKUM_STACK_TRACE_MODE_FULL;
+
+    const std::pair<const char *, const OakumInitArgs *> configurations[] = {
+        {"untracked", nullptr},
+        {"no stack traces", &noStackTraces},
+        {"caller", &callerStackTraces},
+        {"adaptive", &adaptiveStackTraces},
+        {"full stack traces", &fullStackTraces},
+    };
+
+    std::cout << std::setw(20) << "Configuration" << std::setw(24) << "new+delete [ns]" << '\n';
+    for (const auto &[name, initArgs] : configurations) {
+        std::cout << std::setw(20) << name << std::setw(24) << measure(name, initArgs, iterations) << '\n';
+    }
+    return 0;
+}
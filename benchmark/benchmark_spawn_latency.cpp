@@ -0,0 +1,71 @@
+#include "source/linux/child_process.h"
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// Measures latency of spawning a child process, which Oakum does when resolving source locations with addr2line, as
+// a function of the memory used by the parent. ChildProcess is compared to a plain fork()+exec(), whose cost grows
+// with the size of the address space, because page tables of the parent have to be copied.
+//
+// Usage: OakumBenchmarkSpawnLatency [iterations] [residentMegabytes...]
+
+constexpr static const char *childBinary = "true";
+
+static double measureChildProcess(size_t iterations) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        ChildProcess::runForOutput(childBinary, {});
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+static double measureFork(size_t iterations) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        const pid_t pid = fork();
+        FATAL_ERROR_ON_FAILED_SYSCALL(pid);
+        if (pid == 0) {
+            execlp(childBinary, childBinary, nullptr);
+            _exit(127);
+        }
+        int status{};
+        FATAL_ERROR_ON_FAILED_SYSCALL(waitpid(pid, &status, 0));
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char **argv) {
+    size_t iterations = 20;
+    std::vector<size_t> residentMegabytes = {0, 64, 256, 1024};
+    if (argc > 1) {
+        iterations = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+        residentMegabytes.clear();
+        for (int argIndex = 2; argIndex < argc; argIndex++) {
+            residentMegabytes.push_back(std::stoul(argv[argIndex]));
+        }
+    }
+
+    std::cout << std::setw(12) << "RSS [MB]" << std::setw(24) << "ChildProcess [us]" << std::setw(24) << "fork+exec [us]" << '\n';
+    for (size_t megabytes : residentMegabytes) {
+        // Touch every page, so the memory is actually resident and mapped in page tables
+        const size_t size = megabytes * 1024 * 1024;
+        std::unique_ptr<char[]> memory{new char[size]};
+        memset(memory.get(), 1, size);
+
+        const double childProcessLatency = measureChildProcess(iterations);
+        const double forkLatency = measureFork(iterations);
+        std::cout << std::setw(12) << megabytes << std::setw(24) << childProcessLatency << std::setw(24) << forkLatency << '\n';
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "source/background_symbolizer.h"
+#include "source/oakum_controller.h"
+
+namespace Oakum {
+BackgroundSymbolizer::BackgroundSymbolizer(ResolveFunction &&resolveFunction)
+    : resolveFunction(std::move(resolveFunction)),
+      internedStacks(std::make_unique<std::atomic<uint64_t>[]>(internedStacksCapacity)) {}
+
+BackgroundSymbolizer::~BackgroundSymbolizer() {
+    stop();
+}
+
+void BackgroundSymbolizer::start() {
+    thread.start([this]() { run(); });
+}
+
+void BackgroundSymbolizer::stop() {
+    thread.stop();
+}
+
+void BackgroundSymbolizer::onStack(void *const *frames, size_t framesCount) {
+    if (framesCount == 0 || !internStack(hashStack(frames, framesCount))) {
+        return;
+    }
+
+    {
+        RaiiOakumIgnore raiiIgnore{};
+        const auto lockGuard = thread.lock();
+        pendingAddresses.insert(pendingAddresses.end(), frames, frames + framesCount);
+    }
+    thread.notify();
+}
+
+void BackgroundSymbolizer::waitUntilIdle() {
+    auto lockGuard = thread.lock();
+    idleCondition.wait(lockGuard, [this]() {
+        return (pendingAddresses.empty() && !busy) || thread.isStopRequested();
+    });
+}
+
+void BackgroundSymbolizer::pause() {
+    const auto lockGuard = thread.lock();
+    pausesCount++;
+}
+
+void BackgroundSymbolizer::resume() {
+    {
+        const auto lockGuard = thread.lock();
+        pausesCount--;
+    }
+    thread.notify();
+}
+
+BackgroundSymbolizer::RaiiPause::RaiiPause(BackgroundSymbolizer *symbolizer) : symbolizer(symbolizer) {
+    if (symbolizer != nullptr) {
+        symbolizer->pause();
+    }
+}
+
+BackgroundSymbolizer::RaiiPause::~RaiiPause() {
+    if (symbolizer != nullptr) {
+        symbolizer->resume();
+    }
+}
+
+uint64_t BackgroundSymbolizer::hashStack(void *const *frames, size_t framesCount) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t frameIndex = 0; frameIndex < framesCount; frameIndex++) {
+        hash = (hash ^ reinterpret_cast<uintptr_t>(frames[frameIndex])) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+    }
+    return hash != 0 ? hash : 1; // zero marks an unused slot
+}
+
+bool BackgroundSymbolizer::internStack(uint64_t hash) {
+    size_t slotIndex = static_cast<size_t>(hash) & (internedStacksCapacity - 1);
+    for (size_t probeIndex = 0; probeIndex < maxProbesCount; probeIndex++) {
+        std::atomic<uint64_t> &slot = internedStacks[slotIndex];
+        uint64_t slotHash = slot.load(std::memory_order_relaxed);
+        if (slotHash == hash) {
+            return false;
+        }
+        if (slotHash == 0 && slot.compare_exchange_strong(slotHash, hash, std::memory_order_relaxed)) {
+            return true;
+        }
+        if (slotHash == hash) {
+            return false; // another thread has interned the same stack
+        }
+        slotIndex = (slotIndex + 1) & (internedStacksCapacity - 1);
+    }
+    return false;
+}
+
+void BackgroundSymbolizer::run() {
+    lowerThreadPriority();
+
+    auto lockGuard = thread.lock();
+    while (thread.wait(lockGuard, [this]() { return !pendingAddresses.empty() && pausesCount == 0; })) {
+        std::vector<void *> addresses = std::move(pendingAddresses);
+        pendingAddresses.clear();
+        busy = true;
+        lockGuard.unlock();
+
+        size_t addressIndex = 0;
+        for (; addressIndex < addresses.size(); addressIndex++) {
+            if (thread.isStopRequested() || pausesCount.load(std::memory_order_relaxed) > 0) {
+                break;
+            }
+            if (resolvedAddresses.insert(addresses[addressIndex]).second) {
+                resolveFunction(addresses[addressIndex]);
+            }
+        }
+
+        lockGuard.lock();
+        pendingAddresses.insert(pendingAddresses.begin(), addresses.begin() + addressIndex, addresses.end());
+        busy = false;
+        idleCondition.notify_all();
+    }
+    idleCondition.notify_all();
+}
+} // namespace Oakum
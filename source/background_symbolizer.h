@@ -0,0 +1,62 @@
+#pragma once
+
+#include "source/background_thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace Oakum {
+
+// Resolves addresses of newly seen stacks on a low priority thread, so results are already cached, when a report is
+// requested. Stacks are interned by a hash of their frames in a fixed size table, claimed with a compare-and-swap, so
+// allocating threads queue each unique stack only once and take a lock only for new stacks. Stacks, which do not fit
+// in the table, are resolved on demand as usual. Each address is passed to the resolve function at most once.
+// Resolution requested by the application pauses the thread, so both do not resolve the same addresses at once.
+class BackgroundSymbolizer {
+public:
+    using ResolveFunction = std::function<void(void *address)>;
+
+    struct RaiiPause {
+        RaiiPause(BackgroundSymbolizer *symbolizer); // null symbolizer is accepted for convenience
+        ~RaiiPause();
+        BackgroundSymbolizer *const symbolizer;
+    };
+
+    BackgroundSymbolizer(ResolveFunction &&resolveFunction);
+    ~BackgroundSymbolizer();
+
+    void start();
+    void stop();
+    void onStack(void *const *frames, size_t framesCount);
+    void waitUntilIdle();
+    void pause();
+    void resume();
+
+protected:
+    static uint64_t hashStack(void *const *frames, size_t framesCount);
+    bool internStack(uint64_t hash);
+    static void lowerThreadPriority();
+    void run();
+
+    constexpr static inline size_t internedStacksCapacity = 16384; // must be a power of two
+    constexpr static inline size_t maxProbesCount = 32;
+
+    const ResolveFunction resolveFunction;
+    const std::unique_ptr<std::atomic<uint64_t>[]> internedStacks; // zero marks an unused slot
+
+    // Guarded by the lock of the thread, so changes wake it up
+    std::condition_variable idleCondition = {};
+    std::vector<void *> pendingAddresses = {};
+    bool busy = false;
+    std::atomic<size_t> pausesCount = 0; // modified under the lock, read by the background thread between addresses
+    std::unordered_set<void *> resolvedAddresses = {}; // accessed only by the background thread
+    BackgroundThread thread = {};
+};
+
+} // namespace Oakum
@@ -0,0 +1,34 @@
+#include "source/background_thread.h"
+#include "source/oakum_controller.h"
+
+namespace Oakum {
+BackgroundThread::~BackgroundThread() {
+    stop();
+}
+
+void BackgroundThread::start(Function &&function) {
+    stopRequested = false;
+
+    RaiiOakumIgnore raiiIgnore{};
+    thread = std::thread{[function = std::move(function)]() {
+        RaiiOakumIgnore raiiIgnore{};
+        function();
+    }};
+}
+
+void BackgroundThread::stop(const Function &wakeUpFunction) {
+    if (!thread.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard lockGuard{mutex};
+        stopRequested = true;
+    }
+    condition.notify_all();
+    if (wakeUpFunction) {
+        wakeUpFunction();
+    }
+    thread.join();
+}
+} // namespace Oakum
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Oakum {
+
+// Dedicated thread of the library. Everything allocated by the thread is internal to the library, and so is the state
+// of the thread itself, which lives until the thread is joined, so neither is tracked. A stop request wakes up waits
+// on the condition variable of the thread. Threads blocked elsewhere, e.g. on a pipe, are woken up by the function
+// passed to stop(). State shared with the thread may be guarded by its lock, so changes of it can wake the waits too.
+class BackgroundThread {
+public:
+    using Function = std::function<void()>;
+
+    BackgroundThread() = default;
+    ~BackgroundThread();
+    BackgroundThread(const BackgroundThread &) = delete;
+    BackgroundThread &operator=(const BackgroundThread &) = delete;
+
+    void start(Function &&function);
+    void stop(const Function &wakeUpFunction = {});
+    bool isStarted() const { return thread.joinable(); }
+    bool isStopRequested() const { return stopRequested.load(std::memory_order_relaxed); }
+
+    std::unique_lock<std::mutex> lock() { return std::unique_lock{mutex}; }
+    void notify() { condition.notify_all(); }
+
+    // Both return false, if a stop was requested
+    template <typename PredicateT>
+    bool wait(std::unique_lock<std::mutex> &lockGuard, PredicateT &&predicate) {
+        condition.wait(lockGuard, [&]() { return isStopRequested() || predicate(); });
+        return !isStopRequested();
+    }
+    bool waitFor(std::unique_lock<std::mutex> &lockGuard, std::chrono::milliseconds interval) {
+        return !condition.wait_for(lockGuard, interval, [this]() { return isStopRequested(); });
+    }
+
+protected:
+    std::mutex mutex = {};
+    std::condition_variable condition = {};
+    std::atomic<bool> stopRequested = false;
+    std::thread thread = {};
+};
+
+} // namespace Oakum
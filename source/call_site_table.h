@@ -0,0 +1,148 @@
+#pragma once
+
+#include "source/include/oakum/oakum_api.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Oakum {
+
+// Live allocation counters aggregated per call site, i.e. per return address of the allocation operator. Sites are
+// kept in a fixed size open addressing hash table. Slots are claimed with a single compare-and-swap and never released,
+// so looking up a site does not take any locks. Sites, which do not fit in the table, are aggregated in an overflow site.
+// A site is escalated once its live allocations count or live bytes reach a threshold. Escalation is never reverted.
+// Optionally, lifetimes and sizes of freed allocations are counted per site in histograms with power of two buckets.
+class CallSiteTable {
+public:
+    constexpr static inline size_t histogramBucketsCount = OAKUM_HISTOGRAM_BUCKETS_COUNT;
+
+    struct CallSite {
+        std::atomic<uintptr_t> address = 0; // zero marks an unused slot and the overflow site
+        std::atomic<size_t> liveAllocationsCount = 0;
+        std::atomic<size_t> liveBytes = 0;
+        std::atomic<uint64_t> totalAllocationsCount = 0;
+        std::atomic<uint64_t> totalBytes = 0;
+        std::atomic<bool> escalated = false;
+    };
+    struct Histograms {
+        std::atomic<uint64_t> lifetimesNs[histogramBucketsCount] = {};
+        std::atomic<uint64_t> sizes[histogramBucketsCount] = {};
+    };
+
+    // Zero threshold disables the criterion
+    CallSiteTable(size_t escalationLiveAllocationsCount, size_t escalationLiveBytes, bool trackHistograms)
+        : sites(std::make_unique<CallSite[]>(capacity)),
+          histograms(trackHistograms ? std::make_unique<Histograms[]>(getSitesCount()) : nullptr),
+          escalationLiveAllocationsCount(escalationLiveAllocationsCount),
+          escalationLiveBytes(escalationLiveBytes) {}
+
+    CallSite &getCallSite(const void *address) {
+        return findSite(reinterpret_cast<uintptr_t>(address));
+    }
+
+    void onAllocation(CallSite &site, size_t size) {
+        const size_t liveAllocationsCount = site.liveAllocationsCount.fetch_add(1, std::memory_order_relaxed) + 1;
+        const size_t liveBytes = site.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        site.totalAllocationsCount.fetch_add(1, std::memory_order_relaxed);
+        site.totalBytes.fetch_add(size, std::memory_order_relaxed);
+
+        if (!site.escalated.load(std::memory_order_relaxed)) {
+            const bool escalate = (escalationLiveAllocationsCount != 0 && liveAllocationsCount >= escalationLiveAllocationsCount) ||
+                                  (escalationLiveBytes != 0 && liveBytes >= escalationLiveBytes);
+            if (escalate) {
+                site.escalated.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static void onDeallocation(CallSite &site, size_t size) {
+        site.liveAllocationsCount.fetch_sub(1, std::memory_order_relaxed);
+        site.liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    // Each site, including the overflow site, has a stable index lower than the sites count
+    constexpr static size_t getSitesCount() {
+        return capacity + 1;
+    }
+
+    size_t getSiteIndex(const CallSite &site) const {
+        return &site == &overflowSite ? capacity : static_cast<size_t>(&site - sites.get());
+    }
+
+    bool hasHistograms() const {
+        return histograms != nullptr;
+    }
+
+    const Histograms &getHistograms(const CallSite &site) const {
+        return histograms[getSiteIndex(site)];
+    }
+
+    void onRetirement(const CallSite &site, size_t size, uint64_t lifetimeNs) {
+        Histograms &siteHistograms = histograms[getSiteIndex(site)];
+        siteHistograms.lifetimesNs[getBucketIndex(lifetimeNs)].fetch_add(1, std::memory_order_relaxed);
+        siteHistograms.sizes[getBucketIndex(size)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Bucket i counts values in range [2^i, 2^(i+1)). The first bucket includes zero and the last one all greater values.
+    static size_t getBucketIndex(uint64_t value) {
+        size_t bucketIndex = 0;
+        for (uint32_t shift = 32; shift > 0; shift /= 2) {
+            if ((value >> shift) != 0) {
+                value >>= shift;
+                bucketIndex += shift;
+            }
+        }
+        return std::min(bucketIndex, histogramBucketsCount - 1);
+    }
+
+    template <typename FunctionT>
+    void forEachCallSite(FunctionT &&function) const {
+        for (size_t siteIndex = 0; siteIndex < capacity; siteIndex++) {
+            if (sites[siteIndex].address.load(std::memory_order_acquire) != 0) {
+                function(sites[siteIndex]);
+            }
+        }
+        if (overflowSite.totalAllocationsCount.load(std::memory_order_relaxed) != 0) {
+            function(overflowSite);
+        }
+    }
+
+private:
+    constexpr static inline size_t capacity = 4096; // must be a power of two
+    constexpr static inline size_t maxProbesCount = 64;
+
+    CallSite &findSite(uintptr_t address) {
+        if (address == 0) {
+            return overflowSite;
+        }
+
+        // Return addresses are not uniformly distributed, so mix the bits before masking
+        size_t siteIndex = static_cast<size_t>((address * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+        for (size_t probeIndex = 0; probeIndex < maxProbesCount; probeIndex++) {
+            CallSite &site = sites[siteIndex];
+            uintptr_t siteAddress = site.address.load(std::memory_order_acquire);
+            if (siteAddress == address) {
+                return site;
+            }
+            if (siteAddress == 0 && site.address.compare_exchange_strong(siteAddress, address, std::memory_order_acq_rel)) {
+                return site;
+            }
+            if (siteAddress == address) {
+                return site; // another thread has claimed the slot for the same address
+            }
+            siteIndex = (siteIndex + 1) & (capacity - 1);
+        }
+        return overflowSite;
+    }
+
+    const std::unique_ptr<CallSite[]> sites;
+    const std::unique_ptr<Histograms[]> histograms;
+    const size_t escalationLiveAllocationsCount;
+    const size_t escalationLiveBytes;
+    CallSite overflowSite = {};
+};
+
+} // namespace Oakum
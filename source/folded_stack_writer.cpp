@@ -0,0 +1,45 @@
+#include "source/folded_stack_writer.h"
+#include "source/module_registry.h"
+#include "source/profile.h"
+
+#include <algorithm>
+#include <string>
+
+namespace Oakum {
+static void writeFrameName(std::ostream &stream, const OakumStackFrame &frame, ModuleRegistry &modules) {
+    if (frame.symbolName != nullptr) {
+        // Semicolons separate frames, so they cannot appear in names
+        std::string name = frame.symbolName;
+        std::replace(name.begin(), name.end(), ';', ':');
+        stream << name;
+        return;
+    }
+
+    const ModuleRegistry::Module *module = modules.getModule(frame.moduleIndex);
+    if (module != nullptr) {
+        const size_t separatorIndex = module->path.find_last_of("/\\");
+        stream << (separatorIndex == std::string::npos ? module->path : module->path.substr(separatorIndex + 1));
+        stream << "+0x" << std::hex << frame.moduleOffset << std::dec;
+    } else {
+        stream << "0x" << std::hex << reinterpret_cast<uintptr_t>(frame.address) << std::dec;
+    }
+}
+
+void FoldedStackWriter::write(std::ostream &stream, const Profile &profile, ModuleRegistry &modules, bool cumulative) {
+    for (const Profile::Sample &sample : profile.samples) {
+        const uint64_t value = cumulative ? sample.totalBytes : sample.liveBytes;
+        if (value == 0 || sample.frameIndices.empty()) {
+            continue;
+        }
+
+        for (auto frameIndex = sample.frameIndices.rbegin(); frameIndex != sample.frameIndices.rend(); frameIndex++) {
+            if (frameIndex != sample.frameIndices.rbegin()) {
+                stream << ';';
+            }
+            writeFrameName(stream, profile.frames[*frameIndex], modules);
+        }
+        stream << ' ' << value << '\n';
+    }
+}
+
+} // namespace Oakum
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ostream>
+
+namespace Oakum {
+class ModuleRegistry;
+struct Profile;
+
+// Writes a profile as folded stacks, i.e. one line per unique stack trace with frames ordered from the outermost one,
+// separated with semicolons and followed by a value. This is the input of flamegraph.pl and compatible renderers.
+// Frames without a symbol name are written as a module name and an offset. Stacks with a zero value are omitted.
+struct FoldedStackWriter {
+    FoldedStackWriter() = delete;
+    static void write(std::ostream &stream, const Profile &profile, ModuleRegistry &modules, bool cumulative);
+};
+
+} // namespace Oakum
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "source/include/oakum/oakum_api.h"
+#include "source/thread_safety_policy.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Oakum {
+
+// Ignore regions, whose tokens have been handed out to other threads. A region lasts from the moment the ignore counter
+// of a thread becomes non-zero until it drops back to zero. While it is active, it occupies a slot holding its token, so
+// threads, which adopted the token, stop ignoring as soon as the region ends. Checking a token reads a single atomic
+// without locking. Slots are taken only by regions, which hand out a token, and are reused after the region ends. They
+// are allocated in chunks, which are never released, so readers never see freed memory. Tokens contain a sequence number
+// shared by all instances, so tokens of a previous instance never match a slot. Claiming may allocate, so the caller has
+// to make sure this memory is not tracked. Once all slots are taken, regions hand out non-ignoring tokens.
+class IgnoreRegions {
+public:
+    IgnoreRegions(bool threadSafe) : threadSafe(threadSafe), firstSequence(sequenceCounter.load() + 1) {}
+
+    OakumIgnoreToken claim() {
+        const auto lock = ThreadSafety::lock(slotsLock, threadSafe);
+        if (freeSlots.empty() && !addChunk()) {
+            return 0;
+        }
+        const size_t slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+        const OakumIgnoreToken token = (++sequenceCounter << slotIndexBits) | slotIndex;
+        getSlot(slotIndex)->store(token, std::memory_order_release);
+        return token;
+    }
+
+    // Does not allocate, so it can be called at the very end of the region
+    void release(OakumIgnoreToken token) {
+        std::atomic<uint64_t> *slot = getSlot(getSlotIndex(token));
+        uint64_t expectedToken = token;
+        if (slot == nullptr || !slot->compare_exchange_strong(expectedToken, 0u, std::memory_order_release)) {
+            return; // the token belongs to a previous instance
+        }
+        const auto lock = ThreadSafety::lock(slotsLock, threadSafe);
+        freeSlots.push_back(getSlotIndex(token));
+    }
+
+    bool isActive(OakumIgnoreToken token) const {
+        const std::atomic<uint64_t> *slot = getSlot(getSlotIndex(token));
+        return token != 0 && slot != nullptr && slot->load(std::memory_order_acquire) == token;
+    }
+
+    // Tokens of regions, which have already ended, are valid as well
+    bool isIssued(OakumIgnoreToken token) const {
+        const uint64_t sequence = token >> slotIndexBits;
+        return sequence >= firstSequence && sequence <= sequenceCounter.load();
+    }
+
+protected:
+    constexpr static inline size_t slotIndexBits = 16;
+    constexpr static inline size_t chunkSlotsCount = 1024;
+    constexpr static inline size_t chunksCount = (size_t{1} << slotIndexBits) / chunkSlotsCount;
+
+    static size_t getSlotIndex(OakumIgnoreToken token) {
+        return static_cast<size_t>(token) & ((size_t{1} << slotIndexBits) - 1);
+    }
+
+    std::atomic<uint64_t> *getSlot(size_t slotIndex) const {
+        std::atomic<uint64_t> *chunk = chunks[slotIndex / chunkSlotsCount].load(std::memory_order_acquire);
+        return chunk != nullptr ? chunk + slotIndex % chunkSlotsCount : nullptr;
+    }
+
+    bool addChunk() {
+        if (chunkStorage.back() != nullptr) {
+            return false;
+        }
+        size_t chunkIndex = 0;
+        while (chunkStorage[chunkIndex] != nullptr) {
+            chunkIndex++;
+        }
+
+        // Released slots are pushed back without allocating
+        freeSlots.reserve((chunkIndex + 1) * chunkSlotsCount);
+        chunkStorage[chunkIndex] = std::make_unique<std::atomic<uint64_t>[]>(chunkSlotsCount);
+        chunks[chunkIndex].store(chunkStorage[chunkIndex].get(), std::memory_order_release);
+        for (size_t slotIndex = (chunkIndex + 1) * chunkSlotsCount; slotIndex > chunkIndex * chunkSlotsCount; slotIndex--) {
+            freeSlots.push_back(slotIndex - 1);
+        }
+        return true;
+    }
+
+    static inline std::atomic<uint64_t> sequenceCounter = 0;
+
+    const bool threadSafe;
+    const uint64_t firstSequence;
+    std::mutex slotsLock = {};
+    std::vector<size_t> freeSlots = {};
+    std::array<std::unique_ptr<std::atomic<uint64_t>[]>, chunksCount> chunkStorage = {};
+    std::array<std::atomic<std::atomic<uint64_t> *>, chunksCount> chunks = {};
+};
+
+} // namespace Oakum
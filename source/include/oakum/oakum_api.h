@@ -21,17 +21,123 @@ extern "C" {
 using OakumAllocationIdType = uint64_t;
 
 #ifndef OAKUM_MAX_STACK_FRAMES_COUNT
-/// @brief Maximum number of stack frames captured by the library.
+/// @brief Default number of stack frames captured by the library. See #OakumInitArgs.maxStackFramesCount.
 #define OAKUM_MAX_STACK_FRAMES_COUNT 10
 #endif
 
+/// @brief Upper limit of #OakumInitArgs.maxStackFramesCount.
+#define OAKUM_STACK_FRAMES_COUNT_LIMIT 256
+
+/// @brief Value of #OakumStackFrame.moduleIndex for frames, which do not belong to any known module.
+#define OAKUM_UNKNOWN_MODULE_INDEX SIZE_MAX
+
+/// @brief Number of buckets in histograms of #OakumCallSiteHistograms. Bucket `i` counts values in range `[2^i, 2^(i+1))`.
+/// The first bucket also counts zeros and the last one counts all greater values.
+#define OAKUM_HISTOGRAM_BUCKETS_COUNT 48
+
+/// @brief Value of #OakumSharedStatistics.magic. Reads as "OAKUMSTS" in memory on little-endian machines.
+#define OAKUM_SHARED_STATISTICS_MAGIC 0x5354534d554b414full
+
+/// @brief Value of #OakumSharedStatistics.version. Incremented on every change of the layout.
+#define OAKUM_SHARED_STATISTICS_VERSION 2
+
+/// @brief Capacity of #OakumSharedStatistics.topCallSites.
+#define OAKUM_SHARED_STATISTICS_TOP_CALL_SITES_COUNT 16
+
+/// @brief An opaque value describing ignore state of a thread. See #oakumGetIgnoreToken.
+using OakumIgnoreToken = uint64_t;
+
+/// @brief Amount of stack trace data captured for each allocation, when #OakumInitArgs.trackStackTraces is enabled.
+enum OakumStackTraceMode {
+    OAKUM_STACK_TRACE_MODE_FULL,     ///< @brief Capture up to #OakumInitArgs.maxStackFramesCount stack frames.
+    OAKUM_STACK_TRACE_MODE_CALLER,   ///< @brief Capture only the return address of the allocation operator, i.e. a single stack frame.
+                                     ///< @details This is orders of magnitude cheaper than walking the stack, so it is suitable for always-on tracking.
+                                     ///< Live allocations are additionally aggregated per call site. See #oakumGetCallSites.
+    OAKUM_STACK_TRACE_MODE_ADAPTIVE, ///< @brief Capture only the return address, until the call site looks suspicious, then capture full stack traces.
+                                     ///< @details A call site is escalated to full stack traces, once its live allocations reach one of the thresholds
+                                     ///< set by #OakumInitArgs.escalationLiveAllocationsCount and #OakumInitArgs.escalationLiveBytes. Allocations made
+                                     ///< before the escalation keep a single frame. Call sites are reported by #oakumGetCallSites.
+};
+
+/// @brief File format of a heap profile written by #oakumWriteProfile
+enum OakumProfileFormat {
+    OAKUM_PROFILE_FORMAT_PPROF,              ///< @brief Uncompressed `profile.proto` message of pprof. Can be opened with `go tool pprof` and compatible viewers.
+    OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES,  ///< @brief Folded stacks (`frame1;frame2;... bytes`) weighted by live bytes. Can be rendered with `flamegraph.pl`.
+                                             ///< @details Frames are ordered from the outermost one. Frames without a symbol name are written as `module+0xoffset`.
+    OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES, ///< @brief Folded stacks weighted by cumulative bytes allocated from each call site. Requires call site tracking.
+                                             ///< @details Cumulative values are maintained per call site, so each stack consists of a single frame. See #oakumGetCallSites.
+};
+
 /// @brief Input configuration of the library via #oakumInit function
 struct OakumInitArgs {
-    bool trackStackTraces = false;                ///< Enable stack trace tracking. See #OakumStackFrame for more information.
-    bool threadSafe = false;                      ///< Enable thread safety inside the library.
-    bool sortAllocations = false;                 ///< Sort allocations by their unique identifier in #oakumGetAllocations
-    const char *fallbackSymbolName = nullptr;     ///< Symbol name to be used, when #oakumResolveStackTraceSymbols fails to resolve the actual name. May be null.
-    const char *fallbackSourceFileName = nullptr; ///< Source file name to be used, when #oakumResolveStackTraceSourceLocations fails to resolve the actual name. May be null.
+    bool trackStackTraces = false;                                    ///< Enable stack trace tracking. See #OakumStackFrame for more information.
+    bool threadSafe = false;                                          ///< Enable thread safety inside the library. Ignored, if the library was compiled with `OAKUM_THREAD_SAFETY` other than `runtime`.
+    bool sortAllocations = false;                                     ///< Sort allocations by their unique identifier in #oakumGetAllocations
+    const char *fallbackSymbolName = nullptr;                         ///< Symbol name to be used, when #oakumResolveStackTraceSymbols fails to resolve the actual name. May be null.
+    const char *fallbackSourceFileName = nullptr;                     ///< Source file name to be used, when #oakumResolveStackTraceSourceLocations fails to resolve the actual name. May be null.
+    size_t threadCacheSize = 0;                                       ///< @brief Number of most recent allocations kept in a per-thread cache. Zero disables the caches.
+                                                                      ///< @details Allocations freed by the thread, which made them, before being pushed out of the cache by newer ones
+                                                                      ///< never reach the shared registry and do not contend on its lock. All caches are flushed by #oakumGetAllocations.
+                                                                      ///< Caches of exited threads are flushed as well and reused by new threads.
+    OakumStackTraceMode stackTraceMode = OAKUM_STACK_TRACE_MODE_FULL; ///< Amount of stack trace data captured for each allocation. Ignored, if #trackStackTraces is disabled.
+    size_t maxStackFramesCount = 0;                                   ///< @brief Maximum number of stack frames captured for each allocation. Zero selects #OAKUM_MAX_STACK_FRAMES_COUNT.
+                                                                      ///< @details Frames are stored out of line, so each allocation pays only for the frames actually captured.
+                                                                      ///< Must not exceed #OAKUM_STACK_FRAMES_COUNT_LIMIT.
+    size_t ignoreRulesFramesCount = 0;                                ///< @brief Number of innermost stack frames matched against ignore rules. Zero selects #maxStackFramesCount.
+                                                                      ///< @details The caller is matched first, so allocations made directly by ignored code are dropped without walking
+                                                                      ///< the stack. Once any rule is added, all other allocations walk this many frames, even if #trackStackTraces is
+                                                                      ///< disabled or only callers are captured. One matches only the caller and never walks the stack.
+                                                                      ///< Must not exceed #OAKUM_STACK_FRAMES_COUNT_LIMIT. See #oakumAddIgnoreRule.
+    size_t escalationLiveAllocationsCount = 1024;                     ///< @brief Live allocations count of a call site, which escalates it to full stack traces. Zero disables this criterion.
+                                                                      ///< @details Used only with #OAKUM_STACK_TRACE_MODE_ADAPTIVE.
+    size_t escalationLiveBytes = 16 * 1024 * 1024;                    ///< @brief Live bytes of a call site, which escalate it to full stack traces. Zero disables this criterion.
+                                                                      ///< @details Used only with #OAKUM_STACK_TRACE_MODE_ADAPTIVE.
+    bool trackLifetimes = false;                                      ///< @brief Count lifetimes and sizes of freed allocations per call site. Ignored, if call sites are not tracked.
+                                                                      ///< @details Each allocation is timestamped and its lifetime is added to a histogram of its call site, when it is freed.
+                                                                      ///< Call sites are tracked only in #OAKUM_STACK_TRACE_MODE_CALLER and #OAKUM_STACK_TRACE_MODE_ADAPTIVE. See #oakumGetChurnCallSites.
+    bool trackThreads = false;                                        ///< @brief Record the thread making each allocation and count live allocations per thread.
+                                                                      ///< @details See #OakumAllocation.threadId and #oakumGetThreadStatistics. Threads are identified by ids assigned by the
+                                                                      ///< operating system. Names are read on Linux only.
+    size_t trendSamplingIntervalMs = 0;                               ///< @brief Period of sampling live bytes of each call site in milliseconds. Zero disables sampling. Ignored, if call sites are not tracked.
+                                                                      ///< @details Samples are taken on a dedicated thread from counters maintained without locks, so allocating threads are
+                                                                      ///< not blocked. Call sites, whose live bytes keep growing, are reported by #oakumGetGrowingCallSites.
+    size_t trendWindowSamplesCount = 8;                               ///< Number of most recent samples of each call site kept by #trendSamplingIntervalMs. Must be at least 2, if sampling is enabled.
+    const char *symbolCacheDirectory = nullptr;                       ///< @brief Directory of a persistent cache of stack trace resolution results. May be null, which disables the cache.
+                                                                      ///< @details Results of #oakumResolveStackTraceSymbols and #oakumResolveStackTraceSourceLocations are stored per module
+                                                                      ///< and reused by subsequent runs of the same binaries. Modules are identified by their build id, so the cache is
+                                                                      ///< currently used only on Linux and only for modules linked with a build id.
+    bool backgroundSymbolization = false;                             ///< @brief Resolve newly seen stack traces on a low priority background thread. Ignored, if #trackStackTraces is disabled.
+                                                                      ///< @details Each unique stack trace is resolved once, shortly after it is first captured. Results are cached, so
+                                                                      ///< #oakumResolveStackTraceSymbols and #oakumResolveStackTraceSourceLocations mostly copy them. Allocations made by
+                                                                      ///< the background thread are ignored. Without #symbolCacheDirectory the results are kept only in memory.
+    const char *traceFilePath = nullptr;                              ///< @brief Path of a file, to which a timeline of allocations is streamed. May be null, which disables the timeline.
+                                                                      ///< @details Tracked allocations, deallocations and tracking scopes (see #oakumBeginScope) are written as Chrome trace
+                                                                      ///< events with timestamps, thread ids, sizes and scope names, along with a counter of live bytes. The file can be opened
+                                                                      ///< in Perfetto UI or chrome://tracing. Events are written in batches during the run and the file is closed by #oakumDeinit.
+    int reportSignal = 0;                                             ///< @brief Signal, which triggers writing a heap profile to #reportFilePath, e.g. `SIGUSR2`. Zero disables the handler.
+                                                                      ///< @details The signal handler only wakes up a dedicated reporter thread, which writes the profile as #oakumWriteProfile
+                                                                      ///< would. Allocating threads are blocked only while live allocations are aggregated. The profile is written to a temporary
+                                                                      ///< file and renamed, so it never appears partially written. Signals received during writing are coalesced into a single
+                                                                      ///< subsequent report. Enables thread safety. Supported only on Linux.
+    const char *reportFilePath = nullptr;                             ///< Path of a file written on #reportSignal. Existing file is overwritten. Must not be null, if #reportSignal is set.
+    OakumProfileFormat reportFormat = OAKUM_PROFILE_FORMAT_PPROF;     ///< Format of a profile written on #reportSignal.
+    const char *querySocketPath = nullptr;                            ///< @brief Path of a Unix domain socket, on which the library answers queries about live allocations. May be null.
+                                                                      ///< @details Queries are answered on a dedicated thread, so a running process can be inspected with the `oakum-ctl` tool.
+                                                                      ///< Each connection sends a single line: `stats`, `top [count]` (call sites by live bytes), `checkpoint`,
+                                                                      ///< `since <checkpoint>` (live allocations made after a checkpoint), `report` (all live allocations) or `threads` (live
+                                                                      ///< bytes per allocating thread, requires #trackThreads). Allocations are streamed from the library in chunks, so the
+                                                                      ///< listing is not an atomic snapshot. The socket is accessible only to the owner of the process and removed by
+                                                                      ///< #oakumDeinit. Enables thread safety. Supported only on Linux.
+    const char *sharedStatisticsName = nullptr;                       ///< @brief Name of a shared memory object, e.g. `/oakum-1234`, into which statistics are published. May be null.
+                                                                      ///< @details A dedicated thread periodically writes an #OakumSharedStatistics structure to the beginning of the object,
+                                                                      ///< so external monitors can map it and read the statistics without any interaction with the process. The object is
+                                                                      ///< accessible only to the owner of the process and removed by #oakumDeinit. An existing object is replaced only if
+                                                                      ///< it was published by this library in a process, which is no longer running. Supported only on Linux.
+    size_t sharedStatisticsIntervalMs = 100;                          ///< Period of updating #sharedStatisticsName in milliseconds. Must not be zero.
+    size_t peakSnapshotMargin = 0;                                    ///< @brief Capture live allocations, whenever live bytes exceed the previous snapshot by this many bytes. Zero disables snapshots.
+                                                                      ///< @details The first snapshot is captured, once live bytes reach the margin. Each snapshot aggregates live allocations
+                                                                      ///< per stack trace and replaces the previous one, so the library keeps only the state closest to the peak of heap usage.
+                                                                      ///< Capturing walks all live allocations, so a larger margin captures less often. See #oakumWritePeakProfile.
 };
 
 /// @brief Output configuration of the library reported by #oakumGetCapabilities function.
@@ -45,29 +151,165 @@ struct OakumCapabilities {
                                             ///< @details This capability will never be active unless #supportStackTraces is also active.
                                             ///< @details On some configurations retrieving symbol names of captured stack traces might not be possible, even if #supportStackTraces is enabled.
     bool threadSafe;                        ///< @brief If set to `true`, the library is ensuring thread safety with locks.
-                                            ///< @details Thread safety can be enabled/disabled by the user by setting #OakumInitArgs.threadSafe to a desired value.
+                                            ///< @details Thread safety can be enabled/disabled by the user by setting #OakumInitArgs.threadSafe to a desired value,
+                                            ///< unless it was forced at compile time with `OAKUM_THREAD_SAFETY` CMake option.
 };
 
 /// @brief Captured stack frame
 struct OakumStackFrame {
-    void *address;         ///< @brief Virtual address of captured stack frame.
-                           ///< @details If library is not tracking stack traces (see #OakumCapabilities), this field will be set to `NULL`.
-    char *symbolName;      ///< @brief Human-readable name of the function for the current stack frame.
-                           ///< @details This field will be initialized to `NULL`. It will be filled after a successfull call to #oakumResolveStackTraceSymbols.
-    char *fileName;        ///< @brief Name of the source file containing related code.
-                           ///< @details This field will be initialized to `NULL`. It will be filled after a successfull call to #oakumResolveStackTraceSourceLocations.
-    unsigned int fileLine; ///< @brief Line in the source file containing related code.
-                           ///< @details This field will be initialized to `NULL`. It will be filled after a successfull call to #oakumResolveStackTraceSourceLocations.
+    void *address;          ///< @brief Virtual address of captured stack frame.
+                            ///< @details If library is not tracking stack traces (see #OakumCapabilities), this field will be set to `NULL`.
+    char *symbolName;       ///< @brief Human-readable name of the function for the current stack frame.
+                            ///< @details This field will be initialized to `NULL`. It will be filled after a successfull call to #oakumResolveStackTraceSymbols.
+    char *fileName;         ///< @brief Name of the source file containing related code.
+                            ///< @details This field will be initialized to `NULL`. It will be filled after a successfull call to #oakumResolveStackTraceSourceLocations.
+    unsigned int fileLine;  ///< @brief Line in the source file containing related code.
+                            ///< @details This field will be initialized to `NULL`. It will be filled after a successfull call to #oakumResolveStackTraceSourceLocations.
+    size_t moduleIndex;     ///< @brief Index of the module containing the frame in the table returned by #oakumGetModules.
+                            ///< @details Set to #OAKUM_UNKNOWN_MODULE_INDEX, if the address does not belong to any known module. Frames captured
+                            ///< in a module, which has been unloaded since, still refer to that module.
+    uintptr_t moduleOffset; ///< @brief Address of the frame relative to #OakumModule.baseAddress of its module.
+                            ///< @details Unlike #address, the offset does not depend on address space layout of the process, so it can be
+                            ///< used to compare stack traces captured by different processes running the same binaries.
+};
+
+/// @brief Executable or shared library loaded into the process. See #oakumGetModules.
+struct OakumModule {
+    const char *path;    ///< @brief Path to the module file. The string is owned by the library and stays valid until #oakumDeinit.
+    const char *buildId; ///< @brief Hexadecimal build id of the module or an empty string, if the module does not have one.
+                         ///< @details The string is owned by the library and stays valid until #oakumDeinit.
+    void *baseAddress;   ///< @brief Address, to which #OakumStackFrame.moduleOffset is relative.
+    void *addressBegin;  ///< @brief First address of code and data of the module.
+    void *addressEnd;    ///< @brief Address past the end of code and data of the module.
+    bool loaded;         ///< @brief If set to `false`, the module has been unloaded since it was registered.
+};
+
+/// @brief Live allocations made from a single call site. See #oakumGetCallSites.
+struct OakumCallSite {
+    void *address;                  ///< @brief Return address of the allocation operator or `NULL` for allocations from call sites, which did not fit in the library's table.
+    size_t moduleIndex;             ///< @brief Index of the module containing the call site in the table returned by #oakumGetModules or #OAKUM_UNKNOWN_MODULE_INDEX.
+    uintptr_t moduleOffset;         ///< @brief Address of the call site relative to #OakumModule.baseAddress of its module.
+    size_t liveAllocationsCount;    ///< @brief Number of allocations made from the call site, which have not been freed yet.
+    size_t liveBytes;               ///< @brief Total size of allocations made from the call site, which have not been freed yet.
+    uint64_t totalAllocationsCount; ///< @brief Cumulative number of allocations made from the call site.
+    uint64_t totalBytes;            ///< @brief Cumulative size of allocations made from the call site.
+    bool escalated;                 ///< @brief If set to `true`, allocations from the call site capture full stack traces. See #OAKUM_STACK_TRACE_MODE_ADAPTIVE.
+};
+
+/// @brief Histograms of allocations freed at a single call site. See #oakumGetChurnCallSites.
+struct OakumCallSiteHistograms {
+    void *address;                                               ///< @brief Return address of the allocation operator or `NULL` for call sites, which did not fit in the library's table.
+    size_t moduleIndex;                                          ///< @brief Index of the module containing the call site in the table returned by #oakumGetModules or #OAKUM_UNKNOWN_MODULE_INDEX.
+    uintptr_t moduleOffset;                                      ///< @brief Address of the call site relative to #OakumModule.baseAddress of its module.
+    uint64_t freedAllocationsCount;                              ///< @brief Number of allocations made from the call site, which have been freed.
+    uint64_t shortLivedAllocationsCount;                         ///< @brief Number of freed allocations, which lived shorter than the limit passed to #oakumGetChurnCallSites.
+    uint64_t lifetimesNs[OAKUM_HISTOGRAM_BUCKETS_COUNT];         ///< @brief Histogram of lifetimes of freed allocations in nanoseconds. See #OAKUM_HISTOGRAM_BUCKETS_COUNT.
+    uint64_t sizes[OAKUM_HISTOGRAM_BUCKETS_COUNT];               ///< @brief Histogram of sizes of freed allocations in bytes. See #OAKUM_HISTOGRAM_BUCKETS_COUNT.
+};
+
+/// @brief Call site, whose live bytes are growing. See #oakumGetGrowingCallSites.
+struct OakumGrowingCallSite {
+    void *address;          ///< @brief Return address of the allocation operator or `NULL` for call sites, which did not fit in the library's table.
+    size_t moduleIndex;     ///< @brief Index of the module containing the call site in the table returned by #oakumGetModules or #OAKUM_UNKNOWN_MODULE_INDEX.
+    uintptr_t moduleOffset; ///< @brief Address of the call site relative to #OakumModule.baseAddress of its module.
+    size_t liveBytes;       ///< @brief Live bytes of the call site in the newest sample.
+    size_t growthBytes;     ///< @brief Increase of live bytes between the oldest and the newest sample in the window.
+};
+
+/// @brief Summary of the snapshot of live allocations captured at the peak of heap usage. See #OakumInitArgs.peakSnapshotMargin.
+struct OakumPeakSnapshotInfo {
+    uint64_t capturesCount;                  ///< @brief Number of snapshots captured since library initialization. Zero, if there is no snapshot yet.
+    size_t liveAllocationsCount;             ///< @brief Number of live allocations at the time of the snapshot.
+    size_t liveBytes;                        ///< @brief Total size of live allocations at the time of the snapshot.
+    size_t stacksCount;                      ///< @brief Number of unique stack traces in the snapshot.
+    OakumAllocationIdType lastAllocationId;  ///< @brief Identifier of the newest allocation made before the snapshot was captured.
 };
 
 /// @brief Captured memory allocation
 struct OakumAllocation {
-    OakumAllocationIdType allocationId;                        ///< @brief Unique allocation identifier
-    size_t size;                                               ///< @brief Size of the allocation
-    void *pointer;                                             ///< @brief Address of the allocation
-    bool noThrow;                                              ///< @brief If set to `true`, allocation was made with `std::nothrow` specifier
-    OakumStackFrame stackFrames[OAKUM_MAX_STACK_FRAMES_COUNT]; ///< @brief Captured stack trace
-    size_t stackFramesCount;                                   ///< @brief Number of captured stack frames
+    OakumAllocationIdType allocationId; ///< @brief Unique allocation identifier
+    size_t size;                        ///< @brief Size of the allocation
+    void *pointer;                      ///< @brief Address of the allocation
+    bool noThrow;                       ///< @brief If set to `true`, allocation was made with `std::nothrow` specifier
+    OakumStackFrame *stackFrames;       ///< @brief Captured stack trace. Array of #stackFramesCount frames released by #oakumReleaseAllocations.
+    size_t stackFramesCount;            ///< @brief Number of captured stack frames
+    const char *scopeName;              ///< @brief Name of the innermost tracking scope active during the allocation or `NULL`, if there was none.
+                                        ///< @details The string is owned by the library and stays valid until #oakumDeinit. See #oakumBeginScope.
+    uint64_t threadId;                  ///< @brief Operating system id of the thread, which made the allocation or 0, if #OakumInitArgs.trackThreads is disabled.
+    const char *threadName;             ///< @brief Name of the thread, which made the allocation or `NULL`, if #OakumInitArgs.trackThreads is disabled.
+                                        ///< @details The name is read again for each report, so threads named after their first allocation are reported correctly.
+                                        ///< Empty, if the name is unknown. The string is owned by the library and stays valid until #oakumDeinit.
+};
+
+/// @brief Allocation counters reported by #oakumGetStatistics
+/// @details Only allocations tracked by the library are counted, i.e. ignored allocations are omitted. Rates of allocations
+/// and deallocations can be calculated by polling the cumulative counters periodically.
+struct OakumStatistics {
+    size_t liveAllocationsCount;            ///< @brief Number of allocations, which have not been freed yet.
+    size_t liveBytes;                       ///< @brief Total size of allocations, which have not been freed yet.
+    size_t peakLiveBytes;                   ///< @brief Highest value of #liveBytes since library initialization.
+    uint64_t totalAllocationsCount;         ///< @brief Cumulative number of allocations since library initialization.
+    uint64_t totalDeallocationsCount;       ///< @brief Cumulative number of deallocations since library initialization.
+    uint64_t failedNoThrowAllocationsCount; ///< @brief Cumulative number of failed allocations made with `std::nothrow` specifier.
+};
+
+/// @brief Call site published in #OakumSharedStatistics
+struct OakumSharedCallSite {
+    uint64_t address;               ///< @brief Return address of the allocation operator in the monitored process.
+    uint64_t liveAllocationsCount;  ///< @brief Number of allocations made at this call site, which have not been freed yet.
+    uint64_t liveBytes;             ///< @brief Total size of allocations made at this call site, which have not been freed yet.
+    uint64_t totalAllocationsCount; ///< @brief Cumulative number of allocations made at this call site.
+};
+
+/// @brief Layout of the shared memory object enabled by #OakumInitArgs.sharedStatisticsName
+/// @details Fields before #sequence are constant. Remaining fields are protected by a sequence lock: the library makes
+/// #sequence odd, updates the fields and makes it even again. A reader copies the structure between two loads of #sequence
+/// with acquire semantics and retries, if the values differ or are odd. Reading never blocks the monitored process.
+struct OakumSharedStatistics {
+    uint64_t magic;                                                                ///< @brief Always #OAKUM_SHARED_STATISTICS_MAGIC.
+    uint32_t version;                                                              ///< @brief Always #OAKUM_SHARED_STATISTICS_VERSION.
+    uint32_t size;                                                                 ///< @brief Size of the structure in bytes.
+    uint64_t ownerProcessId;                                                       ///< @brief Id of the process, which publishes the statistics.
+    uint64_t sequence;                                                             ///< @brief Sequence lock counter. Odd while an update is in progress.
+    uint64_t updatesCount;                                                         ///< @brief Number of completed updates. Zero until the first update.
+    uint64_t updateTimeNs;                                                         ///< @brief Time of the last update in nanoseconds since the Unix epoch.
+    uint64_t liveAllocationsCount;                                                 ///< @brief See #OakumStatistics.liveAllocationsCount.
+    uint64_t liveBytes;                                                            ///< @brief See #OakumStatistics.liveBytes.
+    uint64_t peakLiveBytes;                                                        ///< @brief See #OakumStatistics.peakLiveBytes.
+    uint64_t totalAllocationsCount;                                                ///< @brief See #OakumStatistics.totalAllocationsCount.
+    uint64_t totalDeallocationsCount;                                              ///< @brief See #OakumStatistics.totalDeallocationsCount.
+    uint64_t failedNoThrowAllocationsCount;                                        ///< @brief See #OakumStatistics.failedNoThrowAllocationsCount.
+    uint64_t allocationsPerSecond;                                                 ///< @brief Rate of allocations since the previous update.
+    uint64_t deallocationsPerSecond;                                               ///< @brief Rate of deallocations since the previous update.
+    uint64_t topCallSitesCount;                                                    ///< @brief Number of valid entries in #topCallSites.
+    OakumSharedCallSite topCallSites[OAKUM_SHARED_STATISTICS_TOP_CALL_SITES_COUNT]; ///< @brief Call sites with the most live bytes, in descending order.
+                                                                                   ///< @details Available only in #OAKUM_STACK_TRACE_MODE_CALLER and
+                                                                                   ///< #OAKUM_STACK_TRACE_MODE_ADAPTIVE, because they are read from lock-free
+                                                                                   ///< per call site counters. Empty in other modes.
+};
+
+/// @brief Allocation counters of a single thread reported by #oakumGetThreadStatistics
+/// @details Allocations are attributed to the thread, which made them, even if they are freed by another thread.
+struct OakumThreadStatistics {
+    uint64_t threadId;              ///< @brief Operating system id of the thread, e.g. the result of `gettid` on Linux.
+    const char *threadName;         ///< @brief Name of the thread or an empty string, if it is unknown. Owned by the library and valid until #oakumDeinit.
+    size_t liveAllocationsCount;    ///< @brief Number of allocations made by the thread, which have not been freed yet.
+    size_t liveBytes;               ///< @brief Total size of allocations made by the thread, which have not been freed yet.
+    uint64_t totalAllocationsCount; ///< @brief Cumulative number of allocations made by the thread.
+};
+
+/// @brief Kind of an ignore rule passed to #oakumAddIgnoreRule
+enum OakumIgnoreRuleType {
+    OAKUM_IGNORE_RULE_MODULE,        ///< @brief Ignore allocations made by code of a loaded module (executable or shared library).
+    OAKUM_IGNORE_RULE_ADDRESS_RANGE, ///< @brief Ignore allocations made by code within an address range.
+};
+
+/// @brief Rule for ignoring allocations based on their call site. See #oakumAddIgnoreRule.
+struct OakumIgnoreRule {
+    OakumIgnoreRuleType type; ///< @brief Kind of the rule.
+    const char *moduleName;   ///< @brief Part of the path of a module to match. Used only for #OAKUM_IGNORE_RULE_MODULE.
+    void *addressBegin;       ///< @brief First address of the range. Used only for #OAKUM_IGNORE_RULE_ADDRESS_RANGE.
+    void *addressEnd;         ///< @brief Address past the end of the range. Used only for #OAKUM_IGNORE_RULE_ADDRESS_RANGE.
 };
 
 /// @brief Result code returned from all Oakum API calls
@@ -80,6 +322,8 @@ enum OakumResult {
     OAKUM_LEAKS_DETECTED,        ///< @brief Non-zero count of tracked allocations. Possible memory leak.
     OAKUM_RESOLVING_FAILED,      ///< @brief Error querying information from the system.
     OAKUM_FEATURE_NOT_SUPPORTED, ///< @brief Attempt to use unsupported API call.
+    OAKUM_NOT_IN_SCOPE,          ///< @brief Too many calls to #oakumEndScope.
+    OAKUM_IO_ERROR,              ///< @brief Error creating or writing to a file.
 };
 
 /// @brief Initialize the library. This must be the first API call used.
@@ -88,6 +332,21 @@ enum OakumResult {
 /// @param[in] args input configuration.
 /// @return #OAKUM_ALREADY_INITIALIZED, if #oakumInit had been previously called without calling #oakumDeinit.
 /// @return #OAKUM_INVALID_VALUE, if #args is `NULL`.
+/// @return #OAKUM_INVALID_VALUE, if #OakumInitArgs.maxStackFramesCount exceeds #OAKUM_STACK_FRAMES_COUNT_LIMIT.
+/// @return #OAKUM_INVALID_VALUE, if #OakumInitArgs.ignoreRulesFramesCount exceeds #OAKUM_STACK_FRAMES_COUNT_LIMIT.
+/// @return #OAKUM_INVALID_VALUE, if #OakumInitArgs.stackTraceMode is unknown.
+/// @return #OAKUM_INVALID_VALUE, if #OakumInitArgs.reportSignal is set and #OakumInitArgs.reportFilePath is `NULL` or #OakumInitArgs.reportFormat is unknown.
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if #OakumInitArgs.reportSignal is set, but the platform does not support it, the library was compiled
+/// without thread safety or #OakumInitArgs.reportFormat cannot be written with the selected stack trace settings (see #oakumWriteProfile).
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if #OakumInitArgs.querySocketPath is not `NULL`, but the platform does not support it or the library
+/// was compiled without thread safety.
+/// @return #OAKUM_INVALID_VALUE, if #OakumInitArgs.trendSamplingIntervalMs is not zero and #OakumInitArgs.trendWindowSamplesCount is lower than 2.
+/// @return #OAKUM_INVALID_VALUE, if #OakumInitArgs.sharedStatisticsName is not `NULL` and #OakumInitArgs.sharedStatisticsIntervalMs is zero.
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if #OakumInitArgs.sharedStatisticsName is not `NULL`, but the platform does not support it.
+/// @return #OAKUM_IO_ERROR, if #OakumInitArgs.traceFilePath is not `NULL` and the file could not be created.
+/// @return #OAKUM_IO_ERROR, if #OakumInitArgs.querySocketPath is not `NULL` and the socket could not be created. An existing file is replaced only
+/// if it is a socket, which does not accept connections.
+/// @return #OAKUM_IO_ERROR, if #OakumInitArgs.sharedStatisticsName is not `NULL` and the shared memory object could not be created.
 /// @return #OAKUM_SUCCESS otherwise.
 OakumResult oakumInit(const OakumInitArgs *args);
 
@@ -116,13 +375,38 @@ OakumResult oakumGetCapabilities(OakumCapabilities *outCapabilities);
 /// @return #OAKUM_SUCCESS otherwise.
 OakumResult oakumDetectLeaks();
 
+/// @brief Retrieves allocation counters of the library.
+/// @details Counters are maintained on every allocation and aggregated by this call without taking any locks, so it is
+/// cheap enough to be polled frequently, e.g. by a metrics exporter. Values are not an atomic snapshot of the library state
+/// when other threads are allocating memory concurrently.
+/// @param[out] outStatistics statistics structure to fill by the library.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p outStatistics is `NULL`.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumGetStatistics(OakumStatistics *outStatistics);
+
+/// @brief Retrieves allocation counters of each thread, which has made a tracked allocation.
+/// @details Requires #OakumInitArgs.trackThreads. Threads are reported in the order of their first allocation. Threads, which have
+/// exited, are reported as well, because memory allocated by them may still be live. Counters are updated without locks, so they are
+/// not an atomic snapshot, when other threads are allocating memory concurrently.
+/// @details If @p outThreads is `NULL`, the library stores the number of threads at *@p inOutThreadsCount. Otherwise it
+/// copies at most *@p inOutThreadsCount threads to @p outThreads and stores the number of copied threads.
+/// @param[out] outThreads array to fill with thread statistics. May be `NULL`.
+/// @param[in,out] inOutThreadsCount size of the @p outThreads array on input, number of threads on output.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p inOutThreadsCount is `NULL`.
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if #OakumInitArgs.trackThreads was not set.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumGetThreadStatistics(OakumThreadStatistics *outThreads, size_t *inOutThreadsCount);
+
 /// @brief Retrieves currently un-freed memory allocations.
 /// @details The library allocates an array for all un-freed allocations, copies them into that array and
 /// stores the array address and size at *@p outAllocations and *@p outAllocationsCount.
 /// @details The user should not manually free the memory allocated by this function, but rather call
-/// #oakumReleaseAllocations to release all resources.
+/// #oakumReleaseAllocations to release all resources. Stack frames and strings of reports not released before
+/// #oakumDeinit are released by it.
 /// @details If stack trace tracking is enabled (see #OakumCapabilities), the library
-/// fills #OakumStackFrame.address in all stack frames. However, the rest of the stack trace data is set to
+/// fills #OakumStackFrame.address, #OakumStackFrame.moduleIndex and #OakumStackFrame.moduleOffset in all stack frames. However, the rest of the stack trace data is set to
 /// `NULL` and must be explicitly requested with #oakumResolveStackTraceSymbols and #oakumResolveStackTraceSourceLocations
 /// calls.
 /// @details If #OakumInitArgs.sortAllocations is enabled, returned allocations will be sorted by id.
@@ -134,10 +418,111 @@ OakumResult oakumDetectLeaks();
 /// @return #OAKUM_SUCCESS otherwise.
 OakumResult oakumGetAllocations(OakumAllocation **outAllocations, size_t *outAllocationsCount);
 
+/// @brief Retrieves modules (executable and shared libraries), to which #OakumStackFrame.moduleIndex refers.
+/// @details The library registers modules when they are first seen and never changes their indices, so indices returned
+/// by earlier calls to #oakumGetAllocations stay valid. Modules unloaded in the meantime are reported with #OakumModule.loaded
+/// set to `false`. The table is refreshed by this call and by #oakumGetAllocations.
+/// @details If @p outModules is `NULL`, the library stores the number of modules at *@p inOutModulesCount. Otherwise it
+/// copies at most *@p inOutModulesCount modules to @p outModules and stores the number of copied modules.
+/// @param[out] outModules array to fill with modules. May be `NULL`.
+/// @param[in,out] inOutModulesCount size of the @p outModules array on input, number of modules on output.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p inOutModulesCount is `NULL`.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumGetModules(OakumModule *outModules, size_t *inOutModulesCount);
+
+/// @brief Retrieves live allocation counters aggregated per call site.
+/// @details Counters are maintained only in #OAKUM_STACK_TRACE_MODE_CALLER and #OAKUM_STACK_TRACE_MODE_ADAPTIVE modes. They are updated without locks, so they are
+/// not an atomic snapshot, when other threads are allocating memory concurrently.
+/// @details If @p outCallSites is `NULL`, the library stores the number of call sites at *@p inOutCallSitesCount. Otherwise it
+/// copies at most *@p inOutCallSitesCount call sites to @p outCallSites and stores the number of copied call sites.
+/// @param[out] outCallSites array to fill with call sites. May be `NULL`.
+/// @param[in,out] inOutCallSitesCount size of the @p outCallSites array on input, number of call sites on output.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p inOutCallSitesCount is `NULL`.
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if the library is not tracking stack traces in one of the above modes.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumGetCallSites(OakumCallSite *outCallSites, size_t *inOutCallSitesCount);
+
+/// @brief Retrieves call sites with the most short-lived allocations, which are candidates for object pools or arenas.
+/// @details Requires #OakumInitArgs.trackLifetimes. Lifetimes are compared with @p maxLifetimeNs at the granularity of histogram
+/// buckets, i.e. an allocation is short-lived, if the whole bucket containing its lifetime is below @p maxLifetimeNs. Only call
+/// sites with at least one short-lived allocation are returned, ordered by #OakumCallSiteHistograms.shortLivedAllocationsCount
+/// from the highest. Histograms are updated without locks, so they are not an atomic snapshot, when other threads free memory concurrently.
+/// @details If @p outCallSites is `NULL`, the library stores the number of such call sites at *@p inOutCallSitesCount. Otherwise it
+/// copies at most *@p inOutCallSitesCount call sites to @p outCallSites and stores the number of copied call sites.
+/// @param[in] maxLifetimeNs lifetime in nanoseconds, below which allocations are considered short-lived.
+/// @param[out] outCallSites array to fill with call sites. May be `NULL`.
+/// @param[in,out] inOutCallSitesCount size of the @p outCallSites array on input, number of call sites on output.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p inOutCallSitesCount is `NULL`.
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if call sites are not tracked or #OakumInitArgs.trackLifetimes was not set.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumGetChurnCallSites(uint64_t maxLifetimeNs, OakumCallSiteHistograms *outCallSites, size_t *inOutCallSitesCount);
+
+/// @brief Retrieves call sites, whose live bytes have been growing over the recent window of samples.
+/// @details Requires #OakumInitArgs.trendSamplingIntervalMs. A call site is growing, if its live bytes did not decrease between
+/// any of the last #OakumInitArgs.trendWindowSamplesCount samples and the newest sample is higher than the oldest one. Unlike
+/// #oakumDetectLeaks, this finds slow leaks in processes, which run for a long time and are never shut down cleanly. Call sites are
+/// ordered by #OakumGrowingCallSite.growthBytes from the highest. Nothing is returned until the first window of samples is complete.
+/// @details If @p outCallSites is `NULL`, the library stores the number of growing call sites at *@p inOutCallSitesCount. Otherwise it
+/// copies at most *@p inOutCallSitesCount call sites to @p outCallSites and stores the number of copied call sites.
+/// @param[out] outCallSites array to fill with call sites. May be `NULL`.
+/// @param[in,out] inOutCallSitesCount size of the @p outCallSites array on input, number of call sites on output.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p inOutCallSitesCount is `NULL`.
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if call sites are not tracked or #OakumInitArgs.trendSamplingIntervalMs was zero.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumGetGrowingCallSites(OakumGrowingCallSite *outCallSites, size_t *inOutCallSitesCount);
+
+/// @brief Writes a heap profile of currently un-freed memory allocations to a file.
+/// @details Allocations are aggregated per unique stack trace inside the library, so the output is small even for millions
+/// of allocations. Each stack reports the number and total size of live allocations (`inuse_objects` and `inuse_space` in pprof).
+/// If call sites are tracked (see #oakumGetCallSites), cumulative allocations of each call site are reported as well (`alloc_objects`
+/// and `alloc_space` in pprof). See #OakumProfileFormat for the values written by each format.
+/// @details Loaded modules are written along with their build ids, so a pprof profile can be symbolized offline. Symbol names
+/// are written, if they are available (see #OakumCapabilities).
+/// @details The profile is written by the calling thread. Allocations made by the library while writing it are ignored.
+/// @param[in] format file format of the profile.
+/// @param[in] filePath path of the file to write. Existing file is overwritten.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p format is unknown.
+/// @return #OAKUM_INVALID_VALUE, if @p filePath is `NULL`.
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if the library is not tracking stack traces (see #OakumCapabilities).
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if @p format is #OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES and call sites are not tracked.
+/// @return #OAKUM_IO_ERROR, if the file could not be written.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumWriteProfile(OakumProfileFormat format, const char *filePath);
+
+/// @brief Retrieves a summary of the snapshot captured at the peak of heap usage.
+/// @param[out] outInfo structure to fill by the library.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p outInfo is `NULL`.
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if #OakumInitArgs.peakSnapshotMargin is zero.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumGetPeakSnapshotInfo(OakumPeakSnapshotInfo *outInfo);
+
+/// @brief Writes a heap profile of allocations, which were live at the peak of heap usage, to a file.
+/// @details Works like #oakumWriteProfile, but reports the latest snapshot captured according to #OakumInitArgs.peakSnapshotMargin
+/// instead of currently live allocations. The profile is empty, if no snapshot has been captured yet. Snapshots contain only live
+/// allocations, so cumulative values are not written.
+/// @param[in] format file format of the profile.
+/// @param[in] filePath path of the file to write. Existing file is overwritten.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p format is unknown.
+/// @return #OAKUM_INVALID_VALUE, if @p filePath is `NULL`.
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if #OakumInitArgs.peakSnapshotMargin is zero or the library is not tracking stack traces (see #OakumCapabilities).
+/// @return #OAKUM_FEATURE_NOT_SUPPORTED, if @p format is #OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES.
+/// @return #OAKUM_IO_ERROR, if the file could not be written.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumWritePeakProfile(OakumProfileFormat format, const char *filePath);
+
 /// @brief Frees allocation structs allocated by #oakumGetAllocations
 /// @details User must call this function to ensure proper releasing of library resources. Manual call to `free`
 /// or `delete[]` on the allocation structs is not supported and may result in an undefined behaviour.
-/// @param[in] allocations array of allocations to release.
+/// @details The whole report, including stack frames and resolved strings, is released at once, so the cost does
+/// not depend on its size. Pointers to any part of the report must not be used afterwards.
+/// @param[in] allocations array of allocations returned by #oakumGetAllocations.
 /// @param[in] allocationsCount size of the @p allocations array.
 /// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
 /// @return #OAKUM_INVALID_VALUE, if @p allocations is `NULL` and @p allocationsCount is not zero.
@@ -191,4 +576,74 @@ OakumResult oakumStartIgnore();
 /// @return #OAKUM_NOT_IGNORING, if the ignore counter is already 0.
 /// @return #OAKUM_SUCCESS otherwise.
 OakumResult oakumStopIgnore();
+
+/// @brief Returns a token describing ignore state of the calling thread.
+/// @details Ignore counter maintained by #oakumStartIgnore and #oakumStopIgnore is local to each thread, so work handed
+/// off to other threads would normally escape the ignore mode. The token can be passed along with the work and applied on
+/// the worker thread with #oakumSetIgnoreToken.
+/// @details The token describes the ignore region of the calling thread, which lasts until its ignore counter drops back
+/// to zero. Threads, which applied the token, stop ignoring allocations as soon as the region ends. A thread, which ignores
+/// allocations only because of an applied token, returns that token, so work can be handed off further. A token of a thread,
+/// which is not ignoring allocations, is valid as well and applying it disables ignore mode inherited from a previous token.
+/// @param[out] outToken address, to which the library will store the token.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p outToken is `NULL`.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumGetIgnoreToken(OakumIgnoreToken *outToken);
+
+/// @brief Applies ignore state described by a token on the calling thread.
+/// @details While an ignoring token is applied and its region has not ended, the calling thread behaves as if its ignore
+/// counter was greater than zero.
+/// The token does not modify the ignore counter itself. To restore previous state, the worker should apply a token it
+/// had retrieved before with #oakumGetIgnoreToken or a non-ignoring token. Tokens are invalidated by #oakumDeinit.
+/// @param[in] token token returned by #oakumGetIgnoreToken.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p token has been created before the library was reinitialized.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumSetIgnoreToken(OakumIgnoreToken token);
+
+/// @brief Adds a rule ignoring all allocations made from matching call sites.
+/// @details The rule is matched against the innermost #OakumInitArgs.ignoreRulesFramesCount frames of the stack trace of each
+/// allocation, so for example a module rule for the C++ standard library ignores all allocations made during `std::locale`
+/// initialization. The caller is matched first. Stack traces are captured for the purpose of matching the rules only if it
+/// does not match, but then even if #OakumInitArgs.trackStackTraces is disabled, which makes every other allocation walk the
+/// stack. Module rules are resolved to address ranges once, when they are added, so the module must already be loaded.
+/// @details Rules are removed by #oakumDeinit call.
+/// @param[in] rule rule to add.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p rule is `NULL`, has an unknown type or its fields used by the type are invalid.
+/// @return #OAKUM_RESOLVING_FAILED, if no loaded module matches #OakumIgnoreRule.moduleName.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumAddIgnoreRule(const OakumIgnoreRule *rule);
+
+/// @brief Enters a named tracking scope.
+/// @details Tracking scopes are the opposite of ignore mode (see #oakumStartIgnore). Allocations are still tracked, but
+/// they are additionally tagged with the innermost active scope, so leaks can be checked for one scope at a time with
+/// #oakumDetectScopeLeaks. Name of the scope is reported in #OakumAllocation.scopeName.
+/// @details Scopes are maintained per thread and can be nested. Each call to #oakumBeginScope must be paired with a call
+/// to #oakumEndScope on the same thread. Entering a scope with the same name multiple times (e.g. once per handled request)
+/// refers to the same scope. Scopes are reset by #oakumDeinit call.
+/// @param[in] scopeName name of the scope. The library makes its own copy of the string.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p scopeName is `NULL`.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumBeginScope(const char *scopeName);
+
+/// @brief Leaves the innermost tracking scope of the calling thread.
+/// @details For details on how tracking scopes work, see #oakumBeginScope.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_NOT_IN_SCOPE, if the calling thread has not entered any scope.
+/// @return #OAKUM_SUCCESS otherwise.
+OakumResult oakumEndScope();
+
+/// @brief Checks for leaked memory allocated inside a given tracking scope.
+/// @details The library maintains a live allocations counter for each scope, so this check does not have to visit all
+/// tracked allocations. Allocations are counted only in the innermost scope active when they were made.
+/// @param[in] scopeName name of the scope to check.
+/// @return #OAKUM_UNINITIALIZED, if #oakumInit has not been called.
+/// @return #OAKUM_INVALID_VALUE, if @p scopeName is `NULL`.
+/// @return #OAKUM_LEAKS_DETECTED, if leaks are detected in the scope.
+/// @return #OAKUM_SUCCESS otherwise. This includes scopes, which have never been entered.
+OakumResult oakumDetectScopeLeaks(const char *scopeName);
+
 }
@@ -0,0 +1,13 @@
+#include "source/background_symbolizer.h"
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Oakum {
+void BackgroundSymbolizer::lowerThreadPriority() {
+    // Lowest nice value still gives the thread a small share of a busy CPU, so it cannot starve while holding a lock,
+    // which application threads wait for. On Linux, nice values apply to single threads. It does not require any privileges.
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+}
+} // namespace Oakum
@@ -1,6 +1,7 @@
 #include "source/linux/child_process.h"
 
 #include <fcntl.h>
+#include <spawn.h>
 #include <sstream>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -36,36 +37,30 @@ ChildProcess::Result ChildProcess::run() {
 
     outputPipe.create();
 
-    int forkResult = fork();
-    if (forkResult == -1) {
-        return Result::ForkFailed;
-    }
-
-    if (forkResult == 0) {
-        // Child
-
-        // Redirect stdout to the output pipe
-        FATAL_ERROR_ON_FAILED_SYSCALL(dup2(outputPipe.getWrite(), STDOUT_FILENO));
-        outputPipe.closeWrite();
-
-        // Ignore stderr
-        int devNull = open("/dev/null", O_WRONLY);
-        FATAL_ERROR_ON_FAILED_SYSCALL(devNull);
-        FATAL_ERROR_ON_FAILED_SYSCALL(dup2(devNull, STDERR_FILENO));
-        FATAL_ERROR_ON_FAILED_SYSCALL(close(devNull));
+    // Redirections are performed by posix_spawn in the child: stdout goes to the output pipe and stderr is ignored.
+    // Unlike fork(), posix_spawn does not copy page tables of the parent, so the cost of spawning does not grow with
+    // the amount of memory used by the application.
+    posix_spawn_file_actions_t fileActions{};
+    FATAL_ERROR_ON_FAILED_POSIX_CALL(posix_spawn_file_actions_init(&fileActions));
+    FATAL_ERROR_ON_FAILED_POSIX_CALL(posix_spawn_file_actions_adddup2(&fileActions, outputPipe.getWrite(), STDOUT_FILENO));
+    FATAL_ERROR_ON_FAILED_POSIX_CALL(posix_spawn_file_actions_addclose(&fileActions, outputPipe.getWrite()));
+    FATAL_ERROR_ON_FAILED_POSIX_CALL(posix_spawn_file_actions_addclose(&fileActions, outputPipe.getRead()));
+    FATAL_ERROR_ON_FAILED_POSIX_CALL(posix_spawn_file_actions_addopen(&fileActions, STDERR_FILENO, "/dev/null", O_WRONLY, 0));
+
+    // Execute binary
+    std::vector<char *> argv = getArgumentsPointers();
+    pid_t childPid{};
+    const int spawnResult = posix_spawnp(&childPid, argv[0], &fileActions, nullptr, argv.data(), environ);
+    FATAL_ERROR_ON_FAILED_POSIX_CALL(posix_spawn_file_actions_destroy(&fileActions));
+    if (spawnResult != 0) {
         outputPipe.closeRead();
-
-        // Execute binary
-        std::vector<char *> argv = getArgumentsPointers();
-        char **rawArgv = argv.data();
-        FATAL_ERROR_ON_FAILED_SYSCALL(execvp(argv[0], rawArgv));
-        FATAL_ERROR("Unreachable code");
-    } else {
-        // Parent
-        this->pid = forkResult;
         outputPipe.closeWrite();
-        return Result::Success;
+        return Result::SpawnFailed;
     }
+
+    this->pid = childPid;
+    outputPipe.closeWrite();
+    return Result::Success;
 }
 
 ChildProcess::Result ChildProcess::wait() {
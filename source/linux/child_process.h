@@ -11,7 +11,7 @@ class ChildProcess {
 public:
     enum class Result {
         Success,
-        ForkFailed,
+        SpawnFailed,
         ChildProcessKilled,
         NotRun,
         AlreadyRun,
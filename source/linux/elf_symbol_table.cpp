@@ -0,0 +1,249 @@
+#include "source/linux/elf_symbol_table.h"
+#include "source/oakum_controller.h"
+
+#include <algorithm>
+#include <cstring>
+#include <elf.h>
+#include <link.h>
+
+namespace Oakum {
+
+std::unique_ptr<ElfFile> ElfFile::open(const char *path) {
+    std::unique_ptr<MappedFile> mappedFile = MappedFile::open(path);
+    if (mappedFile == nullptr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<ElfFile> file{new ElfFile(std::move(mappedFile))};
+    if (!file->isValid()) {
+        return nullptr;
+    }
+    return file;
+}
+
+bool ElfFile::isValid() const {
+    if (size < sizeof(ElfW(Ehdr)) || memcmp(data, ELFMAG, SELFMAG) != 0) {
+        return false;
+    }
+
+    // Only files matching the architecture of the current process can be loaded into it
+    const auto &header = *reinterpret_cast<const ElfW(Ehdr) *>(data);
+    constexpr unsigned char expectedClass = sizeof(void *) == 8 ? ELFCLASS64 : ELFCLASS32;
+    if (header.e_ident[EI_CLASS] != expectedClass || header.e_shentsize != sizeof(ElfW(Shdr))) {
+        return false;
+    }
+    return getRange(header.e_shoff, size_t{header.e_shnum} * sizeof(ElfW(Shdr))) != nullptr;
+}
+
+const void *ElfFile::getRange(size_t offset, size_t rangeSize) const {
+    if (offset > size || rangeSize > size - offset) {
+        return nullptr;
+    }
+    return data + offset;
+}
+
+const void *ElfFile::getSection(uint32_t index, size_t &outSize) const {
+    const auto &header = *reinterpret_cast<const ElfW(Ehdr) *>(data);
+    if (index >= header.e_shnum) {
+        return nullptr;
+    }
+
+    const auto *sections = reinterpret_cast<const ElfW(Shdr) *>(data + header.e_shoff);
+    const ElfW(Shdr) &section = sections[index];
+    if (section.sh_type == SHT_NOBITS) {
+        return nullptr;
+    }
+    outSize = section.sh_size;
+    return getRange(section.sh_offset, section.sh_size);
+}
+
+const void *ElfFile::findSection(const char *name, size_t &outSize) const {
+    const auto &header = *reinterpret_cast<const ElfW(Ehdr) *>(data);
+    size_t namesSize = 0;
+    const char *names = static_cast<const char *>(getSection(header.e_shstrndx, namesSize));
+    if (names == nullptr) {
+        return nullptr;
+    }
+
+    const auto *sections = reinterpret_cast<const ElfW(Shdr) *>(data + header.e_shoff);
+    for (uint32_t sectionIndex = 0; sectionIndex < header.e_shnum; sectionIndex++) {
+        const size_t nameOffset = sections[sectionIndex].sh_name;
+        if (nameOffset < namesSize && strncmp(names + nameOffset, name, namesSize - nameOffset) == 0) {
+            return getSection(sectionIndex, outSize);
+        }
+    }
+    return nullptr;
+}
+
+const void *ElfFile::findSection(uint32_t type, size_t &outSize, size_t &outEntrySize, uint32_t &outLink) const {
+    const auto &header = *reinterpret_cast<const ElfW(Ehdr) *>(data);
+    const auto *sections = reinterpret_cast<const ElfW(Shdr) *>(data + header.e_shoff);
+    for (uint32_t sectionIndex = 0; sectionIndex < header.e_shnum; sectionIndex++) {
+        if (sections[sectionIndex].sh_type == type) {
+            outEntrySize = sections[sectionIndex].sh_entsize;
+            outLink = sections[sectionIndex].sh_link;
+            return getSection(sectionIndex, outSize);
+        }
+    }
+    return nullptr;
+}
+
+std::string ElfFile::getBuildId() const {
+    size_t notesSize = 0;
+    const auto *notes = static_cast<const uint8_t *>(findSection(".note.gnu.build-id", notesSize));
+    if (notes == nullptr || notesSize < sizeof(ElfW(Nhdr))) {
+        return {};
+    }
+
+    const auto &note = *reinterpret_cast<const ElfW(Nhdr) *>(notes);
+    const size_t descriptionOffset = sizeof(ElfW(Nhdr)) + ((note.n_namesz + 3) & ~3u);
+    if (note.n_type != NT_GNU_BUILD_ID || descriptionOffset + note.n_descsz > notesSize) {
+        return {};
+    }
+
+    constexpr static const char *hexDigits = "0123456789abcdef";
+    std::string result{};
+    for (size_t byteIndex = 0; byteIndex < note.n_descsz; byteIndex++) {
+        const uint8_t byte = notes[descriptionOffset + byteIndex];
+        result.push_back(hexDigits[byte >> 4]);
+        result.push_back(hexDigits[byte & 0xf]);
+    }
+    return result;
+}
+
+std::string ElfFile::getDebugLink() const {
+    size_t debugLinkSize = 0;
+    const char *debugLink = static_cast<const char *>(findSection(".gnu_debuglink", debugLinkSize));
+    if (debugLink == nullptr) {
+        return {};
+    }
+    return std::string{debugLink, strnlen(debugLink, debugLinkSize)};
+}
+
+std::unique_ptr<ElfSymbolTable> ElfSymbolTable::load(const std::string &modulePath) {
+    std::unique_ptr<ElfFile> module = ElfFile::open(modulePath.c_str());
+    if (module == nullptr) {
+        return nullptr;
+    }
+
+    // Stripped modules may have their full symbol table moved to a separate debug file. Dynamic symbols are always
+    // present, so they are used as the last resort.
+    auto result = std::make_unique<ElfSymbolTable>();
+    size_t symbolTableSize{};
+    size_t symbolSize{};
+    uint32_t stringTableIndex{};
+    if (module->findSection(SHT_SYMTAB, symbolTableSize, symbolSize, stringTableIndex) != nullptr) {
+        result->loadSymbols(std::move(module), SHT_SYMTAB);
+    } else if (!result->loadSymbols(openDebugFile(modulePath, *module), SHT_SYMTAB)) {
+        result->loadSymbols(std::move(module), SHT_DYNSYM);
+    }
+
+    std::sort(result->symbols.begin(), result->symbols.end(), [](const Symbol &left, const Symbol &right) {
+        return left.address < right.address;
+    });
+    return result;
+}
+
+std::unique_ptr<ElfFile> ElfSymbolTable::openDebugFile(const std::string &modulePath, const ElfFile &module) {
+    constexpr static const char *globalDebugDirectory = "/usr/lib/debug";
+
+    const std::string buildId = module.getBuildId();
+    if (buildId.size() > 2) {
+        const std::string path = std::string{globalDebugDirectory} + "/.build-id/" + buildId.substr(0, 2) + "/" + buildId.substr(2) + ".debug";
+        if (auto file = ElfFile::open(path.c_str()); file != nullptr) {
+            return file;
+        }
+    }
+
+    const std::string debugLink = module.getDebugLink();
+    if (!debugLink.empty()) {
+        const std::string moduleDirectory = modulePath.substr(0, modulePath.find_last_of('/') + 1);
+        const std::string candidates[] = {
+            moduleDirectory + debugLink,
+            moduleDirectory + ".debug/" + debugLink,
+            globalDebugDirectory + moduleDirectory + debugLink,
+        };
+        for (const std::string &candidate : candidates) {
+            if (candidate != modulePath) {
+                if (auto file = ElfFile::open(candidate.c_str()); file != nullptr) {
+                    return file;
+                }
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+bool ElfSymbolTable::loadSymbols(std::unique_ptr<ElfFile> &&file, uint32_t sectionType) {
+    if (file == nullptr) {
+        return false;
+    }
+
+    size_t symbolTableSize{};
+    size_t symbolSize{};
+    uint32_t stringTableIndex{};
+    const auto *symbolTable = static_cast<const uint8_t *>(file->findSection(sectionType, symbolTableSize, symbolSize, stringTableIndex));
+    if (symbolTable == nullptr || symbolSize != sizeof(ElfW(Sym))) {
+        return false;
+    }
+
+    size_t stringTableSize{};
+    const char *stringTable = static_cast<const char *>(file->getSection(stringTableIndex, stringTableSize));
+    if (stringTable == nullptr || stringTableSize == 0 || stringTable[stringTableSize - 1] != '\0') {
+        return false;
+    }
+
+    const size_t symbolsCount = symbolTableSize / symbolSize;
+    for (size_t symbolIndex = 0; symbolIndex < symbolsCount; symbolIndex++) {
+        const auto &symbol = *reinterpret_cast<const ElfW(Sym) *>(symbolTable + symbolIndex * symbolSize);
+        if (ELF64_ST_TYPE(symbol.st_info) != STT_FUNC || symbol.st_shndx == SHN_UNDEF || symbol.st_value == 0 || symbol.st_name >= stringTableSize) {
+            continue;
+        }
+        symbols.push_back({static_cast<uintptr_t>(symbol.st_value), static_cast<uintptr_t>(symbol.st_size), stringTable + symbol.st_name});
+    }
+
+    files.push_back(std::move(file));
+    return true;
+}
+
+const char *ElfSymbolTable::findSymbol(uintptr_t address) const {
+    auto it = std::upper_bound(symbols.begin(), symbols.end(), address, [](uintptr_t address, const Symbol &symbol) {
+        return address < symbol.address;
+    });
+    if (it == symbols.begin()) {
+        return nullptr;
+    }
+
+    // Symbols can overlap (e.g. aliases), so look for the closest one containing the address
+    const uintptr_t closestAddress = std::prev(it)->address;
+    while (it != symbols.begin()) {
+        --it;
+        if (address < it->address + std::max<uintptr_t>(it->size, 1)) {
+            return it->name;
+        }
+        if (it->address != closestAddress) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+std::mutex ElfSymbolResolver::lock = {};
+std::unordered_map<std::string, std::unique_ptr<ElfSymbolTable>> ElfSymbolResolver::symbolTables = {};
+
+const char *ElfSymbolResolver::lookup(const char *modulePath, uintptr_t offset) {
+    // Symbol tables are cached for the lifetime of the process, so they must not be reported as leaks
+    RaiiOakumIgnore raiiIgnore{};
+    std::lock_guard lockGuard{lock};
+    auto symbolTable = symbolTables.find(modulePath);
+    if (symbolTable == symbolTables.end()) {
+        symbolTable = symbolTables.emplace(modulePath, ElfSymbolTable::load(modulePath)).first;
+    }
+    if (symbolTable->second == nullptr) {
+        return nullptr;
+    }
+    return symbolTable->second->findSymbol(offset);
+}
+
+} // namespace Oakum
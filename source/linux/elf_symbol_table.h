@@ -0,0 +1,71 @@
+#pragma once
+
+#include "source/mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Oakum {
+
+// Read-only mapping of an ELF file.
+class ElfFile {
+public:
+    static std::unique_ptr<ElfFile> open(const char *path);
+
+    const void *findSection(const char *name, size_t &outSize) const;
+    const void *findSection(uint32_t type, size_t &outSize, size_t &outEntrySize, uint32_t &outLink) const;
+    const void *getSection(uint32_t index, size_t &outSize) const;
+    std::string getBuildId() const;
+    std::string getDebugLink() const;
+
+private:
+    ElfFile(std::unique_ptr<MappedFile> &&file) : file(std::move(file)), data(this->file->getData()), size(this->file->getSize()) {}
+    bool isValid() const;
+    const void *getRange(size_t offset, size_t rangeSize) const;
+
+    std::unique_ptr<MappedFile> file;
+    const uint8_t *data;
+    size_t size;
+};
+
+// Function symbols of a single module sorted by their addresses. Addresses are relative to the load address of
+// the module, i.e. they are virtual addresses as stored in the ELF file. Symbol names point directly to the string
+// table of the mapped file, which is kept alive for the lifetime of the object.
+class ElfSymbolTable {
+public:
+    static std::unique_ptr<ElfSymbolTable> load(const std::string &modulePath);
+
+    const char *findSymbol(uintptr_t address) const;
+    size_t getSymbolsCount() const { return symbols.size(); }
+
+private:
+    struct Symbol {
+        uintptr_t address;
+        uintptr_t size;
+        const char *name;
+    };
+
+    static std::unique_ptr<ElfFile> openDebugFile(const std::string &modulePath, const ElfFile &module);
+    bool loadSymbols(std::unique_ptr<ElfFile> &&file, uint32_t sectionType);
+
+    std::vector<std::unique_ptr<ElfFile>> files = {};
+    std::vector<Symbol> symbols = {};
+};
+
+// Resolves symbol names of module-relative addresses. Symbol tables are loaded on first use of a module and cached
+// for the lifetime of the process.
+class ElfSymbolResolver {
+public:
+    static const char *lookup(const char *modulePath, uintptr_t offset);
+
+private:
+    static std::mutex lock;
+    static std::unordered_map<std::string, std::unique_ptr<ElfSymbolTable>> symbolTables;
+};
+
+} // namespace Oakum
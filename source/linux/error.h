@@ -8,3 +8,8 @@
     if ((expression) < 0) {                                                       \
         FATAL_ERROR("Syscall error on \"", #expression, "\", ", strerror(errno)); \
     }
+
+#define FATAL_ERROR_ON_FAILED_POSIX_CALL(expression)                                 \
+    if (const int error = (expression); error != 0) {                                \
+        FATAL_ERROR("Posix call error on \"", #expression, "\", ", strerror(error)); \
+    }
@@ -0,0 +1,31 @@
+#include "source/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Oakum {
+MappedFile::~MappedFile() {
+    munmap(const_cast<uint8_t *>(data), size);
+}
+
+std::unique_ptr<MappedFile> MappedFile::open(const char *path) {
+    const int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat fileStat = {};
+    void *mapping = MAP_FAILED;
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
+        mapping = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<MappedFile>{new MappedFile(static_cast<const uint8_t *>(mapping), static_cast<size_t>(fileStat.st_size), nullptr)};
+}
+} // namespace Oakum
@@ -0,0 +1,93 @@
+#include "source/module_registry.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <link.h>
+#include <unistd.h>
+
+namespace Oakum {
+static std::string getExecutablePath() {
+    char path[4096] = {};
+    const ssize_t length = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    return length > 0 ? std::string(path, length) : std::string{"/proc/self/exe"};
+}
+
+static std::string getBuildId(const dl_phdr_info &info) {
+    // Build id note is loaded into memory together with the module, so there is no need to read the file
+    for (ElfW(Half) headerIndex = 0; headerIndex < info.dlpi_phnum; headerIndex++) {
+        const ElfW(Phdr) &header = info.dlpi_phdr[headerIndex];
+        if (header.p_type != PT_NOTE) {
+            continue;
+        }
+
+        const auto *notes = reinterpret_cast<const uint8_t *>(info.dlpi_addr + header.p_vaddr);
+        size_t noteOffset = 0;
+        while (noteOffset + sizeof(ElfW(Nhdr)) <= header.p_memsz) {
+            const auto &note = *reinterpret_cast<const ElfW(Nhdr) *>(notes + noteOffset);
+            const size_t descriptionOffset = noteOffset + sizeof(ElfW(Nhdr)) + ((note.n_namesz + 3) & ~3u);
+            if (note.n_type == NT_GNU_BUILD_ID && note.n_descsz > 0 && descriptionOffset + note.n_descsz <= header.p_memsz) {
+                constexpr static const char *hexDigits = "0123456789abcdef";
+                std::string buildId{};
+                for (size_t byteIndex = 0; byteIndex < note.n_descsz; byteIndex++) {
+                    const uint8_t byte = notes[descriptionOffset + byteIndex];
+                    buildId.push_back(hexDigits[byte >> 4]);
+                    buildId.push_back(hexDigits[byte & 0xf]);
+                }
+                return buildId;
+            }
+            noteOffset = descriptionOffset + ((note.n_descsz + 3) & ~3u);
+        }
+    }
+    return {};
+}
+
+bool ModuleRegistry::getChangeCounters(uint64_t &outLoadsCount, uint64_t &outUnloadsCount) {
+    struct CallbackData {
+        uint64_t &outLoadsCount;
+        uint64_t &outUnloadsCount;
+        bool available;
+    } data{outLoadsCount, outUnloadsCount, false};
+
+    // Counters are the same in all entries, so only the first one is read
+    auto callback = [](dl_phdr_info *info, size_t size, void *userData) -> int {
+        auto &data = *static_cast<CallbackData *>(userData);
+        if (size >= offsetof(dl_phdr_info, dlpi_subs) + sizeof(info->dlpi_subs)) {
+            data.outLoadsCount = info->dlpi_adds;
+            data.outUnloadsCount = info->dlpi_subs;
+            data.available = true;
+        }
+        return 1;
+    };
+    dl_iterate_phdr(callback, &data);
+    return data.available;
+}
+
+bool ModuleRegistry::enumerateModules(std::vector<Module> &outModules) {
+    auto callback = [](dl_phdr_info *info, size_t, void *userData) -> int {
+        auto &outModules = *static_cast<std::vector<Module> *>(userData);
+
+        Module module{};
+        module.path = info->dlpi_name[0] != '\0' ? info->dlpi_name : getExecutablePath(); // main executable has an empty name
+        module.baseAddress = info->dlpi_addr;
+        module.begin = UINTPTR_MAX;
+        for (ElfW(Half) headerIndex = 0; headerIndex < info->dlpi_phnum; headerIndex++) {
+            const ElfW(Phdr) &header = info->dlpi_phdr[headerIndex];
+            if (header.p_type == PT_LOAD) {
+                const uintptr_t begin = info->dlpi_addr + header.p_vaddr;
+                if (begin < module.begin) {
+                    module.begin = begin;
+                    module.fileOffset = header.p_offset;
+                }
+                module.end = std::max(module.end, begin + header.p_memsz);
+            }
+        }
+        if (module.begin < module.end) {
+            module.buildId = getBuildId(*info);
+            outModules.push_back(std::move(module));
+        }
+        return 0;
+    };
+    dl_iterate_phdr(callback, &outModules);
+    return true;
+}
+} // namespace Oakum
@@ -0,0 +1,160 @@
+#include "source/linux/error.h"
+#include "source/query_server.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Oakum {
+void QueryServer::Response::flush() {
+    size_t sentSize = 0;
+    while (sentSize < bufferSize && !disconnected) {
+        const ssize_t result = send(descriptor, buffer + sentSize, bufferSize - sentSize, MSG_NOSIGNAL);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            disconnected = true; // includes clients, which stopped reading and hit the send timeout
+            break;
+        }
+        sentSize += static_cast<size_t>(result);
+    }
+    bufferSize = 0;
+}
+
+QueryServer::QueryServer(const char *socketPath, QueryFunction &&queryFunction)
+    : socketPath(socketPath),
+      queryFunction(std::move(queryFunction)) {}
+
+QueryServer::~QueryServer() {
+    stop();
+    if (listeningDescriptor != -1) {
+        close(listeningDescriptor);
+        unlink(socketPath.c_str());
+    }
+}
+
+bool QueryServer::isSupported() {
+    return true;
+}
+
+static bool removeStaleSocket(const sockaddr_un &address) {
+    struct stat fileStatus = {};
+    if (lstat(address.sun_path, &fileStatus) != 0) {
+        return errno == ENOENT;
+    }
+    if (!S_ISSOCK(fileStatus.st_mode)) {
+        return false;
+    }
+
+    // A socket file left by a process, which has crashed, would prevent binding. Sockets of running processes still accept connections.
+    const int descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descriptor == -1) {
+        return false;
+    }
+    const bool refused = connect(descriptor, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 && errno == ECONNREFUSED;
+    close(descriptor);
+    return refused && unlink(address.sun_path) == 0;
+}
+
+bool QueryServer::open() {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    listeningDescriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listeningDescriptor == -1) {
+        return false;
+    }
+
+    // A failed bind means the path belongs to someone else, so it is left as it is
+    if (!removeStaleSocket(address) || bind(listeningDescriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        close(listeningDescriptor);
+        listeningDescriptor = -1;
+        return false;
+    }
+    if (chmod(socketPath.c_str(), S_IRUSR | S_IWUSR) != 0 || listen(listeningDescriptor, 4) != 0) {
+        close(listeningDescriptor);
+        listeningDescriptor = -1;
+        unlink(socketPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void QueryServer::start() {
+    FATAL_ERROR_ON_FAILED_SYSCALL(pipe2(stopPipeDescriptors, O_CLOEXEC));
+    thread.start([this]() { run(); });
+}
+
+void QueryServer::stop() {
+    if (!thread.isStarted()) {
+        return;
+    }
+
+    // Closing the write end wakes up the thread. A client being served is interrupted by the send timeout at the latest.
+    thread.stop([this]() { close(stopPipeDescriptors[1]); });
+    close(stopPipeDescriptors[0]);
+    stopPipeDescriptors[0] = -1;
+    stopPipeDescriptors[1] = -1;
+}
+
+void QueryServer::run() {
+    pollfd descriptors[2] = {};
+    descriptors[0].fd = listeningDescriptor;
+    descriptors[0].events = POLLIN;
+    descriptors[1].fd = stopPipeDescriptors[0];
+    descriptors[1].events = POLLIN;
+    while (true) {
+        const int result = poll(descriptors, 2, -1);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result < 0 || descriptors[1].revents != 0) {
+            break;
+        }
+        if (descriptors[0].revents & POLLIN) {
+            const int clientDescriptor = accept4(listeningDescriptor, nullptr, nullptr, SOCK_CLOEXEC);
+            if (clientDescriptor != -1) {
+                serveClient(clientDescriptor);
+                close(clientDescriptor);
+            }
+        }
+    }
+}
+
+void QueryServer::serveClient(int clientDescriptor) {
+    // Misbehaving clients must not block the server forever
+    const timeval timeout = {1, 0};
+    setsockopt(clientDescriptor, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(clientDescriptor, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    char query[maxQueryLength] = {};
+    size_t querySize = 0;
+    while (querySize < sizeof(query)) {
+        const ssize_t result = recv(clientDescriptor, query + querySize, sizeof(query) - querySize, 0);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            break;
+        }
+        querySize += static_cast<size_t>(result);
+        if (memchr(query, '\n', querySize) != nullptr) {
+            break;
+        }
+    }
+
+    std::string_view queryLine{query, querySize};
+    queryLine = queryLine.substr(0, queryLine.find('\n'));
+    Response response{clientDescriptor};
+    queryFunction(queryLine, response);
+}
+} // namespace Oakum
@@ -0,0 +1,72 @@
+#include "source/shared_statistics_publisher.h"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstddef>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Oakum {
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Sequence lock counter must be usable from other processes");
+
+bool SharedStatisticsPublisher::isSupported() {
+    return true;
+}
+
+// An object left by a process, which has crashed, would prevent creating a new one. Objects of running processes and
+// objects, which were not published by this library, are never removed.
+static bool removeStalePage(const std::string &name) {
+    const int descriptor = shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (descriptor == -1) {
+        return false;
+    }
+    constexpr size_t headerSize = offsetof(OakumSharedStatistics, sequence); // fields, which are never updated
+    OakumSharedStatistics header = {};
+    const bool headerRead = pread(descriptor, &header, headerSize, 0) == static_cast<ssize_t>(headerSize);
+    close(descriptor);
+
+    if (!headerRead || header.magic != OAKUM_SHARED_STATISTICS_MAGIC || header.version != OAKUM_SHARED_STATISTICS_VERSION || header.ownerProcessId == 0) {
+        return false;
+    }
+    const bool ownerExited = kill(static_cast<pid_t>(header.ownerProcessId), 0) != 0 && errno == ESRCH;
+    return ownerExited && shm_unlink(name.c_str()) == 0;
+}
+
+bool SharedStatisticsPublisher::open() {
+    constexpr int flags = O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC;
+    int descriptor = shm_open(name.c_str(), flags, S_IRUSR | S_IWUSR);
+    if (descriptor == -1 && errno == EEXIST && removeStalePage(name)) {
+        descriptor = shm_open(name.c_str(), flags, S_IRUSR | S_IWUSR);
+    }
+    if (descriptor == -1) {
+        return false;
+    }
+
+    void *mapping = MAP_FAILED;
+    if (ftruncate(descriptor, sizeof(OakumSharedStatistics)) == 0) {
+        mapping = mmap(nullptr, sizeof(OakumSharedStatistics), PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return false;
+    }
+
+    // Object is zero-filled by ftruncate, so readers see an even sequence and no updates until the first publish
+    page = static_cast<OakumSharedStatistics *>(mapping);
+    page->magic = OAKUM_SHARED_STATISTICS_MAGIC;
+    page->version = OAKUM_SHARED_STATISTICS_VERSION;
+    page->size = sizeof(OakumSharedStatistics);
+    page->ownerProcessId = static_cast<uint64_t>(getpid());
+    return true;
+}
+
+void SharedStatisticsPublisher::closePage() {
+    munmap(page, sizeof(OakumSharedStatistics));
+    page = nullptr;
+    shm_unlink(name.c_str());
+}
+} // namespace Oakum
@@ -0,0 +1,79 @@
+#include "source/linux/error.h"
+#include "source/signal_reporter.h"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace Oakum {
+static std::atomic<int> signalPipeWriteDescriptor = -1;
+static struct sigaction previousSignalAction = {};
+
+SignalReporter::SignalReporter(int signalNumber, ReportFunction &&reportFunction)
+    : signalNumber(signalNumber),
+      reportFunction(std::move(reportFunction)) {}
+
+SignalReporter::~SignalReporter() {
+    stop();
+}
+
+bool SignalReporter::isSupported() {
+    return true;
+}
+
+void SignalReporter::start() {
+    // Signal handler must never block, so a full pipe simply drops the request. There is a pending one anyway.
+    FATAL_ERROR_ON_FAILED_SYSCALL(pipe2(pipeDescriptors, O_CLOEXEC));
+    FATAL_ERROR_ON_FAILED_SYSCALL(fcntl(pipeDescriptors[1], F_SETFL, O_NONBLOCK));
+    signalPipeWriteDescriptor.store(pipeDescriptors[1]);
+
+    thread.start([this]() { run(); });
+
+    struct sigaction action = {};
+    action.sa_handler = &SignalReporter::handleSignal;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    FATAL_ERROR_ON_FAILED_SYSCALL(sigaction(signalNumber, &action, &previousSignalAction));
+}
+
+void SignalReporter::stop() {
+    if (!thread.isStarted()) {
+        return;
+    }
+
+    sigaction(signalNumber, &previousSignalAction, nullptr);
+    signalPipeWriteDescriptor.store(-1);
+
+    // Closing the write end wakes up the thread even if the pipe is full
+    thread.stop([this]() { close(pipeDescriptors[1]); });
+    close(pipeDescriptors[0]);
+    pipeDescriptors[0] = -1;
+    pipeDescriptors[1] = -1;
+}
+
+void SignalReporter::handleSignal(int) {
+    const int savedErrno = errno;
+    const int descriptor = signalPipeWriteDescriptor.load();
+    if (descriptor != -1) {
+        const char request = 0;
+        [[maybe_unused]] const ssize_t result = write(descriptor, &request, 1);
+    }
+    errno = savedErrno;
+}
+
+void SignalReporter::run() {
+    char requests[64] = {};
+    while (true) {
+        const ssize_t readSize = read(pipeDescriptors[0], requests, sizeof(requests));
+        if (readSize < 0 && errno == EINTR) {
+            continue;
+        }
+        if (readSize <= 0 || thread.isStopRequested()) {
+            break;
+        }
+        reportFunction(); // all requests read at once are served by a single report
+    }
+}
+} // namespace Oakum
@@ -1,12 +1,17 @@
 #include "source/error.h"
 #include "source/include/oakum/oakum_api.h"
+#include "source/module_registry.h"
+#include "source/report_arena.h"
 #include "source/stack_trace.h"
+#include "source/symbol_cache.h"
 #include "source/syscalls.h"
 
+#include <cstring>
 #include <sstream>
+#include <unistd.h>
 
 namespace Oakum {
-static void demangleAndSetupString(char *&destination, const char *source) {
+static void demangleAndSetupString(char *&destination, const char *source, ReportArena &strings) {
     if (source == nullptr) {
         return;
     }
@@ -15,13 +20,30 @@ static void demangleAndSetupString(char *&destination, const char *source) {
     char *demangled = syscalls.demangleSymbol(source, 0, 0, &status);
     FATAL_ERROR_IF(status == -3, "Demangling of symbol \"", source, "\" failed. status=", status);
     if (status != 0) {
-        StackTraceHelper::setupString(destination, source);
+        StackTraceHelper::setupString(destination, source, strings);
     } else {
-        StackTraceHelper::setupString(destination, demangled);
+        StackTraceHelper::setupString(destination, demangled, strings);
         free(demangled);
     }
 }
 
+static const std::string *getCacheModuleId(const SymbolCache *symbolCache, const ModuleRegistry::Module *module) {
+    if (symbolCache == nullptr || module == nullptr) {
+        return nullptr;
+    }
+
+    // Persistent results must be bound to the exact binary. Results kept in memory are valid as long as the module is loaded.
+    if (!module->buildId.empty()) {
+        return &module->buildId;
+    }
+    return symbolCache->isPersistent() ? nullptr : &module->path;
+}
+
+// Cache returns pointers to its storage, so results are copied before the lock is released
+static std::unique_lock<std::mutex> lockSymbolCache(std::mutex *symbolCacheLock) {
+    return symbolCacheLock != nullptr ? std::unique_lock{*symbolCacheLock} : std::unique_lock<std::mutex>{};
+}
+
 static std::pair<std::string, size_t> addr2line(const char *binaryName, size_t vma) {
     std::stringstream hexStream;
     hexStream << std::hex << vma;
@@ -42,33 +64,116 @@ static std::pair<std::string, size_t> addr2line(const char *binaryName, size_t v
     return {fileNameString, fileLine};
 }
 
-bool StackTraceHelper::supportsSourceLocations() {
-    std::string output = syscalls.runProcessForOutput("which", {"addr2line"});
-    return !output.empty();
+bool StackTraceHelper::getModuleAddressRanges(const char *moduleName, std::vector<AddressRange> &outRanges) {
+    struct CallbackData {
+        const char *moduleName;
+        std::vector<AddressRange> &outRanges;
+        bool found;
+    } data{moduleName, outRanges, false};
+
+    auto callback = [](dl_phdr_info *info, size_t, void *userData) -> int {
+        auto &data = *static_cast<CallbackData *>(userData);
+
+        // Main executable is reported with an empty name
+        const char *modulePath = info->dlpi_name[0] != '\0' ? info->dlpi_name : program_invocation_name;
+        if (strstr(modulePath, data.moduleName) == nullptr) {
+            return 0;
+        }
+
+        for (ElfW(Half) headerIndex = 0; headerIndex < info->dlpi_phnum; headerIndex++) {
+            const ElfW(Phdr) &header = info->dlpi_phdr[headerIndex];
+            if (header.p_type == PT_LOAD && (header.p_flags & PF_X)) {
+                const uintptr_t begin = info->dlpi_addr + header.p_vaddr;
+                data.outRanges.push_back({begin, begin + header.p_memsz});
+                data.found = true;
+            }
+        }
+        return 0;
+    };
+    dl_iterate_phdr(callback, &data);
+    return data.found;
 }
 
-void StackTraceHelper::captureFrames(OakumStackFrame *frames, size_t &framesCount) {
-    static thread_local void *frameAddresses[OAKUM_MAX_STACK_FRAMES_COUNT + skippedFrames] = {};
-    framesCount = backtrace(frameAddresses, OAKUM_MAX_STACK_FRAMES_COUNT + skippedFrames);
-    framesCount -= skippedFrames;
+static bool isExecutableInPath(const char *binaryName) {
+    const char *pathVariable = getenv("PATH");
+    if (pathVariable == nullptr) {
+        return false;
+    }
 
-    for (size_t frameIndex = 0; frameIndex < framesCount; frameIndex++) {
-        frames[frameIndex].address = frameAddresses[frameIndex + skippedFrames];
+    std::string_view remainingPath{pathVariable};
+    while (true) {
+        const size_t separatorPos = remainingPath.find(':');
+        std::string_view directory = remainingPath.substr(0, separatorPos);
+        if (directory.empty()) {
+            directory = "."; // empty entry denotes current directory
+        }
+
+        const std::string candidate = std::string{directory} + '/' + binaryName;
+        if (access(candidate.c_str(), X_OK) == 0) {
+            return true;
+        }
+
+        if (separatorPos == std::string_view::npos) {
+            return false;
+        }
+        remainingPath.remove_prefix(separatorPos + 1);
     }
 }
 
-bool StackTraceHelper::resolveSymbols(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSymbolName) {
+bool StackTraceHelper::supportsSourceLocations() {
+    // Probed once per process, because applications may call oakumInit very often, e.g. before every test.
+    static const bool supported = isExecutableInPath("addr2line");
+    return supported;
+}
+
+void StackTraceHelper::captureFrames(size_t maxFramesCount, void **&outFrames, size_t &outFramesCount) {
+    static thread_local void *frameAddresses[OAKUM_STACK_FRAMES_COUNT_LIMIT + skippedFrames] = {};
+    const size_t capturedFramesCount = backtrace(frameAddresses, static_cast<int>(maxFramesCount + skippedFrames));
+    outFrames = frameAddresses + skippedFrames;
+    outFramesCount = capturedFramesCount > skippedFrames ? capturedFramesCount - skippedFrames : 0u;
+}
+
+bool StackTraceHelper::resolveSymbols(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSymbolName, SymbolCache *symbolCache, ModuleRegistry &modules, ReportArena &strings, std::mutex *symbolCacheLock) {
     bool result = true;
     for (size_t frameIndex = 0; frameIndex < framesCount; frameIndex++) {
         OakumStackFrame &frame = frames[frameIndex];
+        const ModuleRegistry::Module *module = modules.getModule(frame.moduleIndex);
+
+        const std::string *cacheModuleId = getCacheModuleId(symbolCache, module);
+        bool cached = false;
+        if (cacheModuleId != nullptr) {
+            const auto lock = lockSymbolCache(symbolCacheLock);
+            const std::optional<const char *> cachedSymbolName = symbolCache->findSymbol(*cacheModuleId, frame.moduleOffset);
+            if (cachedSymbolName.has_value()) {
+                if (cachedSymbolName.value() != nullptr) {
+                    setupString(frame.symbolName, cachedSymbolName.value(), strings);
+                }
+                cached = true;
+            }
+        }
 
-        Dl_info dlInfo = {};
-        if (syscalls.dladdr(frame.address, &dlInfo) != 0) {
-            demangleAndSetupString(frame.symbolName, dlInfo.dli_sname);
+        if (!cached) {
+            // Symbol tables of ELF files contain all symbols. Dynamic linker only knows about the exported ones.
+            const char *mangledName = nullptr;
+            if (module != nullptr) {
+                mangledName = syscalls.lookupElfSymbol(module->path.c_str(), frame.moduleOffset);
+            }
+            if (mangledName == nullptr) {
+                Dl_info dlInfo = {};
+                if (syscalls.dladdr(frame.address, &dlInfo) != 0) {
+                    mangledName = dlInfo.dli_sname;
+                }
+            }
+            demangleAndSetupString(frame.symbolName, mangledName, strings);
+            if (cacheModuleId != nullptr) {
+                const auto lock = lockSymbolCache(symbolCacheLock);
+                symbolCache->storeSymbol(*cacheModuleId, frame.moduleOffset, frame.symbolName);
+            }
         }
+
         if (frame.symbolName == nullptr) {
             if (fallbackSymbolName.has_value()) {
-                setupString(frames[frameIndex].symbolName, fallbackSymbolName.value().c_str());
+                setupString(frames[frameIndex].symbolName, fallbackSymbolName.value().c_str(), strings);
             } else {
                 result = false;
             }
@@ -77,28 +182,44 @@ bool StackTraceHelper::resolveSymbols(OakumStackFrame *frames, size_t framesCoun
     return result;
 }
 
-bool StackTraceHelper::resolveSourceLocations(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSourceFileName) {
+bool StackTraceHelper::resolveSourceLocations(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSourceFileName, SymbolCache *symbolCache, ModuleRegistry &modules, ReportArena &strings, std::mutex *symbolCacheLock) {
     bool result = true;
     for (size_t frameIndex = 0; frameIndex < framesCount; frameIndex++) {
         OakumStackFrame &frame = frames[frameIndex];
+        const ModuleRegistry::Module *module = modules.getModule(frame.moduleIndex);
 
-        Dl_info dlInfo = {};
-        link_map *linkMap = {};
+        const std::string *cacheModuleId = getCacheModuleId(symbolCache, module);
+        bool cached = false;
         bool resolved = false;
-        if (syscalls.dladdr1(frame.address, &dlInfo, reinterpret_cast<void **>(&linkMap), RTLD_DL_LINKMAP) != 0) {
-            const char *binaryName = dlInfo.dli_fname;
-            const size_t addressVma = reinterpret_cast<size_t>(frame.address) - linkMap->l_addr;
-            const auto [fileName, fileLine] = addr2line(binaryName, addressVma);
+        if (cacheModuleId != nullptr) {
+            const auto lock = lockSymbolCache(symbolCacheLock);
+            const std::optional<SymbolCache::SourceLocation> cachedSourceLocation = symbolCache->findSourceLocation(*cacheModuleId, frame.moduleOffset);
+            if (cachedSourceLocation.has_value()) {
+                if (cachedSourceLocation->fileName != nullptr) {
+                    setupString(frame.fileName, cachedSourceLocation->fileName, strings);
+                    resolved = true;
+                }
+                frame.fileLine = cachedSourceLocation->fileLine;
+                cached = true;
+            }
+        }
+
+        if (!cached && module != nullptr) {
+            const auto [fileName, fileLine] = addr2line(module->path.c_str(), frame.moduleOffset);
             if (fileName != "??") {
-                setupString(frame.fileName, fileName.c_str());
+                setupString(frame.fileName, fileName.c_str(), strings);
                 resolved = true;
             }
             frame.fileLine = fileLine;
+            if (cacheModuleId != nullptr) {
+                const auto lock = lockSymbolCache(symbolCacheLock);
+                symbolCache->storeSourceLocation(*cacheModuleId, frame.moduleOffset, frame.fileName, frame.fileLine);
+            }
         }
 
         if (!resolved) {
             if (fallbackSourceFileName.has_value()) {
-                setupString(frames[frameIndex].fileName, fallbackSourceFileName.value().c_str());
+                setupString(frames[frameIndex].fileName, fallbackSourceFileName.value().c_str(), strings);
             } else {
                 result = false;
             }
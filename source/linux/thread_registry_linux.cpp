@@ -0,0 +1,26 @@
+#include "source/thread_registry.h"
+
+#include <fstream>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Oakum {
+uint64_t ThreadRegistry::getCurrentThreadId() {
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+}
+
+bool ThreadRegistry::getCurrentThreadName(std::string &outName) {
+    char name[16] = {}; // kernel limit including the terminator
+    if (pthread_getname_np(pthread_self(), name, sizeof(name)) != 0) {
+        return false;
+    }
+    outName = name;
+    return true;
+}
+
+bool ThreadRegistry::getThreadName(uint64_t threadId, std::string &outName) {
+    std::ifstream file{"/proc/self/task/" + std::to_string(threadId) + "/comm"};
+    return static_cast<bool>(std::getline(file, outName));
+}
+} // namespace Oakum
@@ -0,0 +1,16 @@
+#include "source/trace_writer.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Oakum {
+uint64_t TraceWriter::getCurrentProcessId() {
+    return static_cast<uint64_t>(getpid());
+}
+
+uint64_t TraceWriter::getCurrentThreadId() {
+    // Kernel thread id matches the one displayed by debuggers and profilers. It never changes, so it is queried once.
+    static thread_local const uint64_t threadId = static_cast<uint64_t>(syscall(SYS_gettid));
+    return threadId;
+}
+} // namespace Oakum
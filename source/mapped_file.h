@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace Oakum {
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+public:
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    static std::unique_ptr<MappedFile> open(const char *path);
+
+    const uint8_t *getData() const { return data; }
+    size_t getSize() const { return size; }
+
+private:
+    MappedFile(const uint8_t *data, size_t size, void *osHandle) : data(data), size(size), osHandle(osHandle) {}
+
+    const uint8_t *data;
+    size_t size;
+    void *osHandle;
+};
+
+} // namespace Oakum
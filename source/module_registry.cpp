@@ -0,0 +1,177 @@
+#include "source/error.h"
+#include "source/include/oakum/oakum_api.h"
+#include "source/module_registry.h"
+#include "source/oakum_controller.h"
+
+#include <algorithm>
+
+namespace Oakum {
+void ModuleRegistry::refresh() {
+    refreshModules(true);
+}
+
+void ModuleRegistry::refreshIfChanged() {
+    // Without change counters the list would be walked on every captured stack trace, so it is walked only once here and
+    // then only by refresh. Until then, frames in modules loaded in the meantime are stored as absolute addresses.
+    refreshModules(false);
+}
+
+void ModuleRegistry::refreshModules(bool walkWithoutCounters) {
+    // Dynamic linker counts all loads and unloads, so the list has to be walked only if any of them happened
+    uint64_t currentLoadsCount = 0;
+    uint64_t currentUnloadsCount = 0;
+    const bool hasCounters = getChangeCounters(currentLoadsCount, currentUnloadsCount);
+    if (hasCounters && currentLoadsCount == loadsCount.load(std::memory_order_acquire) && currentUnloadsCount == unloadsCount.load(std::memory_order_acquire)) {
+        return;
+    }
+    if (!hasCounters && !walkWithoutCounters && loadedModules.load(std::memory_order_acquire) != nullptr) {
+        return;
+    }
+
+    // Module table lives until deinitialization, so it must not be reported as a leak
+    RaiiOakumIgnore raiiIgnore{};
+    std::lock_guard lockGuard{lock};
+
+    std::vector<Module> currentModules{};
+    if (!enumerateModules(currentModules)) {
+        return;
+    }
+
+    const LoadedModules *previousLoadedModules = loadedModules.load(std::memory_order_relaxed);
+    std::vector<bool> stillLoaded(modules.size(), false);
+    for (Module &currentModule : currentModules) {
+        const LoadedModule *existingModule = nullptr;
+        if (previousLoadedModules != nullptr) {
+            auto loadedModule = std::find_if(previousLoadedModules->begin(), previousLoadedModules->end(), [&](const LoadedModule &loadedModule) {
+                const Module &module = modules[loadedModule.moduleIndex];
+                return module.baseAddress == currentModule.baseAddress && module.path == currentModule.path;
+            });
+            existingModule = loadedModule != previousLoadedModules->end() ? &*loadedModule : nullptr;
+        }
+        if (existingModule != nullptr) {
+            stillLoaded[existingModule->moduleIndex] = true;
+        } else {
+            currentModule.loaded = true;
+            modules.push_back(std::move(currentModule));
+            stillLoaded.push_back(true);
+        }
+    }
+
+    auto currentLoadedModules = std::make_unique<LoadedModules>();
+    for (size_t moduleIndex = 0; moduleIndex < modules.size(); moduleIndex++) {
+        Module &module = modules[moduleIndex];
+        module.loaded = stillLoaded[moduleIndex];
+        if (module.loaded) {
+            currentLoadedModules->push_back({module.begin, module.end, module.baseAddress, moduleIndex});
+        }
+    }
+    std::sort(currentLoadedModules->begin(), currentLoadedModules->end(), [](const LoadedModule &left, const LoadedModule &right) {
+        return left.begin < right.begin;
+    });
+
+    // Counters are published last, so a thread, which sees them, sees the new snapshot as well
+    loadedModules.store(currentLoadedModules.get(), std::memory_order_release);
+    loadedModulesSnapshots.push_back(std::move(currentLoadedModules));
+    if (hasCounters) {
+        loadsCount.store(currentLoadsCount, std::memory_order_release);
+        unloadsCount.store(currentUnloadsCount, std::memory_order_release);
+    }
+}
+
+const ModuleRegistry::LoadedModule *ModuleRegistry::findLoadedModule(const LoadedModules &sortedModules, uintptr_t address) {
+    // Find the last module beginning at or before the address
+    auto loadedModule = std::upper_bound(sortedModules.begin(), sortedModules.end(), address, [](uintptr_t value, const LoadedModule &loadedModule) {
+        return value < loadedModule.begin;
+    });
+    if (loadedModule == sortedModules.begin() || address >= std::prev(loadedModule)->end) {
+        return nullptr;
+    }
+    return &*std::prev(loadedModule);
+}
+
+bool ModuleRegistry::findModule(const void *address, size_t &outModuleIndex, uintptr_t &outOffset) {
+    const LoadedModules *currentLoadedModules = loadedModules.load(std::memory_order_acquire);
+    const uintptr_t addressValue = reinterpret_cast<uintptr_t>(address);
+    const LoadedModule *loadedModule = currentLoadedModules != nullptr ? findLoadedModule(*currentLoadedModules, addressValue) : nullptr;
+    if (loadedModule == nullptr) {
+        return false;
+    }
+
+    outModuleIndex = loadedModule->moduleIndex;
+    outOffset = addressValue - loadedModule->baseAddress;
+    return true;
+}
+
+void ModuleRegistry::getRelativeAddresses(void *const *addresses, size_t addressesCount, void **outRelativeAddresses) {
+    // Consecutive frames are usually in the same module, so it is checked before searching all of them
+    const LoadedModules *currentLoadedModules = loadedModules.load(std::memory_order_acquire);
+    const LoadedModule *loadedModule = nullptr;
+    for (size_t addressIndex = 0; addressIndex < addressesCount; addressIndex++) {
+        void *const address = addresses[addressIndex];
+        const uintptr_t addressValue = reinterpret_cast<uintptr_t>(address);
+        if (currentLoadedModules != nullptr && (loadedModule == nullptr || addressValue < loadedModule->begin || addressValue >= loadedModule->end)) {
+            loadedModule = findLoadedModule(*currentLoadedModules, addressValue);
+        }
+        if (sizeof(void *) < sizeof(uint64_t) || loadedModule == nullptr) {
+            outRelativeAddresses[addressIndex] = address;
+            continue;
+        }
+
+        const uint64_t moduleIndex = loadedModule->moduleIndex;
+        const uint64_t offset = addressValue - loadedModule->baseAddress;
+        if ((offset >> moduleIndexShift) != 0 || ((moduleIndex << moduleIndexShift) & relativeAddressFlag) != 0) {
+            outRelativeAddresses[addressIndex] = address; // does not fit
+            continue;
+        }
+        outRelativeAddresses[addressIndex] = reinterpret_cast<void *>(static_cast<uintptr_t>(relativeAddressFlag | (moduleIndex << moduleIndexShift) | offset));
+    }
+}
+
+bool ModuleRegistry::resolveRelativeAddress(const void *relativeAddress, void *&outAddress, size_t &outModuleIndex, uintptr_t &outOffset) {
+    const uint64_t value = reinterpret_cast<uintptr_t>(relativeAddress);
+    if ((value & relativeAddressFlag) == 0) {
+        outAddress = const_cast<void *>(relativeAddress);
+        return findModule(relativeAddress, outModuleIndex, outOffset);
+    }
+
+    const size_t moduleIndex = static_cast<size_t>((value & ~relativeAddressFlag) >> moduleIndexShift);
+    const Module *module = getModule(moduleIndex);
+    DEBUG_ERROR_IF(module == nullptr, "Relative address of an unknown module");
+    if (module == nullptr) {
+        outAddress = nullptr;
+        return false;
+    }
+    outModuleIndex = moduleIndex;
+    outOffset = static_cast<uintptr_t>(value & ((uint64_t{1} << moduleIndexShift) - 1));
+    outAddress = reinterpret_cast<void *>(module->baseAddress + outOffset);
+    return true;
+}
+
+const ModuleRegistry::Module *ModuleRegistry::getModule(size_t moduleIndex) {
+    std::lock_guard lockGuard{lock};
+    if (moduleIndex >= modules.size()) {
+        return nullptr;
+    }
+    return &modules[moduleIndex];
+}
+
+void ModuleRegistry::getModules(OakumModule *outModules, size_t &inOutModulesCount) {
+    std::lock_guard lockGuard{lock};
+    if (outModules == nullptr) {
+        inOutModulesCount = modules.size();
+        return;
+    }
+
+    inOutModulesCount = std::min(inOutModulesCount, modules.size());
+    for (size_t moduleIndex = 0; moduleIndex < inOutModulesCount; moduleIndex++) {
+        const Module &module = modules[moduleIndex];
+        OakumModule &outModule = outModules[moduleIndex];
+        outModule.path = module.path.c_str();
+        outModule.buildId = module.buildId.c_str();
+        outModule.baseAddress = reinterpret_cast<void *>(module.baseAddress);
+        outModule.addressBegin = reinterpret_cast<void *>(module.begin);
+        outModule.addressEnd = reinterpret_cast<void *>(module.end);
+        outModule.loaded = module.loaded;
+    }
+}
+} // namespace Oakum
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct OakumModule;
+
+namespace Oakum {
+
+// Table of modules (executable and shared libraries) loaded into the process. Each module is registered once and
+// keeps its index for the lifetime of the registry, so addresses can be described as (module index, offset) pairs,
+// which do not depend on address space layout. Modules unloaded after registration stay in the table marked as such.
+// Refreshing is cheap when no module has been loaded or unloaded since the previous refresh.
+//
+// Captured frames are stored as relative addresses, i.e. module index and offset packed into a pointer sized value, so
+// they keep describing the right module after it is unloaded, even if another module is mapped at its range later.
+// Relative addresses have the highest bit set, which is never set in user space addresses. Addresses outside of known
+// modules and, on 32-bit platforms, all addresses are stored unchanged and looked up in currently loaded modules.
+class ModuleRegistry {
+public:
+    struct Module {
+        std::string path = {};
+        std::string buildId = {};   // hexadecimal, empty if the module does not have one
+        uintptr_t baseAddress = {}; // subtracted from addresses to get offsets
+        uintptr_t begin = {};       // range of mapped segments [begin, end)
+        uintptr_t end = {};
+        uint64_t fileOffset = {};   // offset in the file mapped at begin
+        bool loaded = {};
+    };
+
+    void refresh();
+    void refreshIfChanged();
+    bool findModule(const void *address, size_t &outModuleIndex, uintptr_t &outOffset);
+    const Module *getModule(size_t moduleIndex);
+    void getModules(OakumModule *outModules, size_t &inOutModulesCount);
+
+    // Called on every captured stack trace, after refreshIfChanged, so it does not lock anything
+    void getRelativeAddresses(void *const *addresses, size_t addressesCount, void **outRelativeAddresses);
+    bool resolveRelativeAddress(const void *relativeAddress, void *&outAddress, size_t &outModuleIndex, uintptr_t &outOffset);
+
+protected:
+    struct LoadedModule {
+        uintptr_t begin = {};
+        uintptr_t end = {};
+        uintptr_t baseAddress = {};
+        size_t moduleIndex = {};
+    };
+    using LoadedModules = std::vector<LoadedModule>; // sorted by address
+
+    constexpr static inline uint64_t relativeAddressFlag = uint64_t{1} << 63;
+    constexpr static inline unsigned int moduleIndexShift = 40; // offset is stored in lower bits
+
+    void refreshModules(bool walkWithoutCounters);
+    static bool getChangeCounters(uint64_t &outLoadsCount, uint64_t &outUnloadsCount);
+    static bool enumerateModules(std::vector<Module> &outModules);
+    static const LoadedModule *findLoadedModule(const LoadedModules &sortedModules, uintptr_t address);
+
+    std::mutex lock = {};
+    std::deque<Module> modules = {}; // never shrinks, so references stay valid
+
+    // Loaded modules are read on every captured stack trace without locking. Each refresh, which finds a change, publishes
+    // a new snapshot. Previous snapshots are kept alive, because other threads may still be reading them.
+    std::vector<std::unique_ptr<LoadedModules>> loadedModulesSnapshots = {};
+    std::atomic<const LoadedModules *> loadedModules = nullptr;
+    std::atomic<uint64_t> loadsCount = 0;
+    std::atomic<uint64_t> unloadsCount = 0;
+};
+
+} // namespace Oakum
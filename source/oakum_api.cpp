@@ -1,5 +1,9 @@
 #include "source/include/oakum/oakum_api.h"
 #include "source/oakum_controller.h"
+#include "source/query_server.h"
+#include "source/shared_statistics_publisher.h"
+#include "source/signal_reporter.h"
+#include "source/thread_safety_policy.h"
 
 #define OAKUM_VERIFY(condition, errorCode) \
     if (condition) {                       \
@@ -9,11 +13,44 @@
 #define OAKUM_VERIFY_NON_NULL(ptr) OAKUM_VERIFY(ptr == nullptr, OAKUM_INVALID_VALUE)
 #define OAKUM_VERIFY_POSITIVE(value) OAKUM_VERIFY(value <= 0, OAKUM_INVALID_VALUE)
 
+static bool isValidProfileFormat(OakumProfileFormat format) {
+    return format == OAKUM_PROFILE_FORMAT_PPROF || format == OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES || format == OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES;
+}
+
+static bool isProfileFormatSupported(OakumProfileFormat format, bool stackTraces, bool callSites) {
+    return stackTraces && (format != OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES || callSites);
+}
+
 OakumResult oakumInit(const OakumInitArgs *args) {
     OAKUM_VERIFY_INITIALIZATION(false, OAKUM_ALREADY_INITIALIZED);
     OAKUM_VERIFY_NON_NULL(args);
+    OAKUM_VERIFY(args->maxStackFramesCount > OAKUM_STACK_FRAMES_COUNT_LIMIT, OAKUM_INVALID_VALUE);
+    OAKUM_VERIFY(args->ignoreRulesFramesCount > OAKUM_STACK_FRAMES_COUNT_LIMIT, OAKUM_INVALID_VALUE);
+    OAKUM_VERIFY(args->stackTraceMode != OAKUM_STACK_TRACE_MODE_FULL && args->stackTraceMode != OAKUM_STACK_TRACE_MODE_CALLER &&
+                     args->stackTraceMode != OAKUM_STACK_TRACE_MODE_ADAPTIVE,
+                 OAKUM_INVALID_VALUE);
+
+    OAKUM_VERIFY(args->trendSamplingIntervalMs != 0 && args->trendWindowSamplesCount < 2, OAKUM_INVALID_VALUE);
+
+    if (args->reportSignal != 0) {
+        OAKUM_VERIFY_NON_NULL(args->reportFilePath);
+        OAKUM_VERIFY(!isValidProfileFormat(args->reportFormat), OAKUM_INVALID_VALUE);
+        OAKUM_VERIFY(!Oakum::SignalReporter::isSupported() || !Oakum::ThreadSafety::isThreadSafe(true), OAKUM_FEATURE_NOT_SUPPORTED);
+        OAKUM_VERIFY(!isProfileFormatSupported(args->reportFormat, args->trackStackTraces, args->stackTraceMode != OAKUM_STACK_TRACE_MODE_FULL), OAKUM_FEATURE_NOT_SUPPORTED);
+    }
 
-    Oakum::OakumController::initialize(*args);
+    if (args->querySocketPath != nullptr) {
+        OAKUM_VERIFY(!Oakum::QueryServer::isSupported() || !Oakum::ThreadSafety::isThreadSafe(true), OAKUM_FEATURE_NOT_SUPPORTED);
+    }
+
+    if (args->sharedStatisticsName != nullptr) {
+        OAKUM_VERIFY(args->sharedStatisticsIntervalMs == 0, OAKUM_INVALID_VALUE);
+        OAKUM_VERIFY(!Oakum::SharedStatisticsPublisher::isSupported(), OAKUM_FEATURE_NOT_SUPPORTED);
+    }
+
+    if (!Oakum::OakumController::initialize(*args)) {
+        return OAKUM_IO_ERROR;
+    }
     return OAKUM_SUCCESS;
 }
 
@@ -46,6 +83,23 @@ OakumResult oakumDetectLeaks() {
     return OAKUM_SUCCESS;
 }
 
+OakumResult oakumGetStatistics(OakumStatistics *outStatistics) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(outStatistics);
+
+    *outStatistics = Oakum::OakumController::getInstance()->getStatistics();
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumGetThreadStatistics(OakumThreadStatistics *outThreads, size_t *inOutThreadsCount) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(inOutThreadsCount);
+    OAKUM_VERIFY(!Oakum::OakumController::getInstance()->hasThreads(), OAKUM_FEATURE_NOT_SUPPORTED);
+
+    Oakum::OakumController::getInstance()->getThreadStatistics(outThreads, *inOutThreadsCount);
+    return OAKUM_SUCCESS;
+}
+
 OakumResult oakumGetAllocations(OakumAllocation **outAllocations, size_t *outAllocationsCount) {
     OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
     OAKUM_VERIFY_NON_NULL(outAllocations);
@@ -55,11 +109,85 @@ OakumResult oakumGetAllocations(OakumAllocation **outAllocations, size_t *outAll
     return OAKUM_SUCCESS;
 }
 
+OakumResult oakumGetModules(OakumModule *outModules, size_t *inOutModulesCount) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(inOutModulesCount);
+
+    Oakum::OakumController::getInstance()->getModules(outModules, *inOutModulesCount);
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumGetCallSites(OakumCallSite *outCallSites, size_t *inOutCallSitesCount) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(inOutCallSitesCount);
+    OAKUM_VERIFY(!Oakum::OakumController::getInstance()->hasCallSites(), OAKUM_FEATURE_NOT_SUPPORTED);
+
+    Oakum::OakumController::getInstance()->getCallSites(outCallSites, *inOutCallSitesCount);
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumGetChurnCallSites(uint64_t maxLifetimeNs, OakumCallSiteHistograms *outCallSites, size_t *inOutCallSitesCount) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(inOutCallSitesCount);
+    OAKUM_VERIFY(!Oakum::OakumController::getInstance()->hasLifetimes(), OAKUM_FEATURE_NOT_SUPPORTED);
+
+    Oakum::OakumController::getInstance()->getChurnCallSites(maxLifetimeNs, outCallSites, *inOutCallSitesCount);
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumGetGrowingCallSites(OakumGrowingCallSite *outCallSites, size_t *inOutCallSitesCount) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(inOutCallSitesCount);
+    OAKUM_VERIFY(!Oakum::OakumController::getInstance()->hasTrendSampling(), OAKUM_FEATURE_NOT_SUPPORTED);
+
+    Oakum::OakumController::getInstance()->getGrowingCallSites(outCallSites, *inOutCallSitesCount);
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumWriteProfile(OakumProfileFormat format, const char *filePath) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY(!isValidProfileFormat(format), OAKUM_INVALID_VALUE);
+    OAKUM_VERIFY_NON_NULL(filePath);
+    Oakum::OakumController *controller = Oakum::OakumController::getInstance();
+    OAKUM_VERIFY(!isProfileFormatSupported(format, controller->getCapabilities().supportStackTraces, controller->hasCallSites()), OAKUM_FEATURE_NOT_SUPPORTED);
+
+    if (!Oakum::OakumController::getInstance()->writeProfile(format, filePath, false)) {
+        return OAKUM_IO_ERROR;
+    }
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumGetPeakSnapshotInfo(OakumPeakSnapshotInfo *outInfo) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(outInfo);
+    Oakum::OakumController *controller = Oakum::OakumController::getInstance();
+    OAKUM_VERIFY(!controller->hasPeakSnapshots(), OAKUM_FEATURE_NOT_SUPPORTED);
+
+    *outInfo = controller->getPeakSnapshotInfo();
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumWritePeakProfile(OakumProfileFormat format, const char *filePath) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY(!isValidProfileFormat(format), OAKUM_INVALID_VALUE);
+    OAKUM_VERIFY_NON_NULL(filePath);
+    Oakum::OakumController *controller = Oakum::OakumController::getInstance();
+    OAKUM_VERIFY(!controller->hasPeakSnapshots(), OAKUM_FEATURE_NOT_SUPPORTED);
+    OAKUM_VERIFY(!isProfileFormatSupported(format, controller->getCapabilities().supportStackTraces, false), OAKUM_FEATURE_NOT_SUPPORTED);
+
+    if (!controller->writeProfile(format, filePath, true)) {
+        return OAKUM_IO_ERROR;
+    }
+    return OAKUM_SUCCESS;
+}
+
 OakumResult oakumReleaseAllocations(OakumAllocation *allocations, size_t allocationsCount) {
     OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
     OAKUM_VERIFY((allocations == nullptr) != (allocationsCount == 0), OAKUM_INVALID_VALUE);
 
-    Oakum::OakumController::getInstance()->releaseAllocations(allocations, allocationsCount);
+    if (allocations != nullptr) {
+        Oakum::OakumController::getInstance()->releaseAllocations(allocations);
+    }
     return OAKUM_SUCCESS;
 }
 
@@ -68,13 +196,9 @@ OakumResult oakumResolveStackTraceSymbols(OakumAllocation *allocations, size_t a
     OAKUM_VERIFY((allocations == nullptr) != (allocationsCount == 0), OAKUM_INVALID_VALUE);
     OAKUM_VERIFY(!Oakum::OakumController::getInstance()->getCapabilities().supportStackTraces, OAKUM_FEATURE_NOT_SUPPORTED);
 
-    for (size_t allocationIndex = 0; allocationIndex < allocationsCount; allocationIndex++) {
-        const bool success = Oakum::OakumController::getInstance()->resolveStackTraceSymbols(allocations[allocationIndex]);
-        if (!success) {
-            return OAKUM_RESOLVING_FAILED;
-        }
+    if (!Oakum::OakumController::getInstance()->resolveStackTraceSymbols(allocations, allocationsCount)) {
+        return OAKUM_RESOLVING_FAILED;
     }
-
     return OAKUM_SUCCESS;
 }
 
@@ -83,13 +207,9 @@ OakumResult oakumResolveStackTraceSourceLocations(OakumAllocation *allocations,
     OAKUM_VERIFY((allocations == nullptr) != (allocationsCount == 0), OAKUM_INVALID_VALUE);
     OAKUM_VERIFY(!Oakum::OakumController::getInstance()->getCapabilities().supportStackTraces, OAKUM_FEATURE_NOT_SUPPORTED);
 
-    for (size_t allocationIndex = 0; allocationIndex < allocationsCount; allocationIndex++) {
-        const bool success = Oakum::OakumController::getInstance()->resolveStackTraceSourceLocations(allocations[allocationIndex]);
-        if (!success) {
-            return OAKUM_RESOLVING_FAILED;
-        }
+    if (!Oakum::OakumController::getInstance()->resolveStackTraceSourceLocations(allocations, allocationsCount)) {
+        return OAKUM_RESOLVING_FAILED;
     }
-
     return OAKUM_SUCCESS;
 }
 
@@ -108,3 +228,61 @@ OakumResult oakumStopIgnore() {
     }
     return OAKUM_SUCCESS;
 }
+
+OakumResult oakumGetIgnoreToken(OakumIgnoreToken *outToken) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(outToken);
+
+    *outToken = Oakum::OakumController::getInstance()->getIgnoreToken();
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumSetIgnoreToken(OakumIgnoreToken token) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+
+    if (!Oakum::OakumController::getInstance()->setIgnoreToken(token)) {
+        return OAKUM_INVALID_VALUE;
+    }
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumAddIgnoreRule(const OakumIgnoreRule *rule) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(rule);
+    OAKUM_VERIFY(rule->type != OAKUM_IGNORE_RULE_MODULE && rule->type != OAKUM_IGNORE_RULE_ADDRESS_RANGE, OAKUM_INVALID_VALUE);
+    OAKUM_VERIFY(rule->type == OAKUM_IGNORE_RULE_MODULE && rule->moduleName == nullptr, OAKUM_INVALID_VALUE);
+    OAKUM_VERIFY(rule->type == OAKUM_IGNORE_RULE_ADDRESS_RANGE && rule->addressBegin >= rule->addressEnd, OAKUM_INVALID_VALUE);
+
+    if (!Oakum::OakumController::getInstance()->addIgnoreRule(*rule)) {
+        return OAKUM_RESOLVING_FAILED;
+    }
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumBeginScope(const char *scopeName) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(scopeName);
+
+    Oakum::OakumController::getInstance()->beginScope(scopeName);
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumEndScope() {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+
+    if (!Oakum::OakumController::getInstance()->endScope()) {
+        return OAKUM_NOT_IN_SCOPE;
+    }
+    return OAKUM_SUCCESS;
+}
+
+OakumResult oakumDetectScopeLeaks(const char *scopeName) {
+    OAKUM_VERIFY_INITIALIZATION(true, OAKUM_UNINITIALIZED);
+    OAKUM_VERIFY_NON_NULL(scopeName);
+
+    if (Oakum::OakumController::getInstance()->hasScopeAllocations(scopeName)) {
+        return OAKUM_LEAKS_DETECTED;
+    }
+
+    return OAKUM_SUCCESS;
+}
@@ -1,31 +1,51 @@
 #include "source/error.h"
+#include "source/folded_stack_writer.h"
 #include "source/oakum_controller.h"
+#include "source/pprof_writer.h"
+#include "source/profile.h"
 #include "source/stack_trace.h"
 
 #include <algorithm>
-
-struct RaiiOakumIgnore {
-    RaiiOakumIgnore() {
-        Oakum::OakumController::getInstance()->incrementIgnoreRefcount();
-    }
-    ~RaiiOakumIgnore() {
-        FATAL_ERROR_IF(!Oakum::OakumController::getInstance()->decrementIgnoreRefcount(), "Cannot decrement ignore refcount");
-    }
-};
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <map>
 
 namespace Oakum {
 OakumController::OakumController(const OakumInitArgs &initArgs)
     : capabilities(createCapabilities(initArgs)),
       fallbackSymbolName(createOptionalString(initArgs.fallbackSymbolName)),
       fallbackSourceFileName(createOptionalString(initArgs.fallbackSourceFileName)),
-      sortAllocations(initArgs.sortAllocations) {}
+      symbolCache(createSymbolCache(initArgs)),
+      sortAllocations(initArgs.sortAllocations),
+      threadCacheSize(initArgs.threadCacheSize),
+      stackTraceMode(initArgs.stackTraceMode),
+      maxStackFramesCount(getMaxStackFramesCount(initArgs)),
+      ignoreRulesFramesCount(initArgs.ignoreRulesFramesCount != 0 ? initArgs.ignoreRulesFramesCount : maxStackFramesCount),
+      callSites(createCallSiteTable(initArgs)),
+      traceWriter(createTraceWriter(initArgs)),
+      peakSnapshotMargin(initArgs.peakSnapshotMargin),
+      threadRegistry(initArgs.trackThreads ? std::make_unique<ThreadRegistry>() : nullptr),
+      generation(++generationCounter),
+      cachedPointers(capabilities.threadSafe),
+      stackFrameStore(maxStackFramesCount),
+      ignoreRegions(capabilities.threadSafe),
+      backgroundSymbolizer(createBackgroundSymbolizer(initArgs)),
+      reportFormat(initArgs.reportFormat),
+      reportFilePath(createOptionalString(initArgs.reportFilePath)),
+      signalReporter(createSignalReporter(initArgs)),
+      queryServer(createQueryServer(initArgs)),
+      sharedStatisticsPublisher(createSharedStatisticsPublisher(initArgs)),
+      trendSampler(createTrendSampler(initArgs)) {}
 
 OakumCapabilities OakumController::createCapabilities(const OakumInitArgs &initArgs) {
     OakumCapabilities capabilities{};
     capabilities.supportStackTraces = initArgs.trackStackTraces;
     capabilities.supportStackTracesSourceLocations = initArgs.trackStackTraces && StackTraceHelper::supportsSourceLocations() && OAKUM_SOURCE_LOCATIONS_AVAILABLE == 1;
     capabilities.supportStackTracesSymbols = initArgs.trackStackTraces && OAKUM_SYMBOLS_AVAILABLE == 1;
-    capabilities.threadSafe = initArgs.threadSafe;
+    // Reporter and query server threads read allocations
+    capabilities.threadSafe = ThreadSafety::isThreadSafe(initArgs.threadSafe || initArgs.reportSignal != 0 || initArgs.querySocketPath != nullptr);
     return capabilities;
 }
 
@@ -37,13 +57,135 @@ std::optional<std::string> OakumController::createOptionalString(const char *str
     }
 }
 
-void OakumController::initialize(const OakumInitArgs &initArgs) {
+size_t OakumController::getMaxStackFramesCount(const OakumInitArgs &initArgs) {
+    return initArgs.maxStackFramesCount != 0 ? initArgs.maxStackFramesCount : OAKUM_MAX_STACK_FRAMES_COUNT;
+}
+
+uint64_t OakumController::getTimeNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+std::unique_ptr<SymbolCache> OakumController::createSymbolCache(const OakumInitArgs &initArgs) {
+    if (!initArgs.trackStackTraces) {
+        return nullptr;
+    }
+    if (initArgs.symbolCacheDirectory != nullptr) {
+        return std::make_unique<SymbolCache>(initArgs.symbolCacheDirectory);
+    }
+    if (initArgs.backgroundSymbolization) {
+        return std::make_unique<SymbolCache>(""); // background results have to be stored somewhere
+    }
+    return nullptr;
+}
+
+std::unique_ptr<CallSiteTable> OakumController::createCallSiteTable(const OakumInitArgs &initArgs) {
+    if (!initArgs.trackStackTraces) {
+        return nullptr;
+    }
+    switch (initArgs.stackTraceMode) {
+    case OAKUM_STACK_TRACE_MODE_CALLER:
+        return std::make_unique<CallSiteTable>(0u, 0u, initArgs.trackLifetimes);
+    case OAKUM_STACK_TRACE_MODE_ADAPTIVE:
+        return std::make_unique<CallSiteTable>(initArgs.escalationLiveAllocationsCount, initArgs.escalationLiveBytes, initArgs.trackLifetimes);
+    default:
+        return nullptr;
+    }
+}
+
+std::unique_ptr<TraceWriter> OakumController::createTraceWriter(const OakumInitArgs &initArgs) {
+    if (initArgs.traceFilePath == nullptr) {
+        return nullptr;
+    }
+    return std::make_unique<TraceWriter>(initArgs.traceFilePath, capabilities.threadSafe);
+}
+
+std::unique_ptr<BackgroundSymbolizer> OakumController::createBackgroundSymbolizer(const OakumInitArgs &initArgs) {
+    if (!initArgs.trackStackTraces || !initArgs.backgroundSymbolization) {
+        return nullptr;
+    }
+    return std::make_unique<BackgroundSymbolizer>([this](void *address) { preResolveAddress(address); });
+}
+
+std::unique_ptr<SignalReporter> OakumController::createSignalReporter(const OakumInitArgs &initArgs) {
+    if (initArgs.reportSignal == 0) {
+        return nullptr;
+    }
+    return std::make_unique<SignalReporter>(initArgs.reportSignal, [this]() { writeSignalReport(); });
+}
+
+std::unique_ptr<QueryServer> OakumController::createQueryServer(const OakumInitArgs &initArgs) {
+    if (initArgs.querySocketPath == nullptr) {
+        return nullptr;
+    }
+    return std::make_unique<QueryServer>(initArgs.querySocketPath, [this](std::string_view query, QueryServer::Response &response) {
+        answerQuery(query, response);
+    });
+}
+
+std::unique_ptr<TrendSampler> OakumController::createTrendSampler(const OakumInitArgs &initArgs) {
+    if (callSites == nullptr || initArgs.trendSamplingIntervalMs == 0) {
+        return nullptr;
+    }
+    const std::chrono::milliseconds interval{initArgs.trendSamplingIntervalMs};
+    return std::make_unique<TrendSampler>(*callSites, interval, initArgs.trendWindowSamplesCount);
+}
+
+std::unique_ptr<SharedStatisticsPublisher> OakumController::createSharedStatisticsPublisher(const OakumInitArgs &initArgs) {
+    if (initArgs.sharedStatisticsName == nullptr) {
+        return nullptr;
+    }
+    const std::chrono::milliseconds interval{initArgs.sharedStatisticsIntervalMs};
+    return std::make_unique<SharedStatisticsPublisher>(initArgs.sharedStatisticsName, interval, [this](OakumSharedStatistics &outStatistics) {
+        fillSharedStatistics(outStatistics);
+    });
+}
+
+bool OakumController::initialize(const OakumInitArgs &initArgs) {
     DEBUG_ERROR_IF(isInitialized(), "Multiple Oakum initialization");
     instance.reset(new OakumController(initArgs));
+    if ((instance->traceWriter != nullptr && !instance->traceWriter->isOpen()) ||
+        (instance->queryServer != nullptr && !instance->queryServer->open()) ||
+        (instance->sharedStatisticsPublisher != nullptr && !instance->sharedStatisticsPublisher->open())) {
+        instance.reset();
+        return false;
+    }
+
+    // Background thread uses the instance, so it can be started only after it is published
+    if (instance->backgroundSymbolizer != nullptr) {
+        instance->backgroundSymbolizer->start();
+    }
+    if (instance->signalReporter != nullptr) {
+        instance->signalReporter->start();
+    }
+    if (instance->queryServer != nullptr) {
+        instance->queryServer->start();
+    }
+    if (instance->sharedStatisticsPublisher != nullptr) {
+        instance->sharedStatisticsPublisher->start();
+    }
+    if (instance->trendSampler != nullptr) {
+        instance->trendSampler->start();
+    }
+    return true;
 }
 
 void OakumController::deinitialize() {
     DEBUG_ERROR_IF(!isInitialized(), "Oakum uninitialized");
+    if (instance->trendSampler != nullptr) {
+        instance->trendSampler->stop();
+    }
+    if (instance->sharedStatisticsPublisher != nullptr) {
+        instance->sharedStatisticsPublisher->stop();
+    }
+    if (instance->queryServer != nullptr) {
+        instance->queryServer->stop();
+    }
+    if (instance->signalReporter != nullptr) {
+        instance->signalReporter->stop();
+    }
+    if (instance->backgroundSymbolizer != nullptr) {
+        instance->backgroundSymbolizer->stop();
+    }
     instance.reset();
 }
 
@@ -56,13 +198,16 @@ OakumController *OakumController::getInstance() {
     return instance.get();
 }
 
-void *OakumController::allocateMemory(std::size_t size, bool noThrow) {
+void *OakumController::allocateMemory(std::size_t size, bool noThrow, void *callerAddress) {
     // Allocate memory with actual malloc
     void *pointer = ::malloc(size);
 
     // Handle allocation failure
     if (pointer == nullptr) {
         if (noThrow) {
+            if (isInitialized() && !getInstance()->getIgnoreState()) {
+                getInstance()->statistics.onFailedNoThrowAllocation();
+            }
             return nullptr;
         } else {
             throw std::bad_alloc{};
@@ -77,10 +222,10 @@ void *OakumController::allocateMemory(std::size_t size, bool noThrow) {
             info.size = size;
             info.pointer = pointer;
             info.noThrow = noThrow;
-            info.stackFramesCount = 0;
-
-            const auto lock = oakum.getAllocationsLock();
-            oakum.registerAllocation(info);
+            oakum.registerAllocation(info, callerAddress);
+            if (oakum.peakSnapshotMargin != 0) {
+                oakum.updatePeakSnapshot();
+            }
         }
     }
 
@@ -96,7 +241,6 @@ void OakumController::deallocateMemory(void *pointer) {
     if (isInitialized()) {
         OakumController &oakum = *getInstance();
         if (!oakum.getIgnoreState()) {
-            const auto lock = oakum.getAllocationsLock();
             oakum.registerDeallocation(pointer);
         }
     }
@@ -104,87 +248,949 @@ void OakumController::deallocateMemory(void *pointer) {
     ::free(pointer);
 }
 
-void OakumController::OakumController::registerAllocation(OakumAllocation info) {
-    info.allocationId = this->allocationIdCounter++;
-    StackTraceHelper::initializeFrames(info.stackFrames, info.stackFramesCount);
+void OakumController::OakumController::registerAllocation(OakumAllocation info, void *callerAddress) {
+    // Ignore rules are matched against the caller first, so allocations made directly by ignored code never walk the stack
+    const IgnoreRanges *currentIgnoreRanges = this->ignoreRanges.load(std::memory_order_acquire);
+    if (currentIgnoreRanges != nullptr && StackTraceHelper::isAnyFrameInRanges(&callerAddress, 1u, currentIgnoreRanges->ranges)) {
+        return;
+    }
+    // Frames are stored relative to their modules, so they keep pointing into the right module after it is unloaded
+    void *relativeCallerAddress = callerAddress;
     if (capabilities.supportStackTraces) {
-        StackTraceHelper::captureFrames(info.stackFrames, info.stackFramesCount);
+        modules.refreshIfChanged();
+        modules.getRelativeAddresses(&callerAddress, 1u, &relativeCallerAddress);
+    }
+    // In adaptive mode call sites start with the caller address only and switch to full stack traces once escalated
+    CallSiteTable::CallSite *callSite = callSites != nullptr ? &callSites->getCallSite(relativeCallerAddress) : nullptr;
+    const bool callSiteEscalated = callSite != nullptr && callSite->escalated.load(std::memory_order_relaxed);
+    const bool captureFullStackTrace = capabilities.supportStackTraces && (stackTraceMode == OAKUM_STACK_TRACE_MODE_FULL || callSiteEscalated);
+    // Deeper frames are needed to match ignore rules, even if they are not going to be stored
+    const bool matchIgnoreRulesInStack = currentIgnoreRanges != nullptr && ignoreRulesFramesCount > 1;
+    void **frames = nullptr;
+    size_t framesCount = 0u;
+    if (captureFullStackTrace || matchIgnoreRulesInStack) {
+        const size_t capturedFramesCount = std::max(captureFullStackTrace ? maxStackFramesCount : size_t{0}, matchIgnoreRulesInStack ? ignoreRulesFramesCount : size_t{0});
+        StackTraceHelper::captureFrames(capturedFramesCount, frames, framesCount);
     }
+    if (matchIgnoreRulesInStack && StackTraceHelper::isAnyFrameInRanges(frames, std::min(framesCount, ignoreRulesFramesCount), currentIgnoreRanges->ranges)) {
+        return;
+    }
+    framesCount = std::min(framesCount, maxStackFramesCount);
+    info.allocationId = this->allocationIdCounter++;
 
-    FATAL_ERROR_IF(this->allocations.find(info.pointer) != this->allocations.end(), "Pointer already registered");
+    AllocationRecord record{info};
+    record.callerAddress = relativeCallerAddress;
+    if (threadRegistry != nullptr) {
+        record.thread = &getRegisteredThread();
+        record.thread->liveAllocationsCount.fetch_add(1, std::memory_order_relaxed);
+        record.thread->liveBytes.fetch_add(info.size, std::memory_order_relaxed);
+        record.thread->totalAllocationsCount.fetch_add(1, std::memory_order_relaxed);
+        record.info.threadId = record.thread->id;
+    }
+    if (callSite != nullptr) {
+        callSites->onAllocation(*callSite, info.size);
+        record.callSite = callSite;
+        record.info.stackFramesCount = 1;
+        if (callSites->hasHistograms()) {
+            record.allocationTimeNs = getTimeNs();
+        }
+    }
+    ThreadCache *const ownCache = getThreadCache();
+    if (captureFullStackTrace && framesCount > 0) {
+        if (ownCache != nullptr) {
+            RaiiOakumIgnore raiiIgnore{};
+            record.stackFrames = ownCache->stackFramePool.allocate(framesCount);
+            modules.getRelativeAddresses(frames, framesCount, record.stackFrames);
+            record.info.stackFramesCount = framesCount;
+        } else {
+            record.info.stackFramesCount = 1; // thread is exiting and has no pool anymore, so only the caller is stored
+        }
+    }
+    if (backgroundSymbolizer != nullptr && record.info.stackFramesCount > 0) {
+        backgroundSymbolizer->onStack(record.stackFrames != nullptr ? record.stackFrames : &record.callerAddress, record.info.stackFramesCount);
+    }
+    if (const std::vector<Scope *> &currentScopes = getScopeStack(); !currentScopes.empty()) {
+        record.scope = currentScopes.back();
+        record.info.scopeName = record.scope->name.c_str();
+        record.scope->liveAllocationsCount++;
+    }
+    statistics.onAllocation(info.size);
+    if (traceWriter != nullptr) {
+        traceWriter->onAllocation(info.allocationId, info.size, record.info.scopeName, statistics.getLiveBytes());
+    }
+
+    if (ThreadCache *cache = ownCache; threadCacheSize > 0 && cache != nullptr) {
+        {
+            const auto cacheLock = lockIfThreadSafe(cache->lock);
+            const size_t slot = cache->getSlot(cache->usedSlotsCount++);
+            cache->allocations[slot] = record;
+            {
+                RaiiOakumIgnore raiiIgnore{};
+                cachedPointers.add(record.info.pointer, {cache, slot});
+            }
+            if (cache->usedSlotsCount <= threadCacheSize) {
+                return;
+            }
+        }
+
+        // The oldest allocation in the cache survived long enough, move it to the shared registry. Locks have to be taken in
+        // the same order as in flushThreadCaches, hence the cache lock is released and acquired again.
+        const auto lock = getAllocationsLock();
+        const auto cacheLock = lockIfThreadSafe(cache->lock);
+        if (cache->usedSlotsCount <= threadCacheSize) {
+            return; // Another thread has flushed the cache in the meantime
+        }
+        const AllocationRecord &oldestRecord = cache->allocations[cache->oldestSlot];
+        cachedPointers.remove(oldestRecord.info.pointer);
+        FATAL_ERROR_IF(this->allocations.find(oldestRecord.info.pointer) != this->allocations.end(), "Pointer already registered");
+        {
+            RaiiOakumIgnore raiiIgnore{};
+            this->allocations.insert({oldestRecord.info.pointer, oldestRecord});
+        }
+        releaseOldestSlot(*cache);
+        return;
+    }
+
+    const auto lock = getAllocationsLock();
+    FATAL_ERROR_IF(this->allocations.find(record.info.pointer) != this->allocations.end(), "Pointer already registered");
 
     RaiiOakumIgnore raiiIgnore{};
-    this->allocations.insert({info.pointer, info});
+    this->allocations.insert({record.info.pointer, record});
 }
 
 void OakumController::OakumController::registerDeallocation(void *pointer) {
     FATAL_ERROR_IF(pointer == nullptr, "Null pointer registration");
 
+    // Stack frames are returned to the pool of the current thread, so it has to exist before any lock is taken
+    ThreadCache *const ownCache = getThreadCache();
+
+    // Short-lived allocations are usually retired in a cache, without touching the shared registry
+    if (threadCacheSize > 0 && registerDeallocationInThreadCache(pointer, ownCache)) {
+        return;
+    }
+
+    // Memory missing in the registry is not tracked, e.g. it was allocated before initialization or in ignore mode
+    const auto lock = getAllocationsLock();
     auto allocation = this->allocations.find(pointer);
     if (allocation != this->allocations.end()) {
+        retireAllocation(allocation->second, ownCache);
         RaiiOakumIgnore raiiIgnore{};
         this->allocations.erase(allocation);
     }
 }
 
+void OakumController::retireAllocation(const AllocationRecord &record, ThreadCache *ownCache) {
+    statistics.onDeallocation(record.info.size);
+    if (traceWriter != nullptr) {
+        traceWriter->onDeallocation(record.info.allocationId, record.info.size, record.info.scopeName, statistics.getLiveBytes());
+    }
+    if (record.scope != nullptr) {
+        record.scope->liveAllocationsCount--;
+    }
+    if (record.thread != nullptr) {
+        record.thread->liveAllocationsCount.fetch_sub(1, std::memory_order_relaxed);
+        record.thread->liveBytes.fetch_sub(record.info.size, std::memory_order_relaxed);
+    }
+    if (record.callSite != nullptr) {
+        CallSiteTable::onDeallocation(*record.callSite, record.info.size);
+        if (callSites->hasHistograms()) {
+            callSites->onRetirement(*record.callSite, record.info.size, getTimeNs() - record.allocationTimeNs);
+        }
+    }
+    // Slots freed by an exiting thread, which has no pool anymore, are reclaimed with the whole store on deinitialization
+    if (record.stackFrames != nullptr && ownCache != nullptr) {
+        ownCache->stackFramePool.free(record.stackFrames, record.info.stackFramesCount);
+    }
+}
+
+bool OakumController::registerDeallocationInThreadCache(void *pointer, ThreadCache *ownCache) {
+    CachedPointers::Location location{};
+    if (!cachedPointers.take(pointer, location)) {
+        return false;
+    }
+
+    // Allocation could have been moved to the registry in the meantime, in which case the caller searches for it there
+    ThreadCache &cache = *location.owner;
+    const auto cacheLock = lockIfThreadSafe(cache.lock);
+    AllocationRecord &record = cache.allocations[location.slot];
+    if (record.info.pointer != pointer) {
+        return false;
+    }
+    retireAllocation(record, ownCache);
+    record.info.pointer = nullptr;
+    if (location.slot == cache.oldestSlot) {
+        releaseOldestSlot(cache);
+    }
+    return true;
+}
+
+void OakumController::releaseOldestSlot(ThreadCache &cache) {
+    // Must be called with cache lock held. Empty slots following the oldest one are released as well.
+    do {
+        cache.allocations[cache.oldestSlot].info.pointer = nullptr;
+        cache.oldestSlot = cache.getSlot(1);
+        cache.usedSlotsCount--;
+    } while (cache.usedSlotsCount > 0 && cache.allocations[cache.oldestSlot].info.pointer == nullptr);
+}
+
+OakumController::ThreadCache *OakumController::getThreadCache() {
+    // Cache pointer is thread local, so it could have been created for a previous instance of the controller
+    if (threadCacheGeneration != generation) {
+        if (threadExited) {
+            return nullptr; // cache has already been released, but destructors of other thread locals can still allocate
+        }
+
+        RaiiOakumIgnore raiiIgnore{};
+        {
+            const auto cachesLock = lockIfThreadSafe(threadCachesLock);
+            if (!unusedThreadCaches.empty()) {
+                threadCache = unusedThreadCaches.back();
+                unusedThreadCaches.pop_back();
+            } else {
+                auto cache = std::make_unique<ThreadCache>(stackFrameStore, maxStackFramesCount, threadCacheSize);
+                threadCache = cache.get();
+                threadCaches.push_back(std::move(cache));
+            }
+            threadCacheGeneration = generation;
+        }
+        threadExitHandler.constructed = true;
+    }
+    return threadCache;
+}
+
+OakumController::ThreadExitHandler::~ThreadExitHandler() {
+    threadExited = true;
+    if (isInitialized()) {
+        getInstance()->onThreadExit();
+    }
+}
+
+void OakumController::onThreadExit() {
+    // Kernel reuses ids of exited threads, so names must not be read for them anymore. Thread stays registered, because
+    // memory allocated by it may still be live.
+    if (registeredThreadGeneration == generation) {
+        ThreadRegistry::markExited(*registeredThread);
+    }
+
+    // Allocations of an exited thread are moved to the registry and its cache is reused by the next new thread, so the
+    // number of caches is bounded by the number of threads running at the same time. Free stack frame slots are shared.
+    if (threadCacheGeneration == generation) {
+        threadCache->stackFramePool.releaseFreeSlots();
+        const auto lock = getAllocationsLock();
+        const auto cachesLock = lockIfThreadSafe(threadCachesLock);
+        RaiiOakumIgnore raiiIgnore{};
+        flushThreadCache(*threadCache);
+        unusedThreadCaches.push_back(threadCache);
+        threadCacheGeneration = 0;
+    }
+}
+
+ThreadRegistry::Thread &OakumController::getRegisteredThread() {
+    // Thread pointer is thread local, so it could have been registered in a previous instance of the controller
+    if (registeredThreadGeneration != generation) {
+        registeredThread = &threadRegistry->registerCurrentThread();
+        registeredThreadGeneration = generation;
+        threadExitHandler.constructed = true;
+    }
+    return *registeredThread;
+}
+
+void OakumController::flushThreadCache(ThreadCache &cache) {
+    // Must be called with allocations lock and caches lock held
+    const auto cacheLock = lockIfThreadSafe(cache.lock);
+    RaiiOakumIgnore raiiIgnore{};
+    for (size_t position = 0; position < cache.usedSlotsCount; position++) {
+        AllocationRecord &record = cache.allocations[cache.getSlot(position)];
+        if (record.info.pointer != nullptr) {
+            cachedPointers.remove(record.info.pointer);
+            this->allocations.insert({record.info.pointer, record});
+            record.info.pointer = nullptr;
+        }
+    }
+    cache.oldestSlot = 0;
+    cache.usedSlotsCount = 0;
+}
+
+void OakumController::flushThreadCaches() {
+    // Must be called with allocations lock held
+    if (threadCacheSize == 0) {
+        return; // caches hold only stack frame pools
+    }
+    const auto cachesLock = lockIfThreadSafe(threadCachesLock);
+    for (auto &cache : threadCaches) {
+        flushThreadCache(*cache);
+    }
+}
+
+void OakumController::getThreadStatistics(OakumThreadStatistics *outThreads, size_t &inOutThreadsCount) {
+    threadRegistry->refreshNames();
+
+    size_t threadsCount = 0u;
+    threadRegistry->forEachThread([&](const ThreadRegistry::Thread &thread) {
+        if (outThreads == nullptr) {
+            threadsCount++;
+            return;
+        }
+        if (threadsCount == inOutThreadsCount) {
+            return;
+        }
+
+        OakumThreadStatistics &outThread = outThreads[threadsCount++];
+        outThread.threadId = thread.id;
+        outThread.threadName = thread.name.load(std::memory_order_relaxed);
+        outThread.liveAllocationsCount = thread.liveAllocationsCount.load(std::memory_order_relaxed);
+        outThread.liveBytes = thread.liveBytes.load(std::memory_order_relaxed);
+        outThread.totalAllocationsCount = thread.totalAllocationsCount.load(std::memory_order_relaxed);
+    });
+    inOutThreadsCount = threadsCount;
+}
+
 void OakumController::getAllocations(OakumAllocation *&outAllocations, size_t &outAllocationsCount) {
     const auto lock = getAllocationsLock();
+    flushThreadCaches();
+    if (threadRegistry != nullptr) {
+        threadRegistry->refreshNames();
+    }
 
     outAllocationsCount = this->allocations.size();
-    if (outAllocationsCount > 0) {
-        outAllocations = new OakumAllocation[outAllocationsCount];
+    outAllocations = nullptr;
+    if (outAllocationsCount == 0) {
+        return;
+    }
 
-        size_t dstIndex = 0u;
-        for (auto srcIterator = this->allocations.begin(); srcIterator != this->allocations.end(); srcIterator++) {
-            if (srcIterator->first == outAllocations) {
-                continue; // We allocated storage for OakumAllocations and we have to skip it here
-            }
+    // Allocations array is tracked, so an unreleased report is a leak. Frames and strings are owned by the report arena
+    // and released together with the array, so they are not tracked.
+    outAllocations = new OakumAllocation[outAllocationsCount];
+    RaiiOakumIgnore raiiIgnore{};
+    auto arena = std::make_unique<ReportArena>();
+    size_t dstIndex = 0u;
+    for (const auto &[pointer, record] : this->allocations) {
+        if (pointer == outAllocations) {
+            continue; // We allocated storage for OakumAllocations and we have to skip it here
+        }
 
-            outAllocations[dstIndex] = srcIterator->second;
-            dstIndex++;
+        OakumAllocation &allocation = outAllocations[dstIndex++];
+        allocation = record.info;
+        if (record.thread != nullptr) {
+            allocation.threadName = record.thread->name.load(std::memory_order_relaxed);
+        }
+        if (allocation.stackFramesCount > 0) {
+            allocation.stackFrames = arena->allocateArray<OakumStackFrame>(allocation.stackFramesCount);
+            void *const *frames = record.stackFrames != nullptr ? record.stackFrames : &record.callerAddress;
+            StackTraceHelper::setupFrames(allocation.stackFrames, frames, allocation.stackFramesCount);
         }
-        DEBUG_ERROR_IF(dstIndex != outAllocationsCount, "Allocations count mismatch");
-    } else {
-        outAllocations = nullptr;
     }
+    DEBUG_ERROR_IF(dstIndex != outAllocationsCount, "Allocations count mismatch");
 
     if (this->sortAllocations) {
         std::sort(outAllocations, outAllocations + outAllocationsCount, [](const OakumAllocation &left, const OakumAllocation &right) {
             return left.allocationId < right.allocationId;
         });
     }
+
+    // Frames are stored as module relative addresses, which are translated back only for reported allocations
+    if (this->capabilities.supportStackTraces) {
+        modules.refresh();
+        for (size_t allocationIndex = 0; allocationIndex < outAllocationsCount; allocationIndex++) {
+            OakumAllocation &allocation = outAllocations[allocationIndex];
+            StackTraceHelper::setupModules(allocation.stackFrames, allocation.stackFramesCount, modules);
+        }
+    }
+
+    std::lock_guard reportsLockGuard{reportsLock};
+    reports.push_back({outAllocations, outAllocationsCount, std::move(arena)});
 }
 
-void OakumController::releaseAllocations(OakumAllocation *allocationsToRelease, size_t allocationsCount) {
-    for (size_t allocationIndex = 0; allocationIndex < allocationsCount; allocationIndex++) {
-        OakumAllocation &allocation = allocationsToRelease[allocationIndex];
-        for (size_t stackFrameIndex = 0; stackFrameIndex < allocation.stackFramesCount; stackFrameIndex++) {
-            delete[] allocation.stackFrames[stackFrameIndex].symbolName;
-            delete[] allocation.stackFrames[stackFrameIndex].fileName;
+void OakumController::releaseAllocations(OakumAllocation *allocationsToRelease) {
+    {
+        std::lock_guard lockGuard{reportsLock};
+        auto report = std::find_if(reports.begin(), reports.end(), [&](const Report &report) {
+            return report.allocations == allocationsToRelease;
+        });
+        DEBUG_ERROR_IF(report == reports.end(), "Releasing allocations, which were not returned by getAllocations");
+        if (report == reports.end()) {
+            return;
         }
+
+        RaiiOakumIgnore raiiIgnore{};
+        *report = std::move(reports.back());
+        reports.pop_back();
     }
-    delete allocationsToRelease;
+    delete[] allocationsToRelease;
 }
 
-bool OakumController::hasAllocations() {
+ReportArena *OakumController::findReportArena(const OakumAllocation *allocations) {
+    // Users may pass a part of the report
+    std::lock_guard lockGuard{reportsLock};
+    for (const Report &report : reports) {
+        if (allocations >= report.allocations && allocations < report.allocations + report.allocationsCount) {
+            return report.arena.get();
+        }
+    }
+    return nullptr;
+}
+
+void OakumController::getModules(OakumModule *outModules, size_t &inOutModulesCount) {
+    modules.refresh();
+    modules.getModules(outModules, inOutModulesCount);
+}
+
+void OakumController::getCallSites(OakumCallSite *outCallSites, size_t &inOutCallSitesCount) {
+    modules.refresh();
+
+    size_t callSitesCount = 0u;
+    callSites->forEachCallSite([&](const CallSiteTable::CallSite &site) {
+        if (outCallSites == nullptr) {
+            callSitesCount++;
+            return;
+        }
+        if (callSitesCount == inOutCallSitesCount) {
+            return;
+        }
+
+        OakumCallSite &outCallSite = outCallSites[callSitesCount++];
+        outCallSite.address = reinterpret_cast<void *>(site.address.load(std::memory_order_relaxed));
+        if (!modules.resolveRelativeAddress(outCallSite.address, outCallSite.address, outCallSite.moduleIndex, outCallSite.moduleOffset)) {
+            outCallSite.moduleIndex = OAKUM_UNKNOWN_MODULE_INDEX;
+            outCallSite.moduleOffset = 0u;
+        }
+        outCallSite.liveAllocationsCount = site.liveAllocationsCount.load(std::memory_order_relaxed);
+        outCallSite.liveBytes = site.liveBytes.load(std::memory_order_relaxed);
+        outCallSite.totalAllocationsCount = site.totalAllocationsCount.load(std::memory_order_relaxed);
+        outCallSite.totalBytes = site.totalBytes.load(std::memory_order_relaxed);
+        outCallSite.escalated = site.escalated.load(std::memory_order_relaxed);
+    });
+    inOutCallSitesCount = callSitesCount;
+}
+
+void OakumController::getChurnCallSites(uint64_t maxLifetimeNs, OakumCallSiteHistograms *outCallSites, size_t &inOutCallSitesCount) {
+    RaiiOakumIgnore raiiIgnore{};
+    modules.refresh();
+
+    // Histograms are large, so only the counts are gathered for all sites and the histograms are copied for the returned ones
+    struct ChurnEntry {
+        const CallSiteTable::CallSite *site = nullptr;
+        uint64_t shortLivedAllocationsCount = 0;
+    };
+    std::vector<ChurnEntry> entries{};
+    callSites->forEachCallSite([&](const CallSiteTable::CallSite &site) {
+        const CallSiteTable::Histograms &histograms = callSites->getHistograms(site);
+        uint64_t shortLivedAllocationsCount = 0;
+        for (size_t bucketIndex = 0; bucketIndex + 1 < CallSiteTable::histogramBucketsCount; bucketIndex++) {
+            if ((uint64_t{2} << bucketIndex) > maxLifetimeNs) {
+                break;
+            }
+            shortLivedAllocationsCount += histograms.lifetimesNs[bucketIndex].load(std::memory_order_relaxed);
+        }
+        if (shortLivedAllocationsCount > 0) {
+            entries.push_back({&site, shortLivedAllocationsCount});
+        }
+    });
+    if (outCallSites == nullptr) {
+        inOutCallSitesCount = entries.size();
+        return;
+    }
+
+    inOutCallSitesCount = std::min(inOutCallSitesCount, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + inOutCallSitesCount, entries.end(), [](const ChurnEntry &left, const ChurnEntry &right) {
+        return left.shortLivedAllocationsCount > right.shortLivedAllocationsCount;
+    });
+    for (size_t entryIndex = 0; entryIndex < inOutCallSitesCount; entryIndex++) {
+        const ChurnEntry &entry = entries[entryIndex];
+        const CallSiteTable::Histograms &histograms = callSites->getHistograms(*entry.site);
+        OakumCallSiteHistograms &outCallSite = outCallSites[entryIndex];
+        outCallSite.address = reinterpret_cast<void *>(entry.site->address.load(std::memory_order_relaxed));
+        if (!modules.resolveRelativeAddress(outCallSite.address, outCallSite.address, outCallSite.moduleIndex, outCallSite.moduleOffset)) {
+            outCallSite.moduleIndex = OAKUM_UNKNOWN_MODULE_INDEX;
+            outCallSite.moduleOffset = 0u;
+        }
+        outCallSite.freedAllocationsCount = 0;
+        outCallSite.shortLivedAllocationsCount = entry.shortLivedAllocationsCount;
+        for (size_t bucketIndex = 0; bucketIndex < CallSiteTable::histogramBucketsCount; bucketIndex++) {
+            outCallSite.lifetimesNs[bucketIndex] = histograms.lifetimesNs[bucketIndex].load(std::memory_order_relaxed);
+            outCallSite.sizes[bucketIndex] = histograms.sizes[bucketIndex].load(std::memory_order_relaxed);
+            outCallSite.freedAllocationsCount += outCallSite.lifetimesNs[bucketIndex];
+        }
+    }
+}
+
+void OakumController::getGrowingCallSites(OakumGrowingCallSite *outCallSites, size_t &inOutCallSitesCount) {
+    RaiiOakumIgnore raiiIgnore{};
+    std::vector<TrendSampler::GrowingSite> growingSites = trendSampler->getGrowingSites();
+    if (outCallSites == nullptr) {
+        inOutCallSitesCount = growingSites.size();
+        return;
+    }
+
+    inOutCallSitesCount = std::min(inOutCallSitesCount, growingSites.size());
+    std::partial_sort(growingSites.begin(), growingSites.begin() + inOutCallSitesCount, growingSites.end(), [](const TrendSampler::GrowingSite &left, const TrendSampler::GrowingSite &right) {
+        return left.growthBytes > right.growthBytes;
+    });
+    modules.refresh();
+    for (size_t siteIndex = 0; siteIndex < inOutCallSitesCount; siteIndex++) {
+        const TrendSampler::GrowingSite &growingSite = growingSites[siteIndex];
+        OakumGrowingCallSite &outCallSite = outCallSites[siteIndex];
+        outCallSite.address = reinterpret_cast<void *>(growingSite.site->address.load(std::memory_order_relaxed));
+        if (!modules.resolveRelativeAddress(outCallSite.address, outCallSite.address, outCallSite.moduleIndex, outCallSite.moduleOffset)) {
+            outCallSite.moduleIndex = OAKUM_UNKNOWN_MODULE_INDEX;
+            outCallSite.moduleOffset = 0u;
+        }
+        outCallSite.liveBytes = static_cast<size_t>(growingSite.liveBytes);
+        outCallSite.growthBytes = static_cast<size_t>(growingSite.growthBytes);
+    }
+}
+
+void OakumController::collectProfile(Profile &outProfile) {
+    RaiiOakumIgnore raiiIgnore{};
+
+    std::map<std::vector<void *>, size_t> sampleIndices{};
+    {
+        const auto lock = getAllocationsLock();
+        flushThreadCaches();
+        aggregateLiveAllocations(sampleIndices, outProfile.samples);
+    }
+
+    // Live allocations are already reported per stack, so call sites contribute only cumulative values
+    if (callSites != nullptr) {
+        outProfile.hasTotals = true;
+        callSites->forEachCallSite([&](const CallSiteTable::CallSite &site) {
+            std::vector<void *> stack{reinterpret_cast<void *>(site.address.load(std::memory_order_relaxed))};
+            auto [sampleIndex, inserted] = sampleIndices.insert({std::move(stack), outProfile.samples.size()});
+            if (inserted) {
+                outProfile.samples.emplace_back();
+            }
+            Profile::Sample &sample = outProfile.samples[sampleIndex->second];
+            sample.totalAllocationsCount += site.totalAllocationsCount.load(std::memory_order_relaxed);
+            sample.totalBytes += site.totalBytes.load(std::memory_order_relaxed);
+        });
+    }
+
+    setupProfileFrames(sampleIndices, outProfile);
+}
+
+void OakumController::aggregateLiveAllocations(std::map<std::vector<void *>, size_t> &sampleIndices, std::vector<Profile::Sample> &samples) {
+    // Must be called with allocations lock held. Allocations with the same stack trace are aggregated into a single sample.
+    for (const auto &[pointer, record] : this->allocations) {
+        void *const *frames = record.stackFrames != nullptr ? record.stackFrames : &record.callerAddress;
+        std::vector<void *> stack(frames, frames + record.info.stackFramesCount);
+        auto [sampleIndex, inserted] = sampleIndices.insert({std::move(stack), samples.size()});
+        if (inserted) {
+            samples.emplace_back();
+        }
+        Profile::Sample &sample = samples[sampleIndex->second];
+        sample.liveAllocationsCount++;
+        sample.liveBytes += record.info.size;
+    }
+}
+
+void OakumController::setupProfileFrames(const std::map<std::vector<void *>, size_t> &sampleIndices, Profile &outProfile) {
+    // Each unique address becomes a single frame, so it is resolved only once
+    std::unordered_map<void *, size_t> frameIndices{};
+    std::vector<void *> addresses{};
+    for (const auto &[stack, sampleIndex] : sampleIndices) {
+        for (void *address : stack) {
+            auto [frameIndex, inserted] = frameIndices.insert({address, addresses.size()});
+            if (inserted) {
+                addresses.push_back(address);
+            }
+            outProfile.samples[sampleIndex].frameIndices.push_back(frameIndex->second);
+        }
+    }
+    outProfile.frames.resize(addresses.size());
+    StackTraceHelper::setupFrames(outProfile.frames.data(), addresses.data(), addresses.size());
+    modules.refresh();
+    StackTraceHelper::setupModules(outProfile.frames.data(), outProfile.frames.size(), modules);
+
+    // Unresolved frames are still written with their addresses, so fallback names are not used
+    if (capabilities.supportStackTracesSymbols) {
+        const BackgroundSymbolizer::RaiiPause pause{backgroundSymbolizer.get()};
+        std::lock_guard lockGuard{symbolizationLock};
+        StackTraceHelper::resolveSymbols(outProfile.frames.data(), outProfile.frames.size(), std::nullopt, symbolCache.get(), modules, outProfile.strings);
+        if (symbolCache != nullptr) {
+            symbolCache->flush();
+        }
+        outProfile.hasSymbols = true;
+    }
+}
+
+void OakumController::collectPeakProfile(Profile &outProfile) {
+    RaiiOakumIgnore raiiIgnore{};
+
+    std::map<std::vector<void *>, size_t> sampleIndices{};
+    {
+        const auto lock = lockIfThreadSafe(peakSnapshotLock);
+        sampleIndices = peakSnapshot.sampleIndices;
+        outProfile.samples = peakSnapshot.samples;
+    }
+    setupProfileFrames(sampleIndices, outProfile);
+}
+
+void OakumController::updatePeakSnapshot() {
+    // Live bytes are compared with the threshold on every allocation. The snapshot is captured only after they grow by the
+    // margin, so the cost of walking all live allocations is amortized over at least that many allocated bytes.
+    if (statistics.getLiveBytes() < nextPeakSnapshotLiveBytes.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    RaiiOakumIgnore raiiIgnore{};
     const auto lock = getAllocationsLock();
-    return this->allocations.size();
+    if (statistics.getLiveBytes() < nextPeakSnapshotLiveBytes.load(std::memory_order_relaxed)) {
+        return; // another thread has captured the snapshot in the meantime
+    }
+    flushThreadCaches();
+
+    PeakSnapshot snapshot{};
+    aggregateLiveAllocations(snapshot.sampleIndices, snapshot.samples);
+    for (const Profile::Sample &sample : snapshot.samples) {
+        snapshot.info.liveAllocationsCount += sample.liveAllocationsCount;
+        snapshot.info.liveBytes += sample.liveBytes;
+    }
+    snapshot.info.stacksCount = snapshot.samples.size();
+    snapshot.info.lastAllocationId = allocationIdCounter.load() - 1;
+    nextPeakSnapshotLiveBytes.store(snapshot.info.liveBytes + peakSnapshotMargin, std::memory_order_relaxed);
+
+    const auto snapshotLock = lockIfThreadSafe(peakSnapshotLock);
+    snapshot.info.capturesCount = peakSnapshot.info.capturesCount + 1;
+    std::swap(peakSnapshot, snapshot);
+}
+
+OakumPeakSnapshotInfo OakumController::getPeakSnapshotInfo() {
+    const auto lock = lockIfThreadSafe(peakSnapshotLock);
+    return peakSnapshot.info;
+}
+
+bool OakumController::writeProfile(OakumProfileFormat format, const char *filePath, bool peak) {
+    RaiiOakumIgnore raiiIgnore{};
+    std::ofstream file{filePath, std::ios::out | std::ios::binary | std::ios::trunc};
+    if (!file) {
+        return false;
+    }
+
+    Profile profile{};
+    if (peak) {
+        collectPeakProfile(profile);
+    } else {
+        collectProfile(profile);
+    }
+    switch (format) {
+    case OAKUM_PROFILE_FORMAT_PPROF:
+        PprofWriter::write(file, profile, modules);
+        break;
+    case OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES:
+        FoldedStackWriter::write(file, profile, modules, false);
+        break;
+    case OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES:
+        FoldedStackWriter::write(file, profile, modules, true);
+        break;
+    default:
+        DEBUG_ERROR("Unknown profile format");
+        return false;
+    }
+    file.close();
+    return !file.fail();
+}
+
+void OakumController::writeSignalReport() {
+    // Readers of the report must never see a partially written file
+    const std::string temporaryPath = reportFilePath.value() + ".tmp";
+    if (writeProfile(reportFormat, temporaryPath.c_str(), false)) {
+        std::rename(temporaryPath.c_str(), reportFilePath.value().c_str());
+    } else {
+        std::remove(temporaryPath.c_str());
+    }
+}
+
+void OakumController::answerQuery(std::string_view query, QueryServer::Response &response) {
+    const size_t commandEnd = std::min(query.find(' '), query.size());
+    const std::string_view command = query.substr(0, commandEnd);
+    const std::string_view argument = query.substr(std::min(commandEnd + 1, query.size()));
+    uint64_t numericArgument = 0;
+    const bool hasNumericArgument = !argument.empty() && std::from_chars(argument.data(), argument.data() + argument.size(), numericArgument).ec == std::errc{};
+
+    if (command == "stats") {
+        const OakumStatistics currentStatistics = statistics.get();
+        response << "liveAllocationsCount " << currentStatistics.liveAllocationsCount << "\n";
+        response << "liveBytes " << currentStatistics.liveBytes << "\n";
+        response << "peakLiveBytes " << currentStatistics.peakLiveBytes << "\n";
+        response << "totalAllocationsCount " << currentStatistics.totalAllocationsCount << "\n";
+        response << "totalDeallocationsCount " << currentStatistics.totalDeallocationsCount << "\n";
+        response << "failedNoThrowAllocationsCount " << currentStatistics.failedNoThrowAllocationsCount << "\n";
+    } else if (command == "top" && (argument.empty() || hasNumericArgument)) {
+        answerTopCallSitesQuery(hasNumericArgument ? static_cast<size_t>(numericArgument) : 10u, response);
+    } else if (command == "checkpoint" && argument.empty()) {
+        response << "checkpoint " << allocationIdCounter.load() << "\n";
+    } else if (command == "since" && hasNumericArgument) {
+        answerAllocationsQuery(numericArgument, response);
+    } else if (command == "report" && argument.empty()) {
+        answerAllocationsQuery(0u, response);
+    } else if (command == "threads" && argument.empty()) {
+        answerThreadsQuery(response);
+    } else {
+        response << "error: unknown query\n";
+        response << "queries: stats, top [count], checkpoint, since <checkpoint>, report, threads\n";
+    }
+}
+
+void OakumController::answerTopCallSitesQuery(size_t callSitesCount, QueryServer::Response &response) {
+    struct CallSiteEntry {
+        void *address = nullptr;
+        uint64_t liveAllocationsCount = 0;
+        uint64_t liveBytes = 0;
+    };
+    std::vector<CallSiteEntry> entries{};
+
+    // Call site table is maintained without locks. Otherwise live allocations have to be aggregated.
+    if (callSites != nullptr) {
+        callSites->forEachCallSite([&](const CallSiteTable::CallSite &site) {
+            entries.push_back({reinterpret_cast<void *>(site.address.load(std::memory_order_relaxed)),
+                               site.liveAllocationsCount.load(std::memory_order_relaxed),
+                               site.liveBytes.load(std::memory_order_relaxed)});
+        });
+    } else {
+        std::unordered_map<void *, size_t> entryIndices{};
+        const auto lock = getAllocationsLock();
+        flushThreadCaches();
+        for (const auto &[pointer, record] : this->allocations) {
+            auto [entryIndex, inserted] = entryIndices.insert({record.callerAddress, entries.size()});
+            if (inserted) {
+                entries.push_back({record.callerAddress});
+            }
+            entries[entryIndex->second].liveAllocationsCount++;
+            entries[entryIndex->second].liveBytes += record.info.size;
+        }
+    }
+
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](const CallSiteEntry &entry) { return entry.liveAllocationsCount == 0; }), entries.end());
+    callSitesCount = std::min(callSitesCount, entries.size());
+    std::partial_sort(entries.begin(), entries.begin() + callSitesCount, entries.end(), [](const CallSiteEntry &left, const CallSiteEntry &right) {
+        return left.liveBytes > right.liveBytes;
+    });
+
+    response << "liveBytes liveAllocationsCount callSite\n";
+    for (size_t entryIndex = 0; entryIndex < callSitesCount; entryIndex++) {
+        const CallSiteEntry &entry = entries[entryIndex];
+        response << entry.liveBytes << " " << entry.liveAllocationsCount << " ";
+        writeQueryFrames(&entry.address, 1u, "", response);
+    }
+}
+
+void OakumController::answerAllocationsQuery(OakumAllocationIdType minAllocationId, QueryServer::Response &response) {
+    // Ids and pointers of all listed allocations are collected under one lock and sorted, then details are copied one
+    // chunk at a time, so allocating threads are blocked only briefly. Rehashing between chunks does not matter, because
+    // records are looked up by pointer. A pointer freed and reused meanwhile has a different id and is skipped, so every
+    // allocation, which is live for the whole query, is listed exactly once. Frames have to be copied as well, because
+    // they are released together with the allocation.
+    constexpr size_t chunkAllocationsCount = 256;
+    std::vector<std::pair<OakumAllocationIdType, void *>> listedAllocations{};
+    {
+        const auto lock = getAllocationsLock();
+        flushThreadCaches();
+        listedAllocations.reserve(this->allocations.size());
+        for (const auto &[pointer, record] : this->allocations) {
+            if (record.info.allocationId >= minAllocationId) {
+                listedAllocations.emplace_back(record.info.allocationId, pointer);
+            }
+        }
+    }
+    std::sort(listedAllocations.begin(), listedAllocations.end());
+
+    std::vector<OakumAllocation> chunk{};
+    std::vector<void *> chunkFrames{};
+    for (size_t listedIndex = 0; listedIndex < listedAllocations.size() && !response.isDisconnected();) {
+        chunk.clear();
+        chunkFrames.clear();
+        {
+            const auto lock = getAllocationsLock();
+            const size_t chunkEnd = std::min(listedIndex + chunkAllocationsCount, listedAllocations.size());
+            for (; listedIndex < chunkEnd; listedIndex++) {
+                const auto [allocationId, pointer] = listedAllocations[listedIndex];
+                const auto entry = this->allocations.find(pointer);
+                if (entry == this->allocations.end() || entry->second.info.allocationId != allocationId) {
+                    continue;
+                }
+                const AllocationRecord &record = entry->second;
+                void *const *frames = record.stackFrames != nullptr ? record.stackFrames : &record.callerAddress;
+                chunk.push_back(record.info);
+                chunkFrames.insert(chunkFrames.end(), frames, frames + record.info.stackFramesCount);
+            }
+        }
+
+        size_t frameIndex = 0;
+        for (const OakumAllocation &allocation : chunk) {
+            response << "allocation " << allocation.allocationId << " size " << allocation.size << " pointer " << allocation.pointer;
+            if (allocation.scopeName != nullptr) {
+                response << " scope " << allocation.scopeName;
+            }
+            if (allocation.threadId != 0) {
+                response << " thread " << allocation.threadId;
+            }
+            response << "\n";
+            writeQueryFrames(chunkFrames.data() + frameIndex, allocation.stackFramesCount, "    ", response);
+            frameIndex += allocation.stackFramesCount;
+        }
+    }
+}
+
+void OakumController::answerThreadsQuery(QueryServer::Response &response) {
+    if (threadRegistry == nullptr) {
+        response << "error: threads are not tracked\n";
+        return;
+    }
+
+    // Threads are copied first, so a slow client does not block registration of new threads
+    size_t threadsCount = 0u;
+    getThreadStatistics(nullptr, threadsCount);
+    std::vector<OakumThreadStatistics> threads(threadsCount);
+    getThreadStatistics(threads.data(), threadsCount);
+    threads.resize(threadsCount);
+
+    response << "liveBytes liveAllocationsCount totalAllocationsCount thread name\n";
+    for (const OakumThreadStatistics &thread : threads) {
+        response << thread.liveBytes << " " << thread.liveAllocationsCount << " " << thread.totalAllocationsCount << " " << thread.threadId << " " << thread.threadName << "\n";
+    }
+}
+
+void OakumController::writeQueryFrames(void *const *addresses, size_t addressesCount, const char *indent, QueryServer::Response &response) {
+    if (addressesCount == 0) {
+        return;
+    }
+
+    ReportArena strings{};
+    std::vector<OakumStackFrame> frames(addressesCount);
+    StackTraceHelper::setupFrames(frames.data(), addresses, addressesCount);
+    modules.refresh();
+    StackTraceHelper::setupModules(frames.data(), addressesCount, modules);
+    if (capabilities.supportStackTracesSymbols) {
+        const BackgroundSymbolizer::RaiiPause pause{backgroundSymbolizer.get()};
+        std::lock_guard lockGuard{symbolizationLock};
+        StackTraceHelper::resolveSymbols(frames.data(), addressesCount, std::nullopt, symbolCache.get(), modules, strings);
+    }
+
+    for (const OakumStackFrame &frame : frames) {
+        response << indent << frame.address;
+        if (const ModuleRegistry::Module *module = modules.getModule(frame.moduleIndex); module != nullptr) {
+            response << " " << module->path << "+" << reinterpret_cast<const void *>(frame.moduleOffset);
+        }
+        if (frame.symbolName != nullptr) {
+            response << " " << frame.symbolName;
+        }
+        response << "\n";
+    }
+}
+
+void OakumController::fillSharedStatistics(OakumSharedStatistics &outStatistics) {
+    const OakumStatistics currentStatistics = statistics.get();
+    outStatistics.liveAllocationsCount = currentStatistics.liveAllocationsCount;
+    outStatistics.liveBytes = currentStatistics.liveBytes;
+    outStatistics.peakLiveBytes = currentStatistics.peakLiveBytes;
+    outStatistics.totalAllocationsCount = currentStatistics.totalAllocationsCount;
+    outStatistics.totalDeallocationsCount = currentStatistics.totalDeallocationsCount;
+    outStatistics.failedNoThrowAllocationsCount = currentStatistics.failedNoThrowAllocationsCount;
+
+    // Aggregating live allocations would block allocating threads on every update, so only the lock-free call site table is used
+    if (callSites == nullptr) {
+        return;
+    }
+    OakumSharedCallSite *topCallSites = outStatistics.topCallSites;
+    uint64_t &topCallSitesCount = outStatistics.topCallSitesCount;
+    callSites->forEachCallSite([&](const CallSiteTable::CallSite &site) {
+        const OakumSharedCallSite callSite{
+            static_cast<uint64_t>(site.address.load(std::memory_order_relaxed)),
+            site.liveAllocationsCount.load(std::memory_order_relaxed),
+            site.liveBytes.load(std::memory_order_relaxed),
+            site.totalAllocationsCount.load(std::memory_order_relaxed),
+        };
+        if (callSite.liveAllocationsCount == 0) {
+            return;
+        }
+
+        // Insertion into a short sorted array is cheaper than sorting all sites
+        uint64_t insertIndex = topCallSitesCount;
+        while (insertIndex > 0 && topCallSites[insertIndex - 1].liveBytes < callSite.liveBytes) {
+            insertIndex--;
+        }
+        if (insertIndex == OAKUM_SHARED_STATISTICS_TOP_CALL_SITES_COUNT) {
+            return;
+        }
+        if (topCallSitesCount < OAKUM_SHARED_STATISTICS_TOP_CALL_SITES_COUNT) {
+            topCallSitesCount++;
+        }
+        std::copy_backward(topCallSites + insertIndex, topCallSites + topCallSitesCount - 1, topCallSites + topCallSitesCount);
+        topCallSites[insertIndex] = callSite;
+    });
+}
+
+bool OakumController::hasAllocations() {
+    return statistics.getLiveAllocationsCount() > 0;
 }
 
-bool OakumController::resolveStackTraceSymbols(OakumAllocation &allocation) {
+bool OakumController::resolveStackTraceSymbols(OakumAllocation *allocations, size_t allocationsCount) {
     DEBUG_ERROR_IF(!this->capabilities.supportStackTraces, "resolveStackTraceSymbols even if stack trace tracking is disabled");
-    if (allocation.stackFramesCount != 0 && allocation.stackFrames[0].symbolName == nullptr) {
-        return StackTraceHelper::resolveSymbols(allocation.stackFrames, allocation.stackFramesCount, fallbackSymbolName);
+    if (allocationsCount == 0) {
+        return true;
     }
-    return true;
+    ReportArena *strings = findReportArena(allocations);
+    DEBUG_ERROR_IF(strings == nullptr, "Resolving allocations, which were not returned by getAllocations");
+    if (strings == nullptr) {
+        return false;
+    }
+
+    const BackgroundSymbolizer::RaiiPause pause{backgroundSymbolizer.get()};
+    std::lock_guard lockGuard{symbolizationLock};
+    bool result = true;
+    for (size_t allocationIndex = 0; allocationIndex < allocationsCount && result; allocationIndex++) {
+        OakumAllocation &allocation = allocations[allocationIndex];
+        if (allocation.stackFramesCount != 0 && allocation.stackFrames[0].symbolName == nullptr) {
+            result = StackTraceHelper::resolveSymbols(allocation.stackFrames, allocation.stackFramesCount, fallbackSymbolName, symbolCache.get(), modules, *strings);
+        }
+    }
+    if (symbolCache != nullptr) {
+        symbolCache->flush();
+    }
+    return result;
 }
 
-bool OakumController::resolveStackTraceSourceLocations(OakumAllocation &allocation) {
+bool OakumController::resolveStackTraceSourceLocations(OakumAllocation *allocations, size_t allocationsCount) {
     DEBUG_ERROR_IF(!this->capabilities.supportStackTraces, "resolveStackTraceSourceLocations even if stack trace tracking is disabled");
-    if (allocation.stackFramesCount != 0 && allocation.stackFrames[0].fileName == nullptr) {
-        return StackTraceHelper::resolveSourceLocations(allocation.stackFrames, allocation.stackFramesCount, fallbackSourceFileName);
+    if (allocationsCount == 0) {
+        return true;
+    }
+    ReportArena *strings = findReportArena(allocations);
+    DEBUG_ERROR_IF(strings == nullptr, "Resolving allocations, which were not returned by getAllocations");
+    if (strings == nullptr) {
+        return false;
+    }
+
+    const BackgroundSymbolizer::RaiiPause pause{backgroundSymbolizer.get()};
+    std::lock_guard lockGuard{symbolizationLock};
+    bool result = true;
+    for (size_t allocationIndex = 0; allocationIndex < allocationsCount && result; allocationIndex++) {
+        OakumAllocation &allocation = allocations[allocationIndex];
+        if (allocation.stackFramesCount != 0 && allocation.stackFrames[0].fileName == nullptr) {
+            result = StackTraceHelper::resolveSourceLocations(allocation.stackFrames, allocation.stackFramesCount, fallbackSourceFileName, symbolCache.get(), modules, *strings);
+        }
+    }
+    if (symbolCache != nullptr) {
+        symbolCache->flush();
+    }
+    return result;
+}
+
+void OakumController::preResolveAddress(void *address) {
+    // Resolved strings are not needed, only the cache is filled. Fallbacks are not used, so failures are cached as such.
+    ReportArena strings{};
+    OakumStackFrame frame{};
+    StackTraceHelper::setupFrames(&frame, &address, 1u);
+    modules.refresh();
+    StackTraceHelper::setupModules(&frame, 1u, modules);
+
+    // This runs on a low priority thread, so the lock is held only to access the cache
+    if (capabilities.supportStackTracesSymbols) {
+        StackTraceHelper::resolveSymbols(&frame, 1u, std::nullopt, symbolCache.get(), modules, strings, &symbolizationLock);
+    }
+    if (capabilities.supportStackTracesSourceLocations) {
+        StackTraceHelper::resolveSourceLocations(&frame, 1u, std::nullopt, symbolCache.get(), modules, strings, &symbolizationLock);
     }
-    return true;
 }
 
 void OakumController::incrementIgnoreRefcount() {
@@ -195,12 +1201,128 @@ bool OakumController::decrementIgnoreRefcount() {
     if (ignoreRefcount == 0) {
         return false;
     }
+    if (ignoreRefcount == 1 && ownIgnoreToken != 0) {
+        // Threads, which adopted the token of this region, stop ignoring with it
+        ignoreRegions.release(ownIgnoreToken);
+        ownIgnoreToken = 0;
+    }
     ignoreRefcount--;
     return true;
 }
 
+void OakumController::beginScope(const char *name) {
+    RaiiOakumIgnore raiiIgnore{};
+
+    Scope *scope = {};
+    {
+        const auto lock = lockIfThreadSafe(scopesLock);
+        std::unique_ptr<Scope> &scopeEntry = scopes[name];
+        if (scopeEntry == nullptr) {
+            scopeEntry = std::make_unique<Scope>();
+            scopeEntry->name = name;
+        }
+        scope = scopeEntry.get();
+    }
+
+    getScopeStack().push_back(scope);
+    if (traceWriter != nullptr) {
+        traceWriter->onBeginScope(scope->name.c_str());
+    }
+}
+
+bool OakumController::endScope() {
+    std::vector<Scope *> &currentScopes = getScopeStack();
+    if (currentScopes.empty()) {
+        return false;
+    }
+    if (traceWriter != nullptr) {
+        traceWriter->onEndScope(currentScopes.back()->name.c_str());
+    }
+    currentScopes.pop_back();
+    return true;
+}
+
+bool OakumController::hasScopeAllocations(const char *name) {
+    const auto lock = lockIfThreadSafe(scopesLock);
+    RaiiOakumIgnore raiiIgnore{};
+    auto scope = scopes.find(name);
+    return scope != scopes.end() && scope->second->liveAllocationsCount > 0;
+}
+
+std::vector<OakumController::Scope *> &OakumController::getScopeStack() {
+    // Scope stack is thread local, so it could have been filled for a previous instance of the controller
+    if (scopeStackGeneration != generation) {
+        scopeStack.clear();
+        scopeStackGeneration = generation;
+    }
+    return scopeStack;
+}
+
+OakumIgnoreToken OakumController::getIgnoreToken() {
+    if (ignoreRefcount == 0) {
+        return getIgnoreState() ? adoptedIgnoreToken : 0;
+    }
+
+    // The token may still belong to a region from before reinitialization
+    if (!ignoreRegions.isActive(ownIgnoreToken)) {
+        ownIgnoreToken = ignoreRegions.claim();
+    }
+    return ownIgnoreToken;
+}
+
+bool OakumController::setIgnoreToken(OakumIgnoreToken token) {
+    if (token != 0 && !ignoreRegions.isIssued(token)) {
+        return false;
+    }
+    adoptedIgnoreToken = token;
+    return true;
+}
+
+bool OakumController::addIgnoreRule(const OakumIgnoreRule &rule) {
+    RaiiOakumIgnore raiiIgnore{};
+
+    // Resolve the rule to address ranges once, so it can be quickly matched against captured stack frames
+    std::vector<StackTraceHelper::AddressRange> newRanges = {};
+    switch (rule.type) {
+    case OAKUM_IGNORE_RULE_MODULE:
+        if (!StackTraceHelper::getModuleAddressRanges(rule.moduleName, newRanges)) {
+            return false;
+        }
+        break;
+    case OAKUM_IGNORE_RULE_ADDRESS_RANGE:
+        newRanges.push_back({reinterpret_cast<uintptr_t>(rule.addressBegin), reinterpret_cast<uintptr_t>(rule.addressEnd)});
+        break;
+    default:
+        DEBUG_ERROR("Invalid ignore rule type");
+        return false;
+    }
+
+    const auto lock = lockIfThreadSafe(ignoreRulesLock);
+    auto snapshot = std::make_unique<IgnoreRanges>();
+    if (const IgnoreRanges *currentIgnoreRanges = this->ignoreRanges.load(); currentIgnoreRanges != nullptr) {
+        snapshot->ranges = currentIgnoreRanges->ranges;
+    }
+    snapshot->ranges.insert(snapshot->ranges.end(), newRanges.begin(), newRanges.end());
+
+    // Sort and merge overlapping ranges, so a single binary search is enough to match an address
+    std::sort(snapshot->ranges.begin(), snapshot->ranges.end());
+    std::vector<StackTraceHelper::AddressRange> mergedRanges = {};
+    for (const StackTraceHelper::AddressRange &range : snapshot->ranges) {
+        if (!mergedRanges.empty() && range.first <= mergedRanges.back().second) {
+            mergedRanges.back().second = std::max(mergedRanges.back().second, range.second);
+        } else {
+            mergedRanges.push_back(range);
+        }
+    }
+    snapshot->ranges = std::move(mergedRanges);
+
+    this->ignoreRanges.store(snapshot.get(), std::memory_order_release);
+    ignoreRangesSnapshots.push_back(std::move(snapshot));
+    return true;
+}
+
 bool OakumController::getIgnoreState() {
-    return ignoreRefcount > 0;
+    return ignoreRefcount > 0 || (adoptedIgnoreToken != 0 && ignoreRegions.isActive(adoptedIgnoreToken));
 }
 
 } // namespace Oakum
@@ -1,51 +1,169 @@
 #pragma once
 
+#include "source/background_symbolizer.h"
+#include "source/call_site_table.h"
+#include "source/error.h"
+#include "source/ignore_regions.h"
 #include "source/include/oakum/oakum_api.h"
+#include "source/module_registry.h"
+#include "source/pointer_index.h"
+#include "source/profile.h"
+#include "source/query_server.h"
+#include "source/report_arena.h"
+#include "source/shared_statistics_publisher.h"
+#include "source/signal_reporter.h"
+#include "source/stack_frame_pool.h"
+#include "source/stack_trace.h"
+#include "source/statistics.h"
+#include "source/symbol_cache.h"
+#include "source/thread_registry.h"
+#include "source/thread_safety_policy.h"
+#include "source/trace_writer.h"
+#include "source/trend_sampler.h"
 
 #include <atomic>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Oakum {
 
 class OakumController {
 public:
-    static void initialize(const OakumInitArgs &initArgs);
+    static bool initialize(const OakumInitArgs &initArgs);
     static void deinitialize();
     static bool isInitialized();
     static OakumController *getInstance();
 
     const OakumCapabilities &getCapabilities() { return capabilities; }
 
-    static void *allocateMemory(std::size_t size, bool noThrow);
+    static void *allocateMemory(std::size_t size, bool noThrow, void *callerAddress);
     static void deallocateMemory(void *pointer);
 
     void getAllocations(OakumAllocation *&outAllocations, size_t &outAllocationsCount);
-    void releaseAllocations(OakumAllocation *allocationsToRelease, size_t allocationsCount);
+    void releaseAllocations(OakumAllocation *allocationsToRelease);
+    void getModules(OakumModule *outModules, size_t &inOutModulesCount);
+    bool hasCallSites() const { return callSites != nullptr; }
+    void getCallSites(OakumCallSite *outCallSites, size_t &inOutCallSitesCount);
+    bool hasLifetimes() const { return callSites != nullptr && callSites->hasHistograms(); }
+    void getChurnCallSites(uint64_t maxLifetimeNs, OakumCallSiteHistograms *outCallSites, size_t &inOutCallSitesCount);
+    bool hasTrendSampling() const { return trendSampler != nullptr; }
+    void getGrowingCallSites(OakumGrowingCallSite *outCallSites, size_t &inOutCallSitesCount);
     bool hasAllocations();
+    OakumStatistics getStatistics() { return statistics.get(); }
+    bool hasThreads() const { return threadRegistry != nullptr; }
+    void getThreadStatistics(OakumThreadStatistics *outThreads, size_t &inOutThreadsCount);
+    void collectProfile(Profile &outProfile);
+    void collectPeakProfile(Profile &outProfile);
+    bool writeProfile(OakumProfileFormat format, const char *filePath, bool peak);
+    bool hasPeakSnapshots() const { return peakSnapshotMargin != 0; }
+    OakumPeakSnapshotInfo getPeakSnapshotInfo();
 
-    bool resolveStackTraceSymbols(OakumAllocation &allocation);
-    bool resolveStackTraceSourceLocations(OakumAllocation &allocation);
+    bool resolveStackTraceSymbols(OakumAllocation *allocations, size_t allocationsCount);
+    bool resolveStackTraceSourceLocations(OakumAllocation *allocations, size_t allocationsCount);
 
     void incrementIgnoreRefcount();
     bool decrementIgnoreRefcount();
+    OakumIgnoreToken getIgnoreToken();
+    bool setIgnoreToken(OakumIgnoreToken token);
+    bool addIgnoreRule(const OakumIgnoreRule &rule);
+
+    void beginScope(const char *name);
+    bool endScope();
+    bool hasScopeAllocations(const char *name);
 
 protected:
     static OakumCapabilities createCapabilities(const OakumInitArgs &initArgs);
     static std::optional<std::string> createOptionalString(const char *str);
-    void registerAllocation(OakumAllocation info);
-    void registerDeallocation(void *pointer);
+    static std::unique_ptr<SymbolCache> createSymbolCache(const OakumInitArgs &initArgs);
+    static std::unique_ptr<CallSiteTable> createCallSiteTable(const OakumInitArgs &initArgs);
+    std::unique_ptr<TraceWriter> createTraceWriter(const OakumInitArgs &initArgs);
+    std::unique_ptr<BackgroundSymbolizer> createBackgroundSymbolizer(const OakumInitArgs &initArgs);
+    std::unique_ptr<SignalReporter> createSignalReporter(const OakumInitArgs &initArgs);
+    void aggregateLiveAllocations(std::map<std::vector<void *>, size_t> &sampleIndices, std::vector<Profile::Sample> &samples);
+    void setupProfileFrames(const std::map<std::vector<void *>, size_t> &sampleIndices, Profile &outProfile);
+    void updatePeakSnapshot();
+    void writeSignalReport();
+    std::unique_ptr<QueryServer> createQueryServer(const OakumInitArgs &initArgs);
+    void answerQuery(std::string_view query, QueryServer::Response &response);
+    void answerTopCallSitesQuery(size_t callSitesCount, QueryServer::Response &response);
+    void answerAllocationsQuery(OakumAllocationIdType minAllocationId, QueryServer::Response &response);
+    void answerThreadsQuery(QueryServer::Response &response);
+    void writeQueryFrames(void *const *addresses, size_t addressesCount, const char *indent, QueryServer::Response &response);
+    std::unique_ptr<SharedStatisticsPublisher> createSharedStatisticsPublisher(const OakumInitArgs &initArgs);
+    std::unique_ptr<TrendSampler> createTrendSampler(const OakumInitArgs &initArgs);
+    void fillSharedStatistics(OakumSharedStatistics &outStatistics);
+    ReportArena *findReportArena(const OakumAllocation *allocations);
+    void preResolveAddress(void *address);
     bool getIgnoreState();
 
-    auto getAllocationsLock() {
-        std::unique_lock lock{allocationsLock, std::defer_lock};
-        if (capabilities.threadSafe) {
-            lock.lock();
+    struct Scope {
+        std::string name = {};
+        std::atomic<size_t> liveAllocationsCount = 0;
+    };
+    struct AllocationRecord {
+        OakumAllocation info = {};
+        Scope *scope = nullptr;
+        void **stackFrames = nullptr; // info.stackFramesCount addresses stored in the stack frame pool
+        void *callerAddress = nullptr;
+        CallSiteTable::CallSite *callSite = nullptr;
+        uint64_t allocationTimeNs = 0; // set only if lifetimes are tracked
+        ThreadRegistry::Thread *thread = nullptr;
+    };
+    static size_t getMaxStackFramesCount(const OakumInitArgs &initArgs);
+    static uint64_t getTimeNs();
+    void registerAllocation(OakumAllocation info, void *callerAddress);
+    void registerDeallocation(void *pointer);
+    struct ThreadCache;
+    void retireAllocation(const AllocationRecord &record, ThreadCache *ownCache);
+    std::vector<Scope *> &getScopeStack();
+
+    // State of a single thread. Stack frame pool is used only by the owning thread, allocations are guarded by the lock.
+    // Allocations are kept in a ring buffer ordered from the oldest to the newest. Slots of freed allocations stay empty
+    // until the oldest slot reaches them, so an allocation is moved to the registry once the thread has made as many newer
+    // allocations as the cache size.
+    struct ThreadCache {
+        ThreadCache(StackFrameStore &stackFrameStore, size_t maxStackFramesCount, size_t threadCacheSize)
+            : allocations(threadCacheSize > 0 ? threadCacheSize + 1 : 0), stackFramePool(stackFrameStore, maxStackFramesCount) {}
+
+        size_t getSlot(size_t position) const {
+            const size_t slot = oldestSlot + position;
+            return slot < allocations.size() ? slot : slot - allocations.size();
         }
-        return lock;
+
+        std::mutex lock = {};
+        std::vector<AllocationRecord> allocations; // null pointer marks an empty slot
+        size_t oldestSlot = 0;                     // occupied, unless there are no used slots
+        size_t usedSlotsCount = 0;                 // including empty slots between the oldest and the newest allocation
+        StackFramePool stackFramePool;
+    };
+    // Locations of allocations held in thread caches, so memory freed by another thread finds its cache slot directly and
+    // memory, which is not tracked at all, is recognized without looking into any cache
+    using CachedPointers = PointerIndex<ThreadCache>;
+    // Constructed on the first use of per-thread state and destroyed on thread exit, so the state can be released
+    struct ThreadExitHandler {
+        bool constructed;
+        ~ThreadExitHandler();
+    };
+    ThreadCache *getThreadCache();
+    ThreadRegistry::Thread &getRegisteredThread();
+    bool registerDeallocationInThreadCache(void *pointer, ThreadCache *ownCache);
+    void releaseOldestSlot(ThreadCache &cache);
+    void flushThreadCache(ThreadCache &cache);
+    void flushThreadCaches();
+    void onThreadExit();
+
+    template <typename MutexT>
+    auto lockIfThreadSafe(MutexT &mutex) {
+        return ThreadSafety::lock(mutex, capabilities.threadSafe);
+    }
+
+    auto getAllocationsLock() {
+        return lockIfThreadSafe(allocationsLock);
     }
 
     OakumController(const OakumInitArgs &initArgs);
@@ -53,15 +171,97 @@ protected:
 private:
     static inline std::unique_ptr<OakumController> instance = {};
     static inline thread_local size_t ignoreRefcount = false;
+    static inline thread_local OakumIgnoreToken adoptedIgnoreToken = 0;
+    static inline thread_local OakumIgnoreToken ownIgnoreToken = 0; // handed out for the current ignore region of the thread
+    static inline thread_local ThreadCache *threadCache = nullptr;
+    static inline thread_local uint64_t threadCacheGeneration = 0;
+    static inline thread_local ThreadExitHandler threadExitHandler = {};
+    static inline thread_local bool threadExited = false;
+    static inline thread_local ThreadRegistry::Thread *registeredThread = nullptr;
+    static inline thread_local uint64_t registeredThreadGeneration = 0;
+    static inline thread_local std::vector<Scope *> scopeStack = {};
+    static inline thread_local uint64_t scopeStackGeneration = 0;
+    static inline std::atomic<uint64_t> generationCounter = 0;
 
     const OakumCapabilities capabilities;
     const std::optional<std::string> fallbackSymbolName = {};
     const std::optional<std::string> fallbackSourceFileName = {};
+    const std::unique_ptr<SymbolCache> symbolCache = {};
+    ModuleRegistry modules = {};
     const bool sortAllocations = {};
+    const size_t threadCacheSize = {};
+    const OakumStackTraceMode stackTraceMode = {};
+    const size_t maxStackFramesCount = {};
+    const size_t ignoreRulesFramesCount = {};
+    const std::unique_ptr<CallSiteTable> callSites = {};
+    const std::unique_ptr<TraceWriter> traceWriter = {};
+    const size_t peakSnapshotMargin = {};
+    const std::unique_ptr<ThreadRegistry> threadRegistry = {};
+    const uint64_t generation = {};
 
     std::atomic<OakumAllocationIdType> allocationIdCounter = 1;
+    StatisticsCounters statistics = {};
     std::recursive_mutex allocationsLock = {};
-    std::unordered_map<void *, OakumAllocation> allocations = {};
+    std::unordered_map<void *, AllocationRecord> allocations = {};
+    std::mutex threadCachesLock = {};
+    std::vector<std::unique_ptr<ThreadCache>> threadCaches = {};
+    std::vector<ThreadCache *> unusedThreadCaches = {}; // released by exited threads and handed to new ones
+    CachedPointers cachedPointers;
+    std::mutex scopesLock = {};
+    std::unordered_map<std::string, std::unique_ptr<Scope>> scopes = {};
+    StackFrameStore stackFrameStore;
+    IgnoreRegions ignoreRegions;
+
+    // Live allocations aggregated per stack trace at the highest live bytes seen so far. Captured with allocations lock held.
+    struct PeakSnapshot {
+        std::map<std::vector<void *>, size_t> sampleIndices = {};
+        std::vector<Profile::Sample> samples = {};
+        OakumPeakSnapshotInfo info = {};
+    };
+    std::atomic<size_t> nextPeakSnapshotLiveBytes = peakSnapshotMargin;
+    std::mutex peakSnapshotLock = {};
+    PeakSnapshot peakSnapshot = {};
+
+    // Reports returned by getAllocations, which have not been released yet. Each one owns all of its memory.
+    struct Report {
+        const OakumAllocation *allocations = nullptr;
+        size_t allocationsCount = 0;
+        std::unique_ptr<ReportArena> arena = {};
+    };
+    std::mutex reportsLock = {};
+    std::vector<Report> reports = {};
+
+    // Symbol cache returns pointers to its storage, so it is used by a single thread at a time. Background symbolizer
+    // takes the lock only to access the cache and is paused while reports are resolved. It is declared after the
+    // structures it uses, so its thread is stopped before they are destroyed.
+    std::mutex symbolizationLock = {};
+    const std::unique_ptr<BackgroundSymbolizer> backgroundSymbolizer;
+
+    // Reports requested with a signal or a query, published statistics and trends use all of the above, so their threads are declared last
+    const OakumProfileFormat reportFormat = {};
+    const std::optional<std::string> reportFilePath = {};
+    const std::unique_ptr<SignalReporter> signalReporter;
+    const std::unique_ptr<QueryServer> queryServer;
+    const std::unique_ptr<SharedStatisticsPublisher> sharedStatisticsPublisher;
+    const std::unique_ptr<TrendSampler> trendSampler;
+
+    // Ignore rules are read on every allocation without locking. Each modification publishes a new sorted snapshot.
+    // Previous snapshots are kept alive, because other threads may still be reading them.
+    struct IgnoreRanges {
+        std::vector<StackTraceHelper::AddressRange> ranges = {};
+    };
+    std::mutex ignoreRulesLock = {};
+    std::vector<std::unique_ptr<IgnoreRanges>> ignoreRangesSnapshots = {};
+    std::atomic<const IgnoreRanges *> ignoreRanges = nullptr;
+};
+
+struct RaiiOakumIgnore {
+    RaiiOakumIgnore() {
+        OakumController::getInstance()->incrementIgnoreRefcount();
+    }
+    ~RaiiOakumIgnore() {
+        FATAL_ERROR_IF(!OakumController::getInstance()->decrementIgnoreRefcount(), "Cannot decrement ignore refcount");
+    }
 };
 
 } // namespace Oakum
@@ -2,20 +2,28 @@
 
 #include <new>
 
+// Return address of the operator identifies the call site of the allocation
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CALLER_ADDRESS() _ReturnAddress()
+#else
+#define CALLER_ADDRESS() __builtin_return_address(0)
+#endif
+
 void *operator new(std::size_t size) {
-    return Oakum::OakumController::allocateMemory(size, false);
+    return Oakum::OakumController::allocateMemory(size, false, CALLER_ADDRESS());
 }
 
 void *operator new(std::size_t size, [[maybe_unused]] const std::nothrow_t &tag) noexcept {
-    return Oakum::OakumController::allocateMemory(size, true);
+    return Oakum::OakumController::allocateMemory(size, true, CALLER_ADDRESS());
 }
 
 void *operator new[](std::size_t size) {
-    return Oakum::OakumController::allocateMemory(size, false);
+    return Oakum::OakumController::allocateMemory(size, false, CALLER_ADDRESS());
 }
 
 void *operator new[](std::size_t size, [[maybe_unused]] const std::nothrow_t &tag) noexcept {
-    return Oakum::OakumController::allocateMemory(size, true);
+    return Oakum::OakumController::allocateMemory(size, true, CALLER_ADDRESS());
 }
 
 void operator delete(void *ptr) noexcept {
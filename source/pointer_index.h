@@ -0,0 +1,139 @@
+#pragma once
+
+#include "source/thread_safety_policy.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Oakum {
+
+// Locations of allocations held outside of the shared registry, keyed by pointer. Pointers are spread over shards, each
+// of which is an open addressing hash table with linear probing guarded by its own lock. Removed entries are filled by
+// shifting the following ones back, so there are no tombstones. Shards grow when they get half full and never shrink,
+// so once the number of indexed pointers stops growing, adding and removing them does not allocate. Adding may allocate,
+// so the caller has to make sure this memory is not tracked.
+template <typename OwnerT>
+class PointerIndex {
+public:
+    struct Location {
+        OwnerT *owner = nullptr;
+        size_t slot = 0;
+    };
+
+    PointerIndex(bool threadSafe) : threadSafe(threadSafe) {}
+
+    void add(void *pointer, Location location) {
+        const uint64_t hash = getHash(pointer);
+        Shard &shard = shards[getShardIndex(hash)];
+        const auto lock = ThreadSafety::lock(shard.lock, threadSafe);
+        if ((shard.entriesCount + 1) * 2 > shard.entries.size()) {
+            grow(shard);
+        }
+        insert(shard, {pointer, location}, hash);
+        shard.entriesCount++;
+    }
+
+    // Removes the pointer, so the caller becomes responsible for the allocation at the returned location
+    bool take(void *pointer, Location &outLocation) {
+        const uint64_t hash = getHash(pointer);
+        Shard &shard = shards[getShardIndex(hash)];
+        const auto lock = ThreadSafety::lock(shard.lock, threadSafe);
+        size_t entryIndex{};
+        if (!find(shard, pointer, hash, entryIndex)) {
+            return false;
+        }
+        outLocation = shard.entries[entryIndex].location;
+        erase(shard, entryIndex);
+        return true;
+    }
+
+    void remove(void *pointer) {
+        const uint64_t hash = getHash(pointer);
+        Shard &shard = shards[getShardIndex(hash)];
+        const auto lock = ThreadSafety::lock(shard.lock, threadSafe);
+        size_t entryIndex{};
+        if (find(shard, pointer, hash, entryIndex)) {
+            erase(shard, entryIndex);
+        }
+    }
+
+protected:
+    constexpr static inline size_t shardsCount = 64; // must be a power of two
+    constexpr static inline size_t minEntriesCount = 64;
+
+    struct Entry {
+        void *pointer = nullptr; // null marks an unused entry
+        Location location = {};
+    };
+    struct Shard {
+        std::mutex lock = {};
+        std::vector<Entry> entries = {}; // size is zero or a power of two
+        size_t entriesCount = 0;
+    };
+
+    // Allocations are aligned, so the lowest bits carry no information. Bits are mixed and the upper ones are used.
+    static uint64_t getHash(void *pointer) {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer)) * 0x9E3779B97F4A7C15ull;
+    }
+    static size_t getShardIndex(uint64_t hash) {
+        return static_cast<size_t>(hash >> 58) & (shardsCount - 1);
+    }
+    static size_t getHomeIndex(const Shard &shard, uint64_t hash) {
+        return static_cast<size_t>(hash >> 32) & (shard.entries.size() - 1);
+    }
+
+    static bool find(const Shard &shard, void *pointer, uint64_t hash, size_t &outEntryIndex) {
+        if (shard.entries.empty()) {
+            return false;
+        }
+        const size_t mask = shard.entries.size() - 1;
+        for (size_t entryIndex = getHomeIndex(shard, hash); shard.entries[entryIndex].pointer != nullptr; entryIndex = (entryIndex + 1) & mask) {
+            if (shard.entries[entryIndex].pointer == pointer) {
+                outEntryIndex = entryIndex;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static void insert(Shard &shard, const Entry &entry, uint64_t hash) {
+        const size_t mask = shard.entries.size() - 1;
+        size_t entryIndex = getHomeIndex(shard, hash);
+        while (shard.entries[entryIndex].pointer != nullptr) {
+            entryIndex = (entryIndex + 1) & mask;
+        }
+        shard.entries[entryIndex] = entry;
+    }
+
+    static void erase(Shard &shard, size_t entryIndex) {
+        // Each following entry of the probe sequence, which would not be found across the hole, is moved into it
+        const size_t mask = shard.entries.size() - 1;
+        for (size_t nextIndex = (entryIndex + 1) & mask; shard.entries[nextIndex].pointer != nullptr; nextIndex = (nextIndex + 1) & mask) {
+            const size_t homeIndex = getHomeIndex(shard, getHash(shard.entries[nextIndex].pointer));
+            if (((nextIndex - homeIndex) & mask) >= ((nextIndex - entryIndex) & mask)) {
+                shard.entries[entryIndex] = shard.entries[nextIndex];
+                entryIndex = nextIndex;
+            }
+        }
+        shard.entries[entryIndex] = {};
+        shard.entriesCount--;
+    }
+
+    static void grow(Shard &shard) {
+        std::vector<Entry> entries(shard.entries.empty() ? minEntriesCount : shard.entries.size() * 2);
+        entries.swap(shard.entries);
+        for (const Entry &entry : entries) {
+            if (entry.pointer != nullptr) {
+                insert(shard, entry, getHash(entry.pointer));
+            }
+        }
+    }
+
+    const bool threadSafe;
+    std::array<Shard, shardsCount> shards = {};
+};
+
+} // namespace Oakum
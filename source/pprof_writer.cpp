@@ -0,0 +1,186 @@
+#include "source/module_registry.h"
+#include "source/pprof_writer.h"
+#include "source/profile.h"
+#include "source/protobuf_encoder.h"
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+
+namespace Oakum {
+namespace {
+// Field numbers of messages defined in profile.proto
+namespace ProfileField {
+constexpr uint32_t sampleType = 1;
+constexpr uint32_t sample = 2;
+constexpr uint32_t mapping = 3;
+constexpr uint32_t location = 4;
+constexpr uint32_t function = 5;
+constexpr uint32_t stringTable = 6;
+constexpr uint32_t timeNanos = 9;
+constexpr uint32_t periodType = 11;
+constexpr uint32_t period = 12;
+constexpr uint32_t defaultSampleType = 14;
+} // namespace ProfileField
+namespace ValueTypeField {
+constexpr uint32_t type = 1;
+constexpr uint32_t unit = 2;
+} // namespace ValueTypeField
+namespace SampleField {
+constexpr uint32_t locationId = 1;
+constexpr uint32_t value = 2;
+} // namespace SampleField
+namespace MappingField {
+constexpr uint32_t id = 1;
+constexpr uint32_t memoryStart = 2;
+constexpr uint32_t memoryLimit = 3;
+constexpr uint32_t fileOffset = 4;
+constexpr uint32_t filename = 5;
+constexpr uint32_t buildId = 6;
+constexpr uint32_t hasFunctions = 7;
+} // namespace MappingField
+namespace LocationField {
+constexpr uint32_t id = 1;
+constexpr uint32_t mappingId = 2;
+constexpr uint32_t address = 3;
+constexpr uint32_t line = 4;
+} // namespace LocationField
+namespace LineField {
+constexpr uint32_t functionId = 1;
+} // namespace LineField
+namespace FunctionField {
+constexpr uint32_t id = 1;
+constexpr uint32_t name = 2;
+constexpr uint32_t systemName = 3;
+} // namespace FunctionField
+
+// All strings are referenced by their index in the string table. Index zero is reserved for an empty string.
+class StringTable {
+public:
+    StringTable() { getIndex(""); }
+
+    uint64_t getIndex(const std::string &string) {
+        auto [entry, inserted] = indices.insert({string, strings.size()});
+        if (inserted) {
+            strings.push_back(string);
+        }
+        return entry->second;
+    }
+
+    void write(ProtobufEncoder &encoder) const {
+        for (const std::string &string : strings) {
+            encoder.writeBytes(ProfileField::stringTable, string);
+        }
+    }
+
+private:
+    std::unordered_map<std::string, uint64_t> indices = {};
+    std::vector<std::string> strings = {};
+};
+} // namespace
+
+void PprofWriter::write(std::ostream &stream, const Profile &profile, ModuleRegistry &modules) {
+    ProtobufEncoder encoder{};
+    ProtobufEncoder message{};
+    StringTable strings{};
+
+    auto writeValueType = [&](uint32_t field, const char *type, const char *unit) {
+        message.clear();
+        message.writeVarint(ValueTypeField::type, strings.getIndex(type));
+        message.writeVarint(ValueTypeField::unit, strings.getIndex(unit));
+        encoder.writeMessage(field, message);
+    };
+    writeValueType(ProfileField::sampleType, "inuse_objects", "count");
+    writeValueType(ProfileField::sampleType, "inuse_space", "bytes");
+    if (profile.hasTotals) {
+        writeValueType(ProfileField::sampleType, "alloc_objects", "count");
+        writeValueType(ProfileField::sampleType, "alloc_space", "bytes");
+    }
+
+    // Location ids are frame indices shifted by one, because zero is not a valid id
+    std::vector<uint64_t> locationIds{};
+    std::vector<uint64_t> values{};
+    for (const Profile::Sample &sample : profile.samples) {
+        locationIds.clear();
+        for (size_t frameIndex : sample.frameIndices) {
+            locationIds.push_back(frameIndex + 1);
+        }
+        values = {sample.liveAllocationsCount, sample.liveBytes};
+        if (profile.hasTotals) {
+            values.push_back(sample.totalAllocationsCount);
+            values.push_back(sample.totalBytes);
+        }
+
+        message.clear();
+        message.writePackedVarints(SampleField::locationId, locationIds.begin(), locationIds.end());
+        message.writePackedVarints(SampleField::value, values.begin(), values.end());
+        encoder.writeMessage(ProfileField::sample, message);
+    }
+
+    // Mapping ids are module indices shifted by one. Only modules referenced by frames are written.
+    std::vector<bool> usedModules{};
+    for (const OakumStackFrame &frame : profile.frames) {
+        if (frame.moduleIndex != OAKUM_UNKNOWN_MODULE_INDEX) {
+            if (frame.moduleIndex >= usedModules.size()) {
+                usedModules.resize(frame.moduleIndex + 1, false);
+            }
+            usedModules[frame.moduleIndex] = true;
+        }
+    }
+    for (size_t moduleIndex = 0; moduleIndex < usedModules.size(); moduleIndex++) {
+        const ModuleRegistry::Module *module = usedModules[moduleIndex] ? modules.getModule(moduleIndex) : nullptr;
+        if (module == nullptr) {
+            continue;
+        }
+
+        message.clear();
+        message.writeVarint(MappingField::id, moduleIndex + 1);
+        message.writeVarint(MappingField::memoryStart, module->begin);
+        message.writeVarint(MappingField::memoryLimit, module->end);
+        message.writeVarint(MappingField::fileOffset, module->fileOffset);
+        message.writeVarint(MappingField::filename, strings.getIndex(module->path));
+        message.writeVarint(MappingField::buildId, strings.getIndex(module->buildId));
+        message.writeBool(MappingField::hasFunctions, profile.hasSymbols);
+        encoder.writeMessage(ProfileField::mapping, message);
+    }
+
+    // Functions are identified by their names, so frames from different call sites in one function share an entry
+    std::unordered_map<std::string, uint64_t> functionIds{};
+    ProtobufEncoder line{};
+    for (size_t frameIndex = 0; frameIndex < profile.frames.size(); frameIndex++) {
+        const OakumStackFrame &frame = profile.frames[frameIndex];
+
+        message.clear();
+        message.writeVarint(LocationField::id, frameIndex + 1);
+        if (frame.moduleIndex != OAKUM_UNKNOWN_MODULE_INDEX) {
+            message.writeVarint(LocationField::mappingId, frame.moduleIndex + 1);
+        }
+        message.writeVarint(LocationField::address, reinterpret_cast<uintptr_t>(frame.address));
+        if (frame.symbolName != nullptr) {
+            auto [function, inserted] = functionIds.insert({frame.symbolName, functionIds.size() + 1});
+            line.clear();
+            line.writeVarint(LineField::functionId, function->second);
+            message.writeMessage(LocationField::line, line);
+        }
+        encoder.writeMessage(ProfileField::location, message);
+    }
+    for (const auto &[name, id] : functionIds) {
+        message.clear();
+        message.writeVarint(FunctionField::id, id);
+        message.writeVarint(FunctionField::name, strings.getIndex(name));
+        message.writeVarint(FunctionField::systemName, strings.getIndex(name));
+        encoder.writeMessage(ProfileField::function, message);
+    }
+
+    const auto timeNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
+    encoder.writeVarint(ProfileField::timeNanos, static_cast<uint64_t>(timeNanos.count()));
+    writeValueType(ProfileField::periodType, "space", "bytes");
+    encoder.writeVarint(ProfileField::period, 1u);
+    encoder.writeVarint(ProfileField::defaultSampleType, strings.getIndex("inuse_space"));
+
+    // String table is written last, because all other messages add their strings to it
+    strings.write(encoder);
+    stream.write(encoder.getBuffer().data(), static_cast<std::streamsize>(encoder.getBuffer().size()));
+}
+
+} // namespace Oakum
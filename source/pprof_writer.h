@@ -0,0 +1,17 @@
+#pragma once
+
+#include <ostream>
+
+namespace Oakum {
+class ModuleRegistry;
+struct Profile;
+
+// Writes a profile in the pprof format (gzip-less profile.proto), which can be consumed by pprof, speedscope and other
+// tools. Live values are reported as inuse_objects and inuse_space sample types. Cumulative values, if available, are
+// reported as alloc_objects and alloc_space. Modules are written as mappings, so symbols can also be resolved offline.
+struct PprofWriter {
+    PprofWriter() = delete;
+    static void write(std::ostream &stream, const Profile &profile, ModuleRegistry &modules);
+};
+
+} // namespace Oakum
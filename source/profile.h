@@ -0,0 +1,31 @@
+#pragma once
+
+#include "source/include/oakum/oakum_api.h"
+#include "source/report_arena.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Oakum {
+
+// Allocations aggregated per unique stack trace. This is the input of all profile writers. Frames are stored once
+// and referenced by samples, ordered from the innermost one. Live values come from tracked allocations. Cumulative
+// values are available only, when call sites are tracked, and are reported in separate single frame samples.
+struct Profile {
+    struct Sample {
+        std::vector<size_t> frameIndices = {};
+        uint64_t liveAllocationsCount = 0;
+        uint64_t liveBytes = 0;
+        uint64_t totalAllocationsCount = 0;
+        uint64_t totalBytes = 0;
+    };
+
+    bool hasTotals = false;
+    bool hasSymbols = false;
+    std::vector<OakumStackFrame> frames = {};
+    std::vector<Sample> samples = {};
+    ReportArena strings = {}; // owns symbol names of the frames
+};
+
+} // namespace Oakum
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Oakum {
+
+// Minimal encoder of the protocol buffers wire format. Messages are encoded into a buffer, which can be embedded
+// in a parent message or written out by the caller. Only the wire types needed by profile writers are supported.
+class ProtobufEncoder {
+public:
+    void writeVarint(uint32_t field, uint64_t value) {
+        writeTag(field, wireTypeVarint);
+        writeRawVarint(value);
+    }
+
+    void writeBool(uint32_t field, bool value) {
+        writeVarint(field, value ? 1u : 0u);
+    }
+
+    void writeBytes(uint32_t field, std::string_view value) {
+        writeTag(field, wireTypeLengthDelimited);
+        writeRawVarint(value.size());
+        buffer.append(value.data(), value.size());
+    }
+
+    void writeMessage(uint32_t field, const ProtobufEncoder &message) {
+        writeBytes(field, message.getBuffer());
+    }
+
+    template <typename IteratorT>
+    void writePackedVarints(uint32_t field, IteratorT begin, IteratorT end) {
+        ProtobufEncoder values{};
+        for (IteratorT it = begin; it != end; it++) {
+            values.writeRawVarint(static_cast<uint64_t>(*it));
+        }
+        writeBytes(field, values.getBuffer());
+    }
+
+    const std::string &getBuffer() const { return buffer; }
+    void clear() { buffer.clear(); }
+
+private:
+    constexpr static inline uint32_t wireTypeVarint = 0;
+    constexpr static inline uint32_t wireTypeLengthDelimited = 2;
+
+    void writeTag(uint32_t field, uint32_t wireType) {
+        writeRawVarint((static_cast<uint64_t>(field) << 3) | wireType);
+    }
+
+    void writeRawVarint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        buffer.push_back(static_cast<char>(value));
+    }
+
+    std::string buffer = {};
+};
+
+} // namespace Oakum
@@ -0,0 +1,32 @@
+#include "source/query_server.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace Oakum {
+QueryServer::Response &QueryServer::Response::operator<<(std::string_view text) {
+    while (!text.empty() && !disconnected) {
+        const size_t chunkSize = std::min(text.size(), sizeof(buffer) - bufferSize);
+        memcpy(buffer + bufferSize, text.data(), chunkSize);
+        bufferSize += chunkSize;
+        text.remove_prefix(chunkSize);
+        if (bufferSize == sizeof(buffer)) {
+            flush();
+        }
+    }
+    return *this;
+}
+
+QueryServer::Response &QueryServer::Response::operator<<(uint64_t value) {
+    char text[24] = {};
+    const char *end = std::to_chars(text, text + sizeof(text), value).ptr;
+    return *this << std::string_view(text, end - text);
+}
+
+QueryServer::Response &QueryServer::Response::operator<<(const void *address) {
+    char text[24] = {'0', 'x'};
+    const char *end = std::to_chars(text + 2, text + sizeof(text), reinterpret_cast<uintptr_t>(address), 16).ptr;
+    return *this << std::string_view(text, end - text);
+}
+} // namespace Oakum
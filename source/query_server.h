@@ -0,0 +1,66 @@
+#pragma once
+
+#include "source/background_thread.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace Oakum {
+
+// Answers text queries from local clients on a dedicated thread. Each client connects to a Unix domain socket, sends
+// a single line with the query and receives a text response terminated by closing the connection. Responses are sent
+// in small chunks as they are produced, so a query about a large heap does not have to be materialized in memory.
+// Clients are served one at a time. The socket is accessible only to the owner of the process.
+class QueryServer {
+public:
+    class Response {
+    public:
+        explicit Response(int descriptor) : descriptor(descriptor) {}
+        ~Response() { flush(); }
+        Response(const Response &) = delete;
+        Response &operator=(const Response &) = delete;
+
+        Response &operator<<(std::string_view text);
+        Response &operator<<(const char *text) { return *this << std::string_view{text}; } // otherwise the pointer overload is chosen
+        Response &operator<<(uint64_t value);
+        Response &operator<<(const void *address);
+        bool isDisconnected() const { return disconnected; } // further output is discarded
+
+    protected:
+        void flush();
+
+        const int descriptor;
+        char buffer[4096] = {};
+        size_t bufferSize = 0;
+        bool disconnected = false;
+    };
+    using QueryFunction = std::function<void(std::string_view query, Response &response)>;
+
+    QueryServer(const char *socketPath, QueryFunction &&queryFunction);
+    ~QueryServer();
+    QueryServer(const QueryServer &) = delete;
+    QueryServer &operator=(const QueryServer &) = delete;
+
+    static bool isSupported();
+    bool open();
+    void start();
+    void stop();
+
+protected:
+    void run();
+    void serveClient(int clientDescriptor);
+
+    constexpr static inline size_t maxQueryLength = 256;
+
+    const std::string socketPath;
+    const QueryFunction queryFunction;
+    int listeningDescriptor = -1;
+    int stopPipeDescriptors[2] = {-1, -1};
+    BackgroundThread thread = {};
+};
+
+} // namespace Oakum
@@ -0,0 +1,46 @@
+#include "source/oakum_controller.h"
+#include "source/report_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace Oakum {
+char *ReportArena::copyString(const char *string) {
+    if (auto existing = strings.find(string); existing != strings.end()) {
+        return existing->second;
+    }
+
+    const size_t length = strlen(string);
+    char *copy = allocateArray<char>(length + 1);
+    memcpy(copy, string, length + 1);
+
+    RaiiOakumIgnore raiiIgnore{};
+    strings.emplace(std::string_view{copy, length}, copy);
+    return copy;
+}
+
+void *ReportArena::allocate(size_t size, size_t alignment) {
+    if (size == 0) {
+        return nullptr;
+    }
+
+    size_t padding = (alignment - reinterpret_cast<uintptr_t>(chunkPosition) % alignment) % alignment;
+    if (padding + size > chunkRemainingSize) {
+        // Allocations larger than a chunk, e.g. the allocations array, get a chunk of their own
+        const size_t chunkSize = std::max(nextChunkSize, size + alignment);
+        nextChunkSize = std::min(nextChunkSize * 2, maxChunkSize);
+
+        RaiiOakumIgnore raiiIgnore{};
+        chunks.emplace_back(new char[chunkSize]); // not value-initialized, every byte is written before being returned
+        chunkPosition = chunks.back().get();
+        chunkRemainingSize = chunkSize;
+        padding = (alignment - reinterpret_cast<uintptr_t>(chunkPosition) % alignment) % alignment;
+    }
+
+    void *result = chunkPosition + padding;
+    chunkPosition += padding + size;
+    chunkRemainingSize -= padding + size;
+    return result;
+}
+} // namespace Oakum
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Oakum {
+
+// Storage of everything returned to the user in a single report: allocations array, stack frames and resolved strings.
+// Memory is carved out of geometrically growing chunks by bumping a pointer and released all at once, when the arena is
+// destroyed. Strings are deduplicated, because most frames of a report share a handful of symbols and file names.
+// The arena is not thread safe.
+class ReportArena {
+public:
+    ReportArena() = default;
+    ReportArena(const ReportArena &) = delete;
+    ReportArena &operator=(const ReportArena &) = delete;
+
+    template <typename T>
+    T *allocateArray(size_t count) {
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+    char *copyString(const char *string);
+    size_t getChunksCount() const { return chunks.size(); }
+
+protected:
+    void *allocate(size_t size, size_t alignment);
+
+    constexpr static inline size_t minChunkSize = 4 * 1024;
+    constexpr static inline size_t maxChunkSize = 1024 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> chunks = {};
+    char *chunkPosition = nullptr;
+    size_t chunkRemainingSize = 0;
+    size_t nextChunkSize = minChunkSize;
+    std::unordered_map<std::string_view, char *> strings = {}; // keys point to the arena
+};
+
+} // namespace Oakum
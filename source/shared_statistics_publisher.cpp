@@ -0,0 +1,66 @@
+#include "source/shared_statistics_publisher.h"
+
+#include <cstddef>
+#include <cstring>
+
+namespace Oakum {
+SharedStatisticsPublisher::SharedStatisticsPublisher(const char *name, std::chrono::milliseconds interval, UpdateFunction &&updateFunction)
+    : name(name),
+      interval(interval),
+      updateFunction(std::move(updateFunction)) {}
+
+SharedStatisticsPublisher::~SharedStatisticsPublisher() {
+    stop();
+    if (page != nullptr) {
+        closePage();
+    }
+}
+
+void SharedStatisticsPublisher::start() {
+    previousUpdateTime = std::chrono::steady_clock::now();
+    thread.start([this]() { run(); });
+}
+
+void SharedStatisticsPublisher::stop() {
+    thread.stop();
+}
+
+void SharedStatisticsPublisher::publish() {
+    const OakumSharedStatistics previousStatistics = nextStatistics;
+    nextStatistics = {};
+    updateFunction(nextStatistics);
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - previousUpdateTime).count();
+    previousUpdateTime = now;
+    if (previousStatistics.updatesCount > 0 && elapsedNs > 0) {
+        const auto perSecond = [elapsedNs](uint64_t current, uint64_t previous) {
+            return static_cast<uint64_t>(static_cast<double>(current - previous) * 1e9 / static_cast<double>(elapsedNs));
+        };
+        nextStatistics.allocationsPerSecond = perSecond(nextStatistics.totalAllocationsCount, previousStatistics.totalAllocationsCount);
+        nextStatistics.deallocationsPerSecond = perSecond(nextStatistics.totalDeallocationsCount, previousStatistics.totalDeallocationsCount);
+    }
+    nextStatistics.updatesCount = previousStatistics.updatesCount + 1;
+    nextStatistics.updateTimeNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+    // Sequence lock writer. The release fence after making the sequence odd keeps the data stores from being observed
+    // before it and the final release store keeps them from being observed after the sequence becomes even again.
+    // Lock-free 64-bit atomics have the same representation as plain integers, so readers may load them in any way.
+    auto &sequence = *reinterpret_cast<std::atomic<uint64_t> *>(&page->sequence);
+    const uint64_t currentSequence = sequence.load(std::memory_order_relaxed);
+    sequence.store(currentSequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    constexpr size_t dataOffset = offsetof(OakumSharedStatistics, sequence) + sizeof(OakumSharedStatistics::sequence);
+    memcpy(reinterpret_cast<char *>(page) + dataOffset, reinterpret_cast<const char *>(&nextStatistics) + dataOffset, sizeof(OakumSharedStatistics) - dataOffset);
+    sequence.store(currentSequence + 2, std::memory_order_release);
+}
+
+void SharedStatisticsPublisher::run() {
+    auto lockGuard = thread.lock();
+    do {
+        lockGuard.unlock();
+        publish();
+        lockGuard.lock();
+    } while (thread.waitFor(lockGuard, interval));
+}
+} // namespace Oakum
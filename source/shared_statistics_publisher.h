@@ -0,0 +1,48 @@
+#pragma once
+
+#include "source/background_thread.h"
+#include "source/include/oakum/oakum_api.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Oakum {
+
+// Periodically publishes statistics into a named shared memory object on a dedicated thread, so external monitors can
+// read them at any frequency without syscalls or locks in the monitored process. The page is written under a sequence
+// lock: readers retry, if they observe an odd sequence number or if it changes while they copy the structure. There is
+// a single writer, so the writer itself never waits. Rates are derived from the difference between consecutive updates.
+class SharedStatisticsPublisher {
+public:
+    using UpdateFunction = std::function<void(OakumSharedStatistics &outStatistics)>;
+
+    SharedStatisticsPublisher(const char *name, std::chrono::milliseconds interval, UpdateFunction &&updateFunction);
+    ~SharedStatisticsPublisher();
+    SharedStatisticsPublisher(const SharedStatisticsPublisher &) = delete;
+    SharedStatisticsPublisher &operator=(const SharedStatisticsPublisher &) = delete;
+
+    static bool isSupported();
+    bool open();
+    void start();
+    void stop();
+    void publish();
+
+protected:
+    void closePage();
+    void run();
+
+    const std::string name;
+    const std::chrono::milliseconds interval;
+    const UpdateFunction updateFunction;
+    OakumSharedStatistics *page = nullptr;
+
+    OakumSharedStatistics nextStatistics = {}; // filled outside of the sequence lock to keep the critical section short
+    std::chrono::steady_clock::time_point previousUpdateTime = {};
+
+    BackgroundThread thread = {};
+};
+
+} // namespace Oakum
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "source/background_thread.h"
+
+#include <functional>
+
+namespace Oakum {
+
+// Writes reports on a dedicated thread, when the process receives a signal. The signal handler only writes a byte to
+// a non-blocking pipe, which is async-signal-safe, and the thread waiting on the other end of the pipe calls the report
+// function. Requests received while a report is being written are coalesced into a single subsequent report. Only one
+// reporter can be active in the process, because signal handlers are global.
+class SignalReporter {
+public:
+    using ReportFunction = std::function<void()>;
+
+    SignalReporter(int signalNumber, ReportFunction &&reportFunction);
+    ~SignalReporter();
+    SignalReporter(const SignalReporter &) = delete;
+    SignalReporter &operator=(const SignalReporter &) = delete;
+
+    static bool isSupported();
+    void start();
+    void stop();
+
+protected:
+    static void handleSignal(int signalNumber);
+    void run();
+
+    const int signalNumber;
+    const ReportFunction reportFunction;
+    int pipeDescriptors[2] = {-1, -1};
+    BackgroundThread thread = {};
+};
+
+} // namespace Oakum
@@ -0,0 +1,81 @@
+#include "source/error.h"
+#include "source/stack_frame_pool.h"
+
+namespace Oakum {
+void **StackFrameStore::allocateChunk() {
+    std::lock_guard lockGuard{lock};
+    chunks.push_back(std::make_unique<void *[]>(chunkSize));
+    return chunks.back().get();
+}
+
+void StackFrameStore::takeFreeSlots(size_t framesCount, FreeList &outList) {
+    std::lock_guard lockGuard{lock};
+    outList = freeLists[framesCount];
+    freeLists[framesCount] = {};
+}
+
+void StackFrameStore::returnFreeSlots(size_t framesCount, FreeList &list) {
+    if (list.head == nullptr) {
+        return;
+    }
+
+    std::lock_guard lockGuard{lock};
+    FreeList &storeList = freeLists[framesCount];
+    list.tail[0] = storeList.head;
+    if (storeList.head == nullptr) {
+        storeList.tail = list.tail;
+    }
+    storeList.head = list.head;
+    storeList.count += list.count;
+    list = {};
+}
+
+void **StackFramePool::allocate(size_t framesCount) {
+    if (framesCount == 0) {
+        return nullptr;
+    }
+    DEBUG_ERROR_IF(framesCount >= freeLists.size(), "Too many stack frames for the pool");
+
+    StackFrameStore::FreeList &freeList = freeLists[framesCount];
+    if (freeList.head == nullptr) {
+        store.takeFreeSlots(framesCount, freeList);
+    }
+    if (void **frames = freeList.head; frames != nullptr) {
+        freeList.head = static_cast<void **>(frames[0]);
+        freeList.tail = freeList.head != nullptr ? freeList.tail : nullptr;
+        freeList.count--;
+        return frames;
+    }
+
+    if (chunkUsedSize + framesCount > StackFrameStore::chunkSize) {
+        chunk = store.allocateChunk();
+        chunkUsedSize = 0;
+    }
+    void **frames = chunk + chunkUsedSize;
+    chunkUsedSize += framesCount;
+    return frames;
+}
+
+void StackFramePool::free(void **frames, size_t framesCount) {
+    if (frames == nullptr) {
+        return;
+    }
+
+    StackFrameStore::FreeList &freeList = freeLists[framesCount];
+    frames[0] = freeList.head;
+    freeList.tail = freeList.head != nullptr ? freeList.tail : frames;
+    freeList.head = frames;
+    freeList.count++;
+
+    // Threads freeing memory allocated by other threads would otherwise accumulate slots, which they never reuse
+    if (freeList.count * framesCount >= maxFreeSlotsCount) {
+        store.returnFreeSlots(framesCount, freeList);
+    }
+}
+
+void StackFramePool::releaseFreeSlots() {
+    for (size_t framesCount = 1; framesCount < freeLists.size(); framesCount++) {
+        store.returnFreeSlots(framesCount, freeLists[framesCount]);
+    }
+}
+} // namespace Oakum
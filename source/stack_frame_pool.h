@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Oakum {
+
+// Chunks of stack frame slots and free slots shared by pools of all threads. Pools touch it only when they run out of
+// slots or hold too many free ones, so it is guarded by a single lock.
+class StackFrameStore {
+public:
+    struct FreeList {
+        void **head = nullptr; // first slot of each free entry points to the next one
+        void **tail = nullptr;
+        size_t count = 0;
+    };
+
+    StackFrameStore(size_t maxFramesCount) : freeLists(maxFramesCount + 1) {}
+
+    void **allocateChunk();
+    void takeFreeSlots(size_t framesCount, FreeList &outList);
+    void returnFreeSlots(size_t framesCount, FreeList &list);
+
+    constexpr static inline size_t chunkSize = 16384;
+
+protected:
+    std::mutex lock = {};
+    std::vector<FreeList> freeLists;
+    std::vector<std::unique_ptr<void *[]>> chunks = {};
+};
+
+// Storage of captured stack frame addresses used by a single thread. Each allocation gets exactly as many slots as the
+// number of frames captured for it. Slots are carved from chunks of the store and recycled through free lists kept
+// separately for each length, so storing a stack trace usually does not lock or allocate anything. Slots freed by another
+// thread than the one, which allocated them, are returned to the store in batches, so they are not stranded.
+class StackFramePool {
+public:
+    StackFramePool(StackFrameStore &store, size_t maxFramesCount) : store(store), freeLists(maxFramesCount + 1) {}
+
+    void **allocate(size_t framesCount);
+    void free(void **frames, size_t framesCount);
+    void releaseFreeSlots();
+
+protected:
+    constexpr static inline size_t maxFreeSlotsCount = StackFrameStore::chunkSize / 4; // per length
+
+    StackFrameStore &store;
+    std::vector<StackFrameStore::FreeList> freeLists;
+    void **chunk = nullptr;
+    size_t chunkUsedSize = StackFrameStore::chunkSize;
+};
+
+} // namespace Oakum
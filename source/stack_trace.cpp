@@ -1,24 +1,51 @@
 #include "source/error.h"
 #include "source/include/oakum/oakum_api.h"
+#include "source/module_registry.h"
+#include "source/report_arena.h"
 #include "source/stack_trace.h"
 
-#include <cstring>
+#include <algorithm>
 
 namespace Oakum {
-void StackTraceHelper::setupString(char *&destination, const char *source) {
-    const size_t bufferSize = strlen(source) + 1;
-    destination = new char[bufferSize];
-    strcpy(destination, source);
+void StackTraceHelper::setupString(char *&destination, const char *source, ReportArena &strings) {
+    destination = strings.copyString(source);
 }
 
-void StackTraceHelper::initializeFrames(OakumStackFrame *frames, size_t &framesCount) {
-    OakumStackFrame emptyFrame = {
-        nullptr,
-        nullptr,
-        nullptr,
-        0u,
-    };
-    std::fill_n(frames, framesCount, emptyFrame);
-    framesCount = 0u;
+void StackTraceHelper::setupFrames(OakumStackFrame *outFrames, void *const *frames, size_t framesCount) {
+    for (size_t frameIndex = 0; frameIndex < framesCount; frameIndex++) {
+        outFrames[frameIndex] = {
+            frames[frameIndex],
+            nullptr,
+            nullptr,
+            0u,
+            OAKUM_UNKNOWN_MODULE_INDEX,
+            0u,
+        };
+    }
+}
+
+void StackTraceHelper::setupModules(OakumStackFrame *frames, size_t framesCount, ModuleRegistry &modules) {
+    for (size_t frameIndex = 0; frameIndex < framesCount; frameIndex++) {
+        OakumStackFrame &frame = frames[frameIndex];
+        if (!modules.resolveRelativeAddress(frame.address, frame.address, frame.moduleIndex, frame.moduleOffset)) {
+            frame.moduleIndex = OAKUM_UNKNOWN_MODULE_INDEX;
+            frame.moduleOffset = 0u;
+        }
+    }
+}
+
+bool StackTraceHelper::isAnyFrameInRanges(void *const *frames, size_t framesCount, const std::vector<AddressRange> &sortedRanges) {
+    for (size_t frameIndex = 0; frameIndex < framesCount; frameIndex++) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(frames[frameIndex]);
+
+        // Find the last range beginning at or before the address
+        auto range = std::upper_bound(sortedRanges.begin(), sortedRanges.end(), address, [](uintptr_t value, const AddressRange &range) {
+            return value < range.first;
+        });
+        if (range != sortedRanges.begin() && address < std::prev(range)->second) {
+            return true;
+        }
+    }
+    return false;
 }
 } // namespace Oakum
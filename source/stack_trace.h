@@ -1,22 +1,39 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 struct OakumStackFrame;
 
 namespace Oakum {
+class ModuleRegistry;
+class ReportArena;
+class SymbolCache;
+
 struct StackTraceHelper {
+    using AddressRange = std::pair<uintptr_t, uintptr_t>; // [begin, end)
+
     StackTraceHelper() = delete;
     static bool supportsSourceLocations();
-    static void initializeFrames(OakumStackFrame *frames, size_t &framesCount);
-    static void captureFrames(OakumStackFrame *frames, size_t &framesCount);
+    static void captureFrames(size_t maxFramesCount, void **&outFrames, size_t &outFramesCount);
+    static void setupFrames(OakumStackFrame *outFrames, void *const *frames, size_t framesCount);
+
+    static void setupModules(OakumStackFrame *frames, size_t framesCount, ModuleRegistry &modules);
+
+    // Callers, which do not hold the symbol cache lock, pass it here. It is then taken only to access the cache, so other
+    // threads are not blocked by a symbol lookup or an addr2line process.
+    static bool resolveSymbols(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSymbolName, SymbolCache *symbolCache, ModuleRegistry &modules, ReportArena &strings, std::mutex *symbolCacheLock = nullptr);
+    static bool resolveSourceLocations(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSourceFileName, SymbolCache *symbolCache, ModuleRegistry &modules, ReportArena &strings, std::mutex *symbolCacheLock = nullptr);
 
-    static bool resolveSymbols(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSymbolName);
-    static bool resolveSourceLocations(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSourceFileName);
+    static void setupString(char *&destination, const char *source, ReportArena &strings);
 
-    static void setupString(char *&destination, const char *source);
+    static bool getModuleAddressRanges(const char *moduleName, std::vector<AddressRange> &outRanges);
+    static bool isAnyFrameInRanges(void *const *frames, size_t framesCount, const std::vector<AddressRange> &sortedRanges);
 
 private:
     constexpr static inline unsigned int skippedFrames = 3;
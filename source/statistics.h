@@ -0,0 +1,85 @@
+#pragma once
+
+#include "source/include/oakum/oakum_api.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace Oakum {
+
+// Counters updated on every tracked allocation. Most of them are split into stripes, each in a separate cache line and used
+// by a subset of threads, so allocating threads do not contend on the same memory. Live bytes have to be a single value to
+// maintain the peak, but it is updated with a single relaxed atomic add. Reading the statistics sums all stripes without locks,
+// so the result is not an atomic snapshot, but it is exact once there are no allocations in flight.
+class StatisticsCounters {
+public:
+    void onAllocation(size_t size) {
+        Stripe &stripe = getStripe();
+        stripe.liveAllocationsCount.fetch_add(1, std::memory_order_relaxed);
+        stripe.totalAllocationsCount.fetch_add(1, std::memory_order_relaxed);
+
+        const size_t currentLiveBytes = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        size_t currentPeak = peakLiveBytes.load(std::memory_order_relaxed);
+        while (currentLiveBytes > currentPeak && !peakLiveBytes.compare_exchange_weak(currentPeak, currentLiveBytes, std::memory_order_relaxed)) {
+        }
+    }
+
+    void onDeallocation(size_t size) {
+        Stripe &stripe = getStripe();
+        stripe.liveAllocationsCount.fetch_sub(1, std::memory_order_relaxed);
+        stripe.totalDeallocationsCount.fetch_add(1, std::memory_order_relaxed);
+        liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    void onFailedNoThrowAllocation() {
+        getStripe().failedNoThrowAllocationsCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t getLiveBytes() const {
+        return liveBytes.load(std::memory_order_relaxed);
+    }
+
+    size_t getLiveAllocationsCount() const {
+        int64_t result = 0;
+        for (const Stripe &stripe : stripes) {
+            result += stripe.liveAllocationsCount.load(std::memory_order_relaxed);
+        }
+        return result > 0 ? static_cast<size_t>(result) : 0u;
+    }
+
+    OakumStatistics get() const {
+        OakumStatistics result{};
+        result.liveAllocationsCount = getLiveAllocationsCount();
+        result.liveBytes = liveBytes.load(std::memory_order_relaxed);
+        result.peakLiveBytes = peakLiveBytes.load(std::memory_order_relaxed);
+        for (const Stripe &stripe : stripes) {
+            result.totalAllocationsCount += stripe.totalAllocationsCount.load(std::memory_order_relaxed);
+            result.totalDeallocationsCount += stripe.totalDeallocationsCount.load(std::memory_order_relaxed);
+            result.failedNoThrowAllocationsCount += stripe.failedNoThrowAllocationsCount.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+private:
+    constexpr static inline size_t stripesCount = 16;
+
+    struct alignas(64) Stripe {
+        std::atomic<int64_t> liveAllocationsCount = 0; // may go negative, if memory is freed by a thread using another stripe
+        std::atomic<uint64_t> totalAllocationsCount = 0;
+        std::atomic<uint64_t> totalDeallocationsCount = 0;
+        std::atomic<uint64_t> failedNoThrowAllocationsCount = 0;
+    };
+
+    Stripe &getStripe() {
+        static std::atomic<size_t> nextStripeIndex = 0;
+        static thread_local const size_t stripeIndex = nextStripeIndex++ % stripesCount;
+        return stripes[stripeIndex];
+    }
+
+    std::array<Stripe, stripesCount> stripes = {};
+    alignas(64) std::atomic<size_t> liveBytes = 0;
+    std::atomic<size_t> peakLiveBytes = 0;
+};
+
+} // namespace Oakum
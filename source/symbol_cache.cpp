@@ -0,0 +1,253 @@
+#include "source/oakum_controller.h"
+#include "source/symbol_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+namespace Oakum {
+SymbolCache::SymbolCache(const std::string &directory)
+    : directory(directory) {
+    if (isPersistent()) {
+        std::error_code error{};
+        std::filesystem::create_directories(directory, error);
+    }
+}
+
+std::optional<const char *> SymbolCache::findSymbol(const std::string &moduleId, uint64_t offset) {
+    RaiiOakumIgnore raiiIgnore{};
+    std::lock_guard lockGuard{lock};
+    ModuleCache &cache = getModuleCache(moduleId);
+
+    if (auto pendingEntry = cache.pendingEntries.find(offset); pendingEntry != cache.pendingEntries.end()) {
+        const Entry &entry = pendingEntry->second;
+        if (entry.symbolState != State::Unknown) {
+            return entry.symbolState == State::Resolved ? entry.symbolName.c_str() : nullptr;
+        }
+    }
+
+    if (const FileEntry *fileEntry = findFileEntry(cache, offset); fileEntry != nullptr) {
+        State state{};
+        const char *symbolName = getFileString(cache, fileEntry->symbolName, state);
+        if (state != State::Unknown) {
+            return symbolName;
+        }
+    }
+
+    return std::nullopt;
+}
+
+std::optional<SymbolCache::SourceLocation> SymbolCache::findSourceLocation(const std::string &moduleId, uint64_t offset) {
+    RaiiOakumIgnore raiiIgnore{};
+    std::lock_guard lockGuard{lock};
+    ModuleCache &cache = getModuleCache(moduleId);
+
+    if (auto pendingEntry = cache.pendingEntries.find(offset); pendingEntry != cache.pendingEntries.end()) {
+        const Entry &entry = pendingEntry->second;
+        if (entry.sourceLocationState != State::Unknown) {
+            const char *fileName = entry.sourceLocationState == State::Resolved ? entry.fileName.c_str() : nullptr;
+            return SourceLocation{fileName, entry.fileLine};
+        }
+    }
+
+    if (const FileEntry *fileEntry = findFileEntry(cache, offset); fileEntry != nullptr) {
+        State state{};
+        const char *fileName = getFileString(cache, fileEntry->fileName, state);
+        if (state != State::Unknown) {
+            return SourceLocation{fileName, fileEntry->fileLine};
+        }
+    }
+
+    return std::nullopt;
+}
+
+void SymbolCache::storeSymbol(const std::string &moduleId, uint64_t offset, const char *symbolName) {
+    RaiiOakumIgnore raiiIgnore{};
+    std::lock_guard lockGuard{lock};
+    Entry &entry = getModuleCache(moduleId).pendingEntries[offset];
+    entry.symbolState = symbolName != nullptr ? State::Resolved : State::Unresolved;
+    entry.symbolName = symbolName != nullptr ? symbolName : "";
+}
+
+void SymbolCache::storeSourceLocation(const std::string &moduleId, uint64_t offset, const char *fileName, size_t fileLine) {
+    RaiiOakumIgnore raiiIgnore{};
+    std::lock_guard lockGuard{lock};
+    Entry &entry = getModuleCache(moduleId).pendingEntries[offset];
+    entry.sourceLocationState = fileName != nullptr ? State::Resolved : State::Unresolved;
+    entry.fileName = fileName != nullptr ? fileName : "";
+    entry.fileLine = fileLine;
+}
+
+void SymbolCache::flush() {
+    if (!isPersistent()) {
+        return; // pending entries are the only storage
+    }
+
+    RaiiOakumIgnore raiiIgnore{};
+    std::lock_guard lockGuard{lock};
+    for (auto &[moduleId, cache] : modules) {
+        if (!cache.pendingEntries.empty()) {
+            writeFile(moduleId, cache);
+            cache.pendingEntries.clear();
+            loadFile(cache, MappedFile::open(getModuleCachePath(moduleId).c_str()));
+        }
+    }
+}
+
+SymbolCache::ModuleCache &SymbolCache::getModuleCache(const std::string &moduleId) {
+    auto [it, inserted] = modules.try_emplace(moduleId);
+    if (inserted && isPersistent()) {
+        loadFile(it->second, MappedFile::open(getModuleCachePath(moduleId).c_str()));
+    }
+    return it->second;
+}
+
+std::string SymbolCache::getModuleCachePath(const std::string &moduleId) const {
+    return directory + "/" + moduleId + ".oakumcache";
+}
+
+void SymbolCache::loadFile(ModuleCache &cache, std::unique_ptr<MappedFile> &&file) {
+    cache.file.reset();
+    cache.entries = nullptr;
+    cache.entriesCount = 0;
+    cache.strings = nullptr;
+    cache.stringsSize = 0;
+    if (file == nullptr || file->getSize() < sizeof(FileHeader)) {
+        return;
+    }
+
+    // Files could have been written by a different version of the library or damaged, so verify everything
+    FileHeader header{};
+    memcpy(&header, file->getData(), sizeof(header));
+    const size_t entriesSize = size_t{header.entriesCount} * sizeof(FileEntry);
+    if (memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0 || header.version != fileVersion ||
+        sizeof(FileHeader) + entriesSize + header.stringsSize != file->getSize()) {
+        return;
+    }
+    const char *strings = reinterpret_cast<const char *>(file->getData() + sizeof(FileHeader) + entriesSize);
+    if (header.stringsSize > 0 && strings[header.stringsSize - 1] != '\0') {
+        return;
+    }
+
+    cache.entries = reinterpret_cast<const FileEntry *>(file->getData() + sizeof(FileHeader));
+    cache.entriesCount = header.entriesCount;
+    cache.strings = strings;
+    cache.stringsSize = header.stringsSize;
+    cache.file = std::move(file);
+}
+
+const SymbolCache::FileEntry *SymbolCache::findFileEntry(const ModuleCache &cache, uint64_t offset) {
+    const FileEntry *end = cache.entries + cache.entriesCount;
+    const FileEntry *entry = std::lower_bound(cache.entries, end, offset, [](const FileEntry &entry, uint64_t offset) {
+        return entry.offset < offset;
+    });
+    if (entry == end || entry->offset != offset) {
+        return nullptr;
+    }
+    return entry;
+}
+
+const char *SymbolCache::getFileString(const ModuleCache &cache, uint32_t stringOffset, State &outState) const {
+    if (stringOffset == stringOffsetUnresolved) {
+        outState = State::Unresolved;
+        return nullptr;
+    }
+    if (stringOffset >= cache.stringsSize) {
+        outState = State::Unknown;
+        return nullptr;
+    }
+    outState = State::Resolved;
+    return cache.strings + stringOffset;
+}
+
+bool SymbolCache::writeFile(const std::string &moduleId, ModuleCache &cache) {
+    // Merge results stored in the file with the new ones. Other processes running the same binary could have replaced the
+    // file since it was mapped, so its current version is mapped again. Otherwise their results would be overwritten.
+    const std::string path = getModuleCachePath(moduleId);
+    loadFile(cache, MappedFile::open(path.c_str()));
+    std::map<uint64_t, Entry> entries{};
+    for (size_t entryIndex = 0; entryIndex < cache.entriesCount; entryIndex++) {
+        const FileEntry &fileEntry = cache.entries[entryIndex];
+        Entry &entry = entries[fileEntry.offset];
+        if (const char *symbolName = getFileString(cache, fileEntry.symbolName, entry.symbolState); symbolName != nullptr) {
+            entry.symbolName = symbolName;
+        }
+        if (const char *fileName = getFileString(cache, fileEntry.fileName, entry.sourceLocationState); fileName != nullptr) {
+            entry.fileName = fileName;
+        }
+        entry.fileLine = fileEntry.fileLine;
+    }
+    for (const auto &[offset, pendingEntry] : cache.pendingEntries) {
+        Entry &entry = entries[offset];
+        if (pendingEntry.symbolState != State::Unknown) {
+            entry.symbolState = pendingEntry.symbolState;
+            entry.symbolName = pendingEntry.symbolName;
+        }
+        if (pendingEntry.sourceLocationState != State::Unknown) {
+            entry.sourceLocationState = pendingEntry.sourceLocationState;
+            entry.fileName = pendingEntry.fileName;
+            entry.fileLine = pendingEntry.fileLine;
+        }
+    }
+
+    // Serialize entries, deduplicating strings. Many frames share the same file name.
+    std::vector<FileEntry> fileEntries{};
+    fileEntries.reserve(entries.size());
+    std::string strings{};
+    std::unordered_map<std::string, uint32_t> stringOffsets{};
+    auto addString = [&](State state, const std::string &string) -> uint32_t {
+        if (state != State::Resolved) {
+            return state == State::Unresolved ? stringOffsetUnresolved : stringOffsetUnknown;
+        }
+        auto [it, inserted] = stringOffsets.try_emplace(string, static_cast<uint32_t>(strings.size()));
+        if (inserted) {
+            strings.append(string.c_str(), string.size() + 1);
+        }
+        return it->second;
+    };
+    for (const auto &[offset, entry] : entries) {
+        FileEntry fileEntry{};
+        fileEntry.offset = offset;
+        fileEntry.symbolName = addString(entry.symbolState, entry.symbolName);
+        fileEntry.fileName = addString(entry.sourceLocationState, entry.fileName);
+        fileEntry.fileLine = static_cast<uint32_t>(entry.fileLine);
+        fileEntries.push_back(fileEntry);
+    }
+
+    FileHeader header{};
+    memcpy(header.magic, fileMagic, sizeof(fileMagic));
+    header.version = fileVersion;
+    header.entriesCount = static_cast<uint32_t>(fileEntries.size());
+    header.stringsSize = strings.size();
+
+    // Write to a temporary file and replace the old one, so other processes never see partially written files.
+    // Old file has to be unmapped first, because some systems do not allow replacing mapped files.
+    cache.file.reset();
+    cache.entries = nullptr;
+    cache.entriesCount = 0;
+    const std::string temporaryPath = path + ".tmp" + std::to_string(std::random_device{}());
+    {
+        std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(fileEntries.data()), fileEntries.size() * sizeof(FileEntry));
+        file.write(strings.data(), strings.size());
+        if (!file.good()) {
+            file.close();
+            std::error_code error{};
+            std::filesystem::remove(temporaryPath, error);
+            return false;
+        }
+    }
+
+    std::error_code error{};
+    std::filesystem::rename(temporaryPath, path, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        return false;
+    }
+    return true;
+}
+} // namespace Oakum
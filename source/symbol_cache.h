@@ -0,0 +1,94 @@
+#pragma once
+
+#include "source/mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace Oakum {
+
+// Persistent cache of symbolization results. Results are stored per module, identified by its build id, and keyed
+// by module-relative addresses, so they are valid for every process running the same binary regardless of address
+// space layout. Each module has a single file containing a header, an array of entries sorted by address and a pool
+// of null-terminated strings. Files are mapped into memory and searched in place. New results are kept in memory and
+// written by flush(), which merges them with the current contents of the file and replaces it atomically, so concurrent
+// processes never see partially written files and keep each other's results.
+// Empty directory selects a cache living only in memory, which is used to share results within a single process.
+class SymbolCache {
+public:
+    struct SourceLocation {
+        const char *fileName; // null if the location could not be resolved
+        size_t fileLine;
+    };
+
+    SymbolCache(const std::string &directory);
+
+    bool isPersistent() const { return !directory.empty(); }
+
+    std::optional<const char *> findSymbol(const std::string &moduleId, uint64_t offset);
+    std::optional<SourceLocation> findSourceLocation(const std::string &moduleId, uint64_t offset);
+    void storeSymbol(const std::string &moduleId, uint64_t offset, const char *symbolName);
+    void storeSourceLocation(const std::string &moduleId, uint64_t offset, const char *fileName, size_t fileLine);
+    void flush();
+
+protected:
+    enum class State : uint8_t {
+        Unknown,
+        Unresolved,
+        Resolved,
+    };
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t entriesCount;
+        uint64_t stringsSize;
+    };
+    struct FileEntry {
+        uint64_t offset;
+        uint32_t symbolName; // offset in string pool or one of string offset markers below
+        uint32_t fileName;   // offset in string pool or one of string offset markers below
+        uint32_t fileLine;
+        uint32_t reserved;
+    };
+    constexpr static inline uint32_t stringOffsetUnknown = UINT32_MAX;
+    constexpr static inline uint32_t stringOffsetUnresolved = UINT32_MAX - 1;
+    constexpr static inline char fileMagic[8] = {'O', 'A', 'K', 'U', 'M', 'S', 'C', '\0'};
+    constexpr static inline uint32_t fileVersion = 1;
+
+    struct Entry {
+        State symbolState = State::Unknown;
+        std::string symbolName = {};
+        State sourceLocationState = State::Unknown;
+        std::string fileName = {};
+        size_t fileLine = 0;
+    };
+
+    struct ModuleCache {
+        std::unique_ptr<MappedFile> file = {};
+        const FileEntry *entries = nullptr;
+        size_t entriesCount = 0;
+        const char *strings = nullptr;
+        size_t stringsSize = 0;
+        std::map<uint64_t, Entry> pendingEntries = {};
+    };
+
+    ModuleCache &getModuleCache(const std::string &moduleId);
+    std::string getModuleCachePath(const std::string &moduleId) const;
+    static void loadFile(ModuleCache &cache, std::unique_ptr<MappedFile> &&file);
+    static const FileEntry *findFileEntry(const ModuleCache &cache, uint64_t offset);
+    const char *getFileString(const ModuleCache &cache, uint32_t stringOffset, State &outState) const;
+    bool writeFile(const std::string &moduleId, ModuleCache &cache);
+
+    const std::string directory;
+    std::mutex lock = {};
+    std::unordered_map<std::string, ModuleCache> modules = {};
+};
+
+} // namespace Oakum
@@ -2,6 +2,7 @@
 
 #ifdef __linux__
 #include "source/linux/child_process.h"
+#include "source/linux/elf_symbol_table.h"
 
 #include <cxxabi.h>
 #include <dlfcn.h>
@@ -20,12 +21,12 @@ struct Syscalls {
     using DemangleSymbolT = std::function<char *(const char *mangled_name, char *output_buffer, size_t *length, int *status)>;
     using RunProcessForOutputT = std::function<std::string(std::string_view binaryName, std::initializer_list<std::string_view> args)>;
     using DladdrT = std::function<int(const void *addr, Dl_info *info)>;
-    using Dladdr1T = std::function<int(const void *addr, Dl_info *info, void **extra_info, int flags)>;
+    using LookupElfSymbolT = std::function<const char *(const char *modulePath, uintptr_t offset)>;
 
     DemangleSymbolT demangleSymbol = ::abi::__cxa_demangle;
     RunProcessForOutputT runProcessForOutput = ChildProcess::runForOutput;
     DladdrT dladdr = ::dladdr;
-    Dladdr1T dladdr1 = ::dladdr1;
+    LookupElfSymbolT lookupElfSymbol = ElfSymbolResolver::lookup;
 #elif _WIN32
     using SymFromAddrT = std::function<BOOL(HANDLE hProcess, DWORD64 Address, PDWORD64 Displacement, PSYMBOL_INFO Symbol)>;
     using SymGetLineFromAddr64T = std::function<BOOL(HANDLE hProcess, DWORD64 qwAddr, PDWORD pdwDisplacement, PIMAGEHLP_LINE64 Line64)>;
@@ -0,0 +1,41 @@
+#include "source/oakum_controller.h"
+#include "source/thread_registry.h"
+
+namespace Oakum {
+ThreadRegistry::Thread &ThreadRegistry::registerCurrentThread() {
+    // Registry lives until deinitialization, so it must not be reported as a leak
+    RaiiOakumIgnore raiiIgnore{};
+    auto thread = std::make_unique<Thread>();
+    thread->id = getCurrentThreadId();
+    std::string name{};
+    const bool hasName = getCurrentThreadName(name);
+
+    std::lock_guard lockGuard{lock};
+    if (hasName) {
+        thread->name.store(internName(name), std::memory_order_relaxed);
+    }
+    threads.push_back(std::move(thread));
+    return *threads.back();
+}
+
+void ThreadRegistry::refreshNames() {
+    // Threads are often named after they have started allocating, e.g. by a thread pool, so names are read again for reports.
+    // Names of threads, which have already exited, are kept as they were.
+    RaiiOakumIgnore raiiIgnore{};
+    std::lock_guard lockGuard{lock};
+    std::string name{};
+    for (const std::unique_ptr<Thread> &thread : threads) {
+        if (thread->exited.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        if (getThreadName(thread->id, name) && name != thread->name.load(std::memory_order_relaxed)) {
+            thread->name.store(internName(name), std::memory_order_relaxed);
+        }
+    }
+}
+
+const char *ThreadRegistry::internName(const std::string &name) {
+    // Must be called with lock held
+    return names.insert(name).first->c_str();
+}
+} // namespace Oakum
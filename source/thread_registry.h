@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Oakum {
+
+// Threads, which have made tracked allocations, along with their live allocation counters. Each thread is registered
+// once, by itself, on its first tracked allocation and then updates its counters with relaxed atomics. Counters are
+// decremented by whichever thread frees the memory, so they describe memory allocated by the thread, which is still
+// live. Thread names are interned and kept until deinitialization, so reports can point at them without copying.
+class ThreadRegistry {
+public:
+    struct Thread {
+        uint64_t id = 0;
+        std::atomic<const char *> name = "";
+        std::atomic<size_t> liveAllocationsCount = 0;
+        std::atomic<size_t> liveBytes = 0;
+        std::atomic<uint64_t> totalAllocationsCount = 0;
+        std::atomic<bool> exited = false; // id could have been reused by another thread, so the name is not read anymore
+    };
+
+    Thread &registerCurrentThread();
+    static void markExited(Thread &thread) { thread.exited.store(true, std::memory_order_relaxed); }
+    void refreshNames();
+
+    template <typename FunctionT>
+    void forEachThread(FunctionT &&function) {
+        std::lock_guard lockGuard{lock};
+        for (const std::unique_ptr<Thread> &thread : threads) {
+            function(static_cast<const Thread &>(*thread));
+        }
+    }
+
+protected:
+    const char *internName(const std::string &name);
+
+    static uint64_t getCurrentThreadId();
+    static bool getCurrentThreadName(std::string &outName);
+    static bool getThreadName(uint64_t threadId, std::string &outName);
+
+    std::mutex lock = {};
+    std::vector<std::unique_ptr<Thread>> threads = {};
+    std::unordered_set<std::string> names = {}; // nodes are never moved, so pointers to the strings stay valid
+};
+
+} // namespace Oakum
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <mutex>
+
+namespace Oakum {
+
+enum class ThreadSafetyMode {
+    Runtime,        // Locking is enabled with OakumInitArgs::threadSafe
+    SingleThreaded, // Locking is compiled out. OakumInitArgs::threadSafe is ignored.
+    Mutex,          // Locking is always enabled. OakumInitArgs::threadSafe is ignored.
+};
+
+template <ThreadSafetyMode mode>
+struct ThreadSafetyPolicy;
+
+template <>
+struct ThreadSafetyPolicy<ThreadSafetyMode::Runtime> {
+    static bool isThreadSafe(bool requested) { return requested; }
+
+    template <typename MutexT>
+    static std::unique_lock<MutexT> lock(MutexT &mutex, bool threadSafe) {
+        std::unique_lock lock{mutex, std::defer_lock};
+        if (threadSafe) {
+            lock.lock();
+        }
+        return lock;
+    }
+};
+
+template <>
+struct ThreadSafetyPolicy<ThreadSafetyMode::SingleThreaded> {
+    struct NoLock {
+        ~NoLock() {} // non-trivial, so compilers do not report lock variables as unused
+        bool owns_lock() const { return false; }
+    };
+
+    static bool isThreadSafe(bool) { return false; }
+
+    template <typename MutexT>
+    static NoLock lock(MutexT &, bool) {
+        return {};
+    }
+};
+
+template <>
+struct ThreadSafetyPolicy<ThreadSafetyMode::Mutex> {
+    static bool isThreadSafe(bool) { return true; }
+
+    template <typename MutexT>
+    static std::unique_lock<MutexT> lock(MutexT &mutex, bool) {
+        return std::unique_lock{mutex};
+    }
+};
+
+#if defined(OAKUM_THREAD_SAFETY_SINGLE_THREADED)
+using ThreadSafety = ThreadSafetyPolicy<ThreadSafetyMode::SingleThreaded>;
+#elif defined(OAKUM_THREAD_SAFETY_MUTEX)
+using ThreadSafety = ThreadSafetyPolicy<ThreadSafetyMode::Mutex>;
+#else
+using ThreadSafety = ThreadSafetyPolicy<ThreadSafetyMode::Runtime>;
+#endif
+
+} // namespace Oakum
@@ -0,0 +1,176 @@
+#include "source/thread_safety_policy.h"
+#include "source/trace_writer.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace Oakum {
+// Formats consecutive events into a buffer on the stack. Strings are truncated, so the buffer never overflows.
+class TraceWriter::EventBuilder {
+public:
+    void beginEvent(const char *name, const char *category, char phase, uint64_t timestamp, uint64_t processId, uint64_t threadId) {
+        if (size > 0) {
+            appendText(",\n");
+        }
+        appendText("{\"name\":");
+        appendString(name);
+        appendText(",\"cat\":\"");
+        appendText(category);
+        appendText("\",\"ph\":\"");
+        data[size++] = phase;
+        appendText("\",\"ts\":");
+        appendUnsigned(timestamp / 1000);
+        appendText(".");
+        const uint64_t fraction = timestamp % 1000; // timestamps are in microseconds
+        data[size++] = static_cast<char>('0' + fraction / 100);
+        data[size++] = static_cast<char>('0' + fraction / 10 % 10);
+        data[size++] = static_cast<char>('0' + fraction % 10);
+        appendText(",\"pid\":");
+        appendUnsigned(processId);
+        appendText(",\"tid\":");
+        appendUnsigned(threadId);
+    }
+
+    void appendText(const char *text) {
+        const size_t length = strlen(text);
+        memcpy(data + size, text, length);
+        size += length;
+    }
+
+    void appendUnsigned(uint64_t value) {
+        size = std::to_chars(data + size, data + capacity, value).ptr - data;
+    }
+
+    void appendString(const char *string) {
+        constexpr static const char *hexDigits = "0123456789abcdef";
+        data[size++] = '"';
+        for (size_t index = 0; string[index] != '\0' && index < maxStringLength; index++) {
+            const unsigned char character = static_cast<unsigned char>(string[index]);
+            if (character == '"' || character == '\\') {
+                data[size++] = '\\';
+                data[size++] = static_cast<char>(character);
+            } else if (character < 0x20) {
+                appendText("\\u00");
+                data[size++] = hexDigits[character >> 4];
+                data[size++] = hexDigits[character & 0xf];
+            } else {
+                data[size++] = static_cast<char>(character);
+            }
+        }
+        data[size++] = '"';
+    }
+
+    const char *getData() const { return data; }
+    size_t getSize() const { return size; }
+
+private:
+    constexpr static inline size_t maxStringLength = 256;
+    constexpr static inline size_t capacity = 2048; // enough for an event with a fully escaped string and a counter event
+
+    char data[capacity];
+    size_t size = 0;
+};
+
+TraceWriter::TraceWriter(const char *filePath, bool threadSafe)
+    : threadSafe(threadSafe),
+      processId(getCurrentProcessId()),
+      startTime(std::chrono::steady_clock::now()),
+      file(std::fopen(filePath, "wb")),
+      buffer(std::make_unique<char[]>(bufferCapacity)) {
+    if (file != nullptr) {
+        std::setvbuf(file, nullptr, _IONBF, 0); // events are already buffered
+        std::fputs("[\n", file);
+    }
+}
+
+TraceWriter::~TraceWriter() {
+    if (file == nullptr) {
+        return;
+    }
+    flushBuffer();
+    std::fputs("\n]\n", file);
+    std::fclose(file);
+}
+
+void TraceWriter::onAllocation(OakumAllocationIdType allocationId, size_t size, const char *scopeName, size_t liveBytes) {
+    writeAllocationEvent("alloc", allocationId, size, scopeName, liveBytes);
+}
+
+void TraceWriter::onDeallocation(OakumAllocationIdType allocationId, size_t size, const char *scopeName, size_t liveBytes) {
+    writeAllocationEvent("free", allocationId, size, scopeName, liveBytes);
+}
+
+void TraceWriter::onBeginScope(const char *scopeName) {
+    writeScopeEvent(scopeName, 'B');
+}
+
+void TraceWriter::onEndScope(const char *scopeName) {
+    writeScopeEvent(scopeName, 'E');
+}
+
+void TraceWriter::flush() {
+    const auto lockGuard = ThreadSafety::lock(lock, threadSafe);
+    flushBuffer();
+}
+
+uint64_t TraceWriter::getTimestamp() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void TraceWriter::writeAllocationEvent(const char *eventName, OakumAllocationIdType allocationId, size_t size, const char *scopeName, size_t liveBytes) {
+    const uint64_t timestamp = getTimestamp();
+    const uint64_t threadId = getCurrentThreadId();
+    EventBuilder events{};
+
+    events.beginEvent(eventName, "oakum", 'i', timestamp, processId, threadId);
+    events.appendText(",\"s\":\"t\",\"args\":{\"id\":");
+    events.appendUnsigned(allocationId);
+    events.appendText(",\"size\":");
+    events.appendUnsigned(size);
+    if (scopeName != nullptr) {
+        events.appendText(",\"scope\":");
+        events.appendString(scopeName);
+    }
+    events.appendText("}}");
+
+    // Counters are per process, so all threads update a single track
+    events.beginEvent("Live bytes", "oakum", 'C', timestamp, processId, threadId);
+    events.appendText(",\"args\":{\"bytes\":");
+    events.appendUnsigned(liveBytes);
+    events.appendText("}}");
+
+    writeEvents(events);
+}
+
+void TraceWriter::writeScopeEvent(const char *scopeName, char phase) {
+    EventBuilder events{};
+    events.beginEvent(scopeName, "oakum.scope", phase, getTimestamp(), processId, getCurrentThreadId());
+    events.appendText("}");
+    writeEvents(events);
+}
+
+void TraceWriter::writeEvents(const EventBuilder &events) {
+    constexpr static const char *separator = ",\n";
+    constexpr static size_t separatorLength = 2;
+
+    const auto lockGuard = ThreadSafety::lock(lock, threadSafe);
+    if (bufferSize + separatorLength + events.getSize() > bufferCapacity) {
+        flushBuffer();
+    }
+    if (hasEvents) {
+        memcpy(buffer.get() + bufferSize, separator, separatorLength);
+        bufferSize += separatorLength;
+    }
+    memcpy(buffer.get() + bufferSize, events.getData(), events.getSize());
+    bufferSize += events.getSize();
+    hasEvents = true;
+}
+
+void TraceWriter::flushBuffer() {
+    if (file != nullptr && bufferSize > 0) {
+        std::fwrite(buffer.get(), 1, bufferSize, file);
+    }
+    bufferSize = 0;
+}
+
+} // namespace Oakum
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "source/include/oakum/oakum_api.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+namespace Oakum {
+
+// Streams allocation, deallocation and scope events to a file in the Chrome trace event format (JSON array format),
+// which can be opened in Perfetto UI or chrome://tracing. Allocations and deallocations are instant events on the thread,
+// which made them, accompanied by a counter of live bytes. Scopes are duration events. Events are formatted on the stack
+// of the calling thread and appended to a fixed size buffer, which is written to the file once it is full, so memory usage
+// does not depend on the length of the trace. The closing bracket is optional in this format, so a trace of a process,
+// which has crashed, can still be opened.
+class TraceWriter {
+public:
+    TraceWriter(const char *filePath, bool threadSafe);
+    ~TraceWriter();
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter &operator=(const TraceWriter &) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    void onAllocation(OakumAllocationIdType allocationId, size_t size, const char *scopeName, size_t liveBytes);
+    void onDeallocation(OakumAllocationIdType allocationId, size_t size, const char *scopeName, size_t liveBytes);
+    void onBeginScope(const char *scopeName);
+    void onEndScope(const char *scopeName);
+    void flush();
+
+protected:
+    class EventBuilder;
+    static uint64_t getCurrentProcessId();
+    static uint64_t getCurrentThreadId();
+    uint64_t getTimestamp() const; // nanoseconds since the writer was created
+    void writeAllocationEvent(const char *eventName, OakumAllocationIdType allocationId, size_t size, const char *scopeName, size_t liveBytes);
+    void writeScopeEvent(const char *scopeName, char phase);
+    void writeEvents(const EventBuilder &events);
+    void flushBuffer();
+
+    constexpr static inline size_t bufferCapacity = 64 * 1024;
+
+    const bool threadSafe;
+    const uint64_t processId;
+    const std::chrono::steady_clock::time_point startTime;
+    std::FILE *file = nullptr;
+
+    std::mutex lock = {};
+    const std::unique_ptr<char[]> buffer;
+    size_t bufferSize = 0;
+    bool hasEvents = false;
+};
+
+} // namespace Oakum
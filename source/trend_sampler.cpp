@@ -0,0 +1,65 @@
+#include "source/trend_sampler.h"
+
+namespace Oakum {
+TrendSampler::TrendSampler(const CallSiteTable &callSites, std::chrono::milliseconds interval, size_t windowSamplesCount)
+    : callSites(callSites),
+      interval(interval),
+      windowSamplesCount(windowSamplesCount),
+      samples(std::make_unique<uint64_t[]>(CallSiteTable::getSitesCount() * windowSamplesCount)) {}
+
+TrendSampler::~TrendSampler() {
+    stop();
+}
+
+void TrendSampler::start() {
+    thread.start([this]() { run(); });
+}
+
+void TrendSampler::stop() {
+    thread.stop();
+}
+
+void TrendSampler::sample() {
+    std::lock_guard lockGuard{samplesLock};
+    const size_t slotIndex = samplesCount % windowSamplesCount;
+
+    // Sites are never released, so sites not visited here have had no allocations and keep zero samples
+    callSites.forEachCallSite([&](const CallSiteTable::CallSite &site) {
+        samples[callSites.getSiteIndex(site) * windowSamplesCount + slotIndex] = site.liveBytes.load(std::memory_order_relaxed);
+    });
+    samplesCount++;
+}
+
+std::vector<TrendSampler::GrowingSite> TrendSampler::getGrowingSites() {
+    std::vector<GrowingSite> result{};
+    std::lock_guard lockGuard{samplesLock};
+    if (samplesCount < windowSamplesCount) {
+        return result;
+    }
+
+    const uint64_t oldestSampleIndex = samplesCount - windowSamplesCount;
+    callSites.forEachCallSite([&](const CallSiteTable::CallSite &site) {
+        const uint64_t *siteSamples = samples.get() + callSites.getSiteIndex(site) * windowSamplesCount;
+        const uint64_t oldestLiveBytes = siteSamples[oldestSampleIndex % windowSamplesCount];
+        uint64_t previousLiveBytes = oldestLiveBytes;
+        for (uint64_t sampleIndex = oldestSampleIndex + 1; sampleIndex < samplesCount; sampleIndex++) {
+            const uint64_t liveBytes = siteSamples[sampleIndex % windowSamplesCount];
+            if (liveBytes < previousLiveBytes) {
+                return;
+            }
+            previousLiveBytes = liveBytes;
+        }
+        if (previousLiveBytes > oldestLiveBytes) {
+            result.push_back({&site, previousLiveBytes, previousLiveBytes - oldestLiveBytes});
+        }
+    });
+    return result;
+}
+
+void TrendSampler::run() {
+    auto lockGuard = thread.lock();
+    while (thread.waitFor(lockGuard, interval)) {
+        sample();
+    }
+}
+} // namespace Oakum
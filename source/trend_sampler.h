@@ -0,0 +1,51 @@
+#pragma once
+
+#include "source/background_thread.h"
+#include "source/call_site_table.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Oakum {
+
+// Periodically samples live bytes of every call site on a dedicated thread and keeps the last few samples of each site
+// in a ring buffer. Call site counters are read without locks, so allocating threads are never blocked by sampling.
+// A site is growing, if its live bytes never decreased within a full window of samples and ended higher than they
+// started, which is how slow leaks look in long running processes, which never reach a leak check at shutdown.
+class TrendSampler {
+public:
+    struct GrowingSite {
+        const CallSiteTable::CallSite *site = nullptr;
+        uint64_t liveBytes = 0;   // in the newest sample
+        uint64_t growthBytes = 0; // between the oldest and the newest sample
+    };
+
+    TrendSampler(const CallSiteTable &callSites, std::chrono::milliseconds interval, size_t windowSamplesCount);
+    ~TrendSampler();
+    TrendSampler(const TrendSampler &) = delete;
+    TrendSampler &operator=(const TrendSampler &) = delete;
+
+    void start();
+    void stop();
+    void sample();
+    std::vector<GrowingSite> getGrowingSites();
+
+protected:
+    void run();
+
+    const CallSiteTable &callSites;
+    const std::chrono::milliseconds interval;
+    const size_t windowSamplesCount;
+
+    std::mutex samplesLock = {};
+    const std::unique_ptr<uint64_t[]> samples; // windowSamplesCount consecutive samples per site, sample n is stored at n % windowSamplesCount
+    uint64_t samplesCount = 0;
+
+    BackgroundThread thread = {};
+};
+
+} // namespace Oakum
@@ -0,0 +1,9 @@
+#include "source/background_symbolizer.h"
+
+#include <Windows.h>
+
+namespace Oakum {
+void BackgroundSymbolizer::lowerThreadPriority() {
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+}
+} // namespace Oakum
@@ -0,0 +1,35 @@
+#include "source/mapped_file.h"
+
+#include <Windows.h>
+
+namespace Oakum {
+MappedFile::~MappedFile() {
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(osHandle));
+}
+
+std::unique_ptr<MappedFile> MappedFile::open(const char *path) {
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    CloseHandle(file);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+
+    return std::unique_ptr<MappedFile>{new MappedFile(static_cast<const uint8_t *>(view), static_cast<size_t>(fileSize.QuadPart), mapping)};
+}
+} // namespace Oakum
@@ -0,0 +1,39 @@
+#include "source/module_registry.h"
+
+#include <Windows.h>
+#include <Psapi.h>
+
+namespace Oakum {
+bool ModuleRegistry::getChangeCounters(uint64_t &, uint64_t &) {
+    return false; // there is no cheap way to detect loading and unloading of modules, so the list is always walked
+}
+
+bool ModuleRegistry::enumerateModules(std::vector<Module> &outModules) {
+    HANDLE process = GetCurrentProcess();
+
+    DWORD bytesNeeded = 0;
+    if (!EnumProcessModules(process, nullptr, 0, &bytesNeeded)) {
+        return false;
+    }
+    std::vector<HMODULE> handles(bytesNeeded / sizeof(HMODULE));
+    if (!EnumProcessModules(process, handles.data(), static_cast<DWORD>(handles.size() * sizeof(HMODULE)), &bytesNeeded)) {
+        return false;
+    }
+
+    for (HMODULE handle : handles) {
+        char modulePath[MAX_PATH] = {};
+        MODULEINFO moduleInfo = {};
+        if (GetModuleFileNameA(handle, modulePath, MAX_PATH) == 0 || !GetModuleInformation(process, handle, &moduleInfo, sizeof(moduleInfo))) {
+            continue;
+        }
+
+        Module module{};
+        module.path = modulePath;
+        module.baseAddress = reinterpret_cast<uintptr_t>(moduleInfo.lpBaseOfDll);
+        module.begin = module.baseAddress;
+        module.end = module.baseAddress + moduleInfo.SizeOfImage;
+        outModules.push_back(std::move(module));
+    }
+    return true;
+}
+} // namespace Oakum
@@ -0,0 +1,29 @@
+#include "source/query_server.h"
+
+namespace Oakum {
+void QueryServer::Response::flush() {
+    bufferSize = 0;
+}
+
+QueryServer::QueryServer(const char *socketPath, QueryFunction &&queryFunction)
+    : socketPath(socketPath),
+      queryFunction(std::move(queryFunction)) {}
+
+QueryServer::~QueryServer() {}
+
+bool QueryServer::isSupported() {
+    return false;
+}
+
+bool QueryServer::open() {
+    return false;
+}
+
+void QueryServer::start() {}
+
+void QueryServer::stop() {}
+
+void QueryServer::run() {}
+
+void QueryServer::serveClient(int) {}
+} // namespace Oakum
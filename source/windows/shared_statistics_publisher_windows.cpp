@@ -0,0 +1,13 @@
+#include "source/shared_statistics_publisher.h"
+
+namespace Oakum {
+bool SharedStatisticsPublisher::isSupported() {
+    return false;
+}
+
+bool SharedStatisticsPublisher::open() {
+    return false;
+}
+
+void SharedStatisticsPublisher::closePage() {}
+} // namespace Oakum
@@ -0,0 +1,21 @@
+#include "source/signal_reporter.h"
+
+namespace Oakum {
+SignalReporter::SignalReporter(int signalNumber, ReportFunction &&reportFunction)
+    : signalNumber(signalNumber),
+      reportFunction(std::move(reportFunction)) {}
+
+SignalReporter::~SignalReporter() {}
+
+bool SignalReporter::isSupported() {
+    return false; // Windows delivers only a few standard signals, none of which is suitable for requesting a report
+}
+
+void SignalReporter::start() {}
+
+void SignalReporter::stop() {}
+
+void SignalReporter::handleSignal(int) {}
+
+void SignalReporter::run() {}
+} // namespace Oakum
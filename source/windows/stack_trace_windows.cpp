@@ -1,25 +1,54 @@
 #include "source/error.h"
 #include "source/include/oakum/oakum_api.h"
+#include "source/report_arena.h"
 #include "source/stack_trace.h"
 #include "source/syscalls.h"
 
+#include <Psapi.h>
+#include <cstring>
+
 namespace Oakum {
-bool StackTraceHelper::supportsSourceLocations() {
-    return true;
-}
+bool StackTraceHelper::getModuleAddressRanges(const char *moduleName, std::vector<AddressRange> &outRanges) {
+    HANDLE process = GetCurrentProcess();
 
-void StackTraceHelper::captureFrames(OakumStackFrame *frames, size_t &framesCount) {
-    static thread_local void *frameAddresses[OAKUM_MAX_STACK_FRAMES_COUNT] = {};
-    framesCount = CaptureStackBackTrace(skippedFrames, OAKUM_MAX_STACK_FRAMES_COUNT, frameAddresses, nullptr);
+    DWORD bytesNeeded = 0;
+    if (!EnumProcessModules(process, nullptr, 0, &bytesNeeded)) {
+        return false;
+    }
+    std::vector<HMODULE> modules(bytesNeeded / sizeof(HMODULE));
+    if (!EnumProcessModules(process, modules.data(), static_cast<DWORD>(modules.size() * sizeof(HMODULE)), &bytesNeeded)) {
+        return false;
+    }
 
-    if (framesCount > 0) {
-        for (size_t frameIndex = 0; frameIndex < framesCount; frameIndex++) {
-            frames[frameIndex].address = frameAddresses[frameIndex];
+    bool found = false;
+    for (HMODULE module : modules) {
+        char modulePath[MAX_PATH] = {};
+        MODULEINFO moduleInfo = {};
+        if (GetModuleFileNameA(module, modulePath, MAX_PATH) == 0 || strstr(modulePath, moduleName) == nullptr) {
+            continue;
+        }
+        if (GetModuleInformation(process, module, &moduleInfo, sizeof(moduleInfo))) {
+            const uintptr_t begin = reinterpret_cast<uintptr_t>(moduleInfo.lpBaseOfDll);
+            outRanges.push_back({begin, begin + moduleInfo.SizeOfImage});
+            found = true;
         }
     }
+    return found;
 }
 
-bool StackTraceHelper::resolveSymbols(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSymbolName) {
+bool StackTraceHelper::supportsSourceLocations() {
+    return true;
+}
+
+void StackTraceHelper::captureFrames(size_t maxFramesCount, void **&outFrames, size_t &outFramesCount) {
+    static thread_local void *frameAddresses[OAKUM_STACK_FRAMES_COUNT_LIMIT] = {};
+    outFramesCount = CaptureStackBackTrace(skippedFrames, static_cast<DWORD>(maxFramesCount), frameAddresses, nullptr);
+    outFrames = frameAddresses;
+}
+
+bool StackTraceHelper::resolveSymbols(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSymbolName, SymbolCache *, ModuleRegistry &, ReportArena &strings, std::mutex *symbolCacheLock) {
+    // DbgHelp functions are not thread safe, so the whole resolution is serialized
+    std::unique_lock<std::mutex> lock = symbolCacheLock != nullptr ? std::unique_lock{*symbolCacheLock} : std::unique_lock<std::mutex>{};
     HANDLE process = GetCurrentProcess();
     SymInitialize(process, NULL, TRUE);
 
@@ -41,12 +70,12 @@ bool StackTraceHelper::resolveSymbols(OakumStackFrame *frames, size_t framesCoun
 
         if (syscalls.SymFromAddr(process, address, 0, &symbolInfo.asSymbolInfo)) {
             if (symbolInfo.asSymbolInfo.Name[0] != '\0') {
-                setupString(frame.symbolName, symbolInfo.asSymbolInfo.Name);
+                setupString(frame.symbolName, symbolInfo.asSymbolInfo.Name, strings);
             }
         }
         if (frame.symbolName == nullptr) {
             if (fallbackSymbolName.has_value()) {
-                setupString(frame.symbolName, fallbackSymbolName.value().c_str());
+                setupString(frame.symbolName, fallbackSymbolName.value().c_str(), strings);
             } else {
                 result = false;
             }
@@ -55,7 +84,10 @@ bool StackTraceHelper::resolveSymbols(OakumStackFrame *frames, size_t framesCoun
     return result;
 }
 
-bool StackTraceHelper::resolveSourceLocations(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSourceFileName) {
+bool StackTraceHelper::resolveSourceLocations(OakumStackFrame *frames, size_t framesCount, const std::optional<std::string> &fallbackSourceFileName, SymbolCache *, ModuleRegistry &, ReportArena &strings, std::mutex *symbolCacheLock) {
+    // DbgHelp functions are not thread safe, so the whole resolution is serialized
+    std::unique_lock<std::mutex> lock = symbolCacheLock != nullptr ? std::unique_lock{*symbolCacheLock} : std::unique_lock<std::mutex>{};
+
     // Initialize environment for querying source locations
     HANDLE process = GetCurrentProcess();
     SymInitialize(process, NULL, TRUE);
@@ -72,10 +104,10 @@ bool StackTraceHelper::resolveSourceLocations(OakumStackFrame *frames, size_t fr
         const DWORD64 address = reinterpret_cast<DWORD64>(frames[frameIndex].address);
 
         if (syscalls.SymGetLineFromAddr64(process, address, &displacement, &lineInfo)) {
-            setupString(frames[frameIndex].fileName, lineInfo.FileName);
+            setupString(frames[frameIndex].fileName, lineInfo.FileName, strings);
             frames[frameIndex].fileLine = lineInfo.LineNumber;
         } else if (fallbackSourceFileName.has_value()) {
-            setupString(frames[frameIndex].fileName, fallbackSourceFileName.value().c_str());
+            setupString(frames[frameIndex].fileName, fallbackSourceFileName.value().c_str(), strings);
         } else {
             result = false;
         }
@@ -0,0 +1,17 @@
+#include "source/thread_registry.h"
+
+#include <Windows.h>
+
+namespace Oakum {
+uint64_t ThreadRegistry::getCurrentThreadId() {
+    return static_cast<uint64_t>(GetCurrentThreadId());
+}
+
+bool ThreadRegistry::getCurrentThreadName(std::string &) {
+    return false;
+}
+
+bool ThreadRegistry::getThreadName(uint64_t, std::string &) {
+    return false;
+}
+} // namespace Oakum
@@ -0,0 +1,13 @@
+#include "source/trace_writer.h"
+
+#include <Windows.h>
+
+namespace Oakum {
+uint64_t TraceWriter::getCurrentProcessId() {
+    return static_cast<uint64_t>(GetCurrentProcessId());
+}
+
+uint64_t TraceWriter::getCurrentThreadId() {
+    return static_cast<uint64_t>(GetCurrentThreadId());
+}
+} // namespace Oakum
@@ -173,6 +173,10 @@ TEST_F(AcceptanceTest, givenThreadSafeWhenMultiThreadedAllocationsAreDoneThenCor
     initArgs.threadSafe = true;
     initArgs.trackStackTraces = true;
     EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
 
     auto threadFunction = []() {
         constexpr size_t allocCount = 20;
@@ -203,6 +207,10 @@ TEST_F(AcceptanceTest, givenThreadSafeWhenMultiThreadedAllocationsAreDoneThenCor
     initArgs.threadSafe = true;
     initArgs.trackStackTraces = true;
     EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
 
     auto threadFunction = []() {
         constexpr size_t allocCount = 20;
@@ -43,6 +43,12 @@ NO_INLINE_1 std::unique_ptr<char[]> allocateMemoryFunctionNoThrow(size_t size) {
     return allocateMemoryFunctionNoThrow1(size);
 }
 
+NO_INLINE_1 char *allocateMemoryFromCallSite(size_t size) {
+    char *memory = new char[size];
+    memory[0] = 0; // prevent tail call, so the return address points to this function
+    return memory;
+}
+
 const char *allocateMemoryFunctionFile = __FILE__;
 const size_t allocateMemoryFunctionDepth = 3;
 const char *allocateMemoryFunctionNames[] = {
@@ -15,6 +15,10 @@
 NO_INLINE_1 std::unique_ptr<char[]> allocateMemoryFunction(size_t size = 1);
 NO_INLINE_1 std::unique_ptr<char[]> allocateMemoryFunctionNoThrow(size_t size = 1);
 
+// Allocates memory from a single call site. Defined in a separate translation unit, so the compiler cannot specialize
+// it for constant arguments, which would create multiple call sites.
+NO_INLINE_1 char *allocateMemoryFromCallSite(size_t size);
+
 extern const char *allocateMemoryFunctionFile;
 extern const size_t allocateMemoryFunctionDepth;
 extern const char *allocateMemoryFunctionNames[];
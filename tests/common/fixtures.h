@@ -3,7 +3,10 @@
 #include "oakum/oakum_api.h"
 
 #include <algorithm>
+#include <filesystem>
 #include <gtest/gtest.h>
+#include <random>
+#include <string>
 
 #define EXPECT_OAKUM_SUCCESS(expr) EXPECT_EQ(OAKUM_SUCCESS, (expr))
 
@@ -37,9 +40,26 @@ struct OakumTest : ::testing::Test {
         return capabilities.supportStackTracesSymbols;
     }
 
+    bool isThreadSafe() {
+        OakumCapabilities capabilities = {};
+        EXPECT_OAKUM_SUCCESS(oakumGetCapabilities(&capabilities));
+        return capabilities.threadSafe;
+    }
+
     OakumInitArgs initArgs = {};
 };
 
+// Randomly named path in the temporary directory, so tests running in parallel do not collide. The string form is kept
+// alongside, because the library takes paths as C strings, which have to outlive the call.
+struct TemporaryPath {
+    TemporaryPath(const std::string &prefix, const std::string &extension = "")
+        : path(std::filesystem::temp_directory_path() / (prefix + std::to_string(std::random_device{}()) + extension)),
+          pathString(path.string()) {}
+
+    const std::filesystem::path path;
+    const std::string pathString;
+};
+
 struct SkippedTest : OakumTest {
     void SetUp() override {
         GTEST_SKIP();
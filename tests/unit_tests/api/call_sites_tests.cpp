@@ -0,0 +1,303 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+struct OakumCallSitesTest : OakumTest {
+    void SetUp() override {
+        initArgs.trackStackTraces = true;
+        initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_CALLER;
+    }
+
+    std::vector<OakumCallSite> getCallSites() {
+        size_t callSitesCount{};
+        EXPECT_OAKUM_SUCCESS(oakumGetCallSites(nullptr, &callSitesCount));
+        RaiiOakumIgnore ignore{};
+        std::vector<OakumCallSite> callSites(callSitesCount);
+        EXPECT_OAKUM_SUCCESS(oakumGetCallSites(callSites.data(), &callSitesCount));
+        callSites.resize(callSitesCount);
+        return callSites;
+    }
+};
+
+TEST_F(OakumCallSitesTest, givenOakumNotInitializedWhenCallingOakumGetCallSitesThenFail) {
+    size_t callSitesCount{};
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumGetCallSites(nullptr, &callSitesCount));
+}
+
+TEST_F(OakumCallSitesTest, givenNullCountWhenCallingOakumGetCallSitesThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumGetCallSites(nullptr, nullptr));
+}
+
+TEST_F(OakumCallSitesTest, givenFullStackTracesOrNoStackTracesWhenCallingOakumGetCallSitesThenReturnFeatureNotSupported) {
+    size_t callSitesCount{};
+
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_FULL;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumGetCallSites(nullptr, &callSitesCount));
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_CALLER;
+    initArgs.trackStackTraces = false;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumGetCallSites(nullptr, &callSitesCount));
+}
+
+TEST_F(OakumCallSitesTest, givenCallerModeWhenGettingAllocationsThenReturnSingleFrameWithCallerAddress) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::unique_ptr<char[]> memory{allocateMemoryFromCallSite(4)};
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    ASSERT_EQ(1u, allocations[0].stackFramesCount);
+    const char *callerAddress = static_cast<const char *>(allocations[0].stackFrames[0].address);
+    EXPECT_LT(reinterpret_cast<const char *>(allocateMemoryFromCallSite), callerAddress);
+    EXPECT_NE(OAKUM_UNKNOWN_MODULE_INDEX, allocations[0].stackFrames[0].moduleIndex);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumCallSitesTest, givenAllocationsFromTheSameCallSiteWhenCallingOakumGetCallSitesThenTheyAreAggregated) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::unique_ptr<char[]> memory0{allocateMemoryFromCallSite(4)};
+    std::unique_ptr<char[]> memory1{allocateMemoryFromCallSite(6)};
+    std::unique_ptr<char[]> memory2{allocateMemoryFromCallSite(7)};
+    memory2.reset();
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(2u, allocationCount);
+    void *callerAddress = allocations[0].stackFrames[0].address;
+    EXPECT_EQ(callerAddress, allocations[1].stackFrames[0].address);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+
+    size_t matchingCallSitesCount = 0u;
+    for (const OakumCallSite &callSite : getCallSites()) {
+        if (callSite.address == callerAddress) {
+            matchingCallSitesCount++;
+            EXPECT_EQ(2u, callSite.liveAllocationsCount);
+            EXPECT_EQ(10u, callSite.liveBytes);
+            EXPECT_EQ(3u, callSite.totalAllocationsCount);
+            EXPECT_EQ(17u, callSite.totalBytes);
+            EXPECT_NE(OAKUM_UNKNOWN_MODULE_INDEX, callSite.moduleIndex);
+        }
+    }
+    EXPECT_EQ(1u, matchingCallSitesCount);
+}
+
+TEST_F(OakumCallSitesTest, givenAllocationsFromDifferentCallSitesWhenCallingOakumGetCallSitesThenTheyAreSeparate) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::unique_ptr<char[]> memory0{allocateMemoryFromCallSite(4)};
+    auto memory1 = allocateMemoryFunction(6);
+
+    size_t liveBytes = 0u;
+    size_t liveAllocationsCount = 0u;
+    for (const OakumCallSite &callSite : getCallSites()) {
+        EXPECT_NE(nullptr, callSite.address);
+        liveBytes += callSite.liveBytes;
+        liveAllocationsCount += callSite.liveAllocationsCount;
+        if (callSite.liveAllocationsCount > 0) {
+            EXPECT_EQ(1u, callSite.liveAllocationsCount);
+        }
+    }
+    EXPECT_EQ(10u, liveBytes);
+    EXPECT_EQ(2u, liveAllocationsCount);
+}
+
+TEST_F(OakumCallSitesTest, givenAdaptiveModeWhenCallSiteReachesLiveAllocationsThresholdThenSubsequentAllocationsCaptureFullStackTraces) {
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_ADAPTIVE;
+    initArgs.sortAllocations = true;
+    initArgs.escalationLiveAllocationsCount = 2;
+    initArgs.escalationLiveBytes = 0;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::unique_ptr<char[]> memory0{allocateMemoryFromCallSite(4)};
+    std::unique_ptr<char[]> memory1{allocateMemoryFromCallSite(4)};
+    std::unique_ptr<char[]> memory2{allocateMemoryFromCallSite(4)};
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(3u, allocationCount);
+    EXPECT_EQ(1u, allocations[0].stackFramesCount);
+    EXPECT_EQ(1u, allocations[1].stackFramesCount);
+    EXPECT_LT(1u, allocations[2].stackFramesCount);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+
+    size_t escalatedCallSitesCount = 0u;
+    for (const OakumCallSite &callSite : getCallSites()) {
+        escalatedCallSitesCount += callSite.escalated;
+    }
+    EXPECT_EQ(1u, escalatedCallSitesCount);
+}
+
+TEST_F(OakumCallSitesTest, givenAdaptiveModeWhenCallSiteReachesLiveBytesThresholdThenSubsequentAllocationsCaptureFullStackTraces) {
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_ADAPTIVE;
+    initArgs.sortAllocations = true;
+    initArgs.escalationLiveAllocationsCount = 0;
+    initArgs.escalationLiveBytes = 100;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::unique_ptr<char[]> memory0{allocateMemoryFromCallSite(60)};
+    std::unique_ptr<char[]> memory1{allocateMemoryFromCallSite(30)};
+    std::unique_ptr<char[]> memory2{allocateMemoryFromCallSite(10)};
+    std::unique_ptr<char[]> memory3{allocateMemoryFromCallSite(10)};
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(4u, allocationCount);
+    EXPECT_EQ(1u, allocations[0].stackFramesCount);
+    EXPECT_EQ(1u, allocations[1].stackFramesCount);
+    EXPECT_EQ(1u, allocations[2].stackFramesCount);
+    EXPECT_LT(1u, allocations[3].stackFramesCount);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumCallSitesTest, givenCallerModeWhenCallSiteHasManyLiveAllocationsThenItIsNeverEscalated) {
+    initArgs.escalationLiveAllocationsCount = 1;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::unique_ptr<char[]> memory0{allocateMemoryFromCallSite(4)};
+    std::unique_ptr<char[]> memory1{allocateMemoryFromCallSite(4)};
+
+    for (const OakumCallSite &callSite : getCallSites()) {
+        EXPECT_FALSE(callSite.escalated);
+    }
+}
+
+struct OakumChurnCallSitesTest : OakumCallSitesTest {
+    void SetUp() override {
+        OakumCallSitesTest::SetUp();
+        initArgs.trackLifetimes = true;
+    }
+
+    std::vector<OakumCallSiteHistograms> getChurnCallSites(uint64_t maxLifetimeNs) {
+        size_t callSitesCount{};
+        EXPECT_OAKUM_SUCCESS(oakumGetChurnCallSites(maxLifetimeNs, nullptr, &callSitesCount));
+        RaiiOakumIgnore ignore{};
+        std::vector<OakumCallSiteHistograms> callSites(callSitesCount);
+        EXPECT_OAKUM_SUCCESS(oakumGetChurnCallSites(maxLifetimeNs, callSites.data(), &callSitesCount));
+        callSites.resize(callSitesCount);
+        return callSites;
+    }
+
+    constexpr static uint64_t oneHourNs = 3600ull * 1000 * 1000 * 1000;
+};
+
+TEST_F(OakumChurnCallSitesTest, givenOakumNotInitializedWhenCallingOakumGetChurnCallSitesThenFail) {
+    size_t callSitesCount{};
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumGetChurnCallSites(oneHourNs, nullptr, &callSitesCount));
+}
+
+TEST_F(OakumChurnCallSitesTest, givenNullCountWhenCallingOakumGetChurnCallSitesThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumGetChurnCallSites(oneHourNs, nullptr, nullptr));
+}
+
+TEST_F(OakumChurnCallSitesTest, givenLifetimesNotTrackedOrNoCallSitesWhenCallingOakumGetChurnCallSitesThenReturnFeatureNotSupported) {
+    size_t callSitesCount{};
+
+    initArgs.trackLifetimes = false;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumGetChurnCallSites(oneHourNs, nullptr, &callSitesCount));
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+
+    initArgs.trackLifetimes = true;
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_FULL;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumGetChurnCallSites(oneHourNs, nullptr, &callSitesCount));
+}
+
+TEST_F(OakumChurnCallSitesTest, givenShortLivedAllocationsWhenCallingOakumGetChurnCallSitesThenReturnSitesOrderedByShortLivedAllocations) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    for (int i = 0; i < 10; i++) {
+        delete[] allocateMemoryFromCallSite(100);
+    }
+    allocateMemoryFunction(4096).reset();
+    std::unique_ptr<char[]> liveMemory{allocateMemoryFromCallSite(5000)};
+
+    std::vector<OakumCallSiteHistograms> callSites = getChurnCallSites(oneHourNs);
+    ASSERT_EQ(2u, callSites.size());
+    EXPECT_EQ(10u, callSites[0].shortLivedAllocationsCount);
+    EXPECT_EQ(10u, callSites[0].freedAllocationsCount);
+    EXPECT_EQ(10u, callSites[0].sizes[6]);
+    EXPECT_NE(OAKUM_UNKNOWN_MODULE_INDEX, callSites[0].moduleIndex);
+    EXPECT_EQ(1u, callSites[1].shortLivedAllocationsCount);
+    EXPECT_EQ(1u, callSites[1].sizes[12]);
+    EXPECT_NE(callSites[0].address, callSites[1].address);
+
+    // Only the requested number of sites with the most short-lived allocations is copied
+    size_t callSitesCount = 1;
+    EXPECT_OAKUM_SUCCESS(oakumGetChurnCallSites(oneHourNs, callSites.data(), &callSitesCount));
+    EXPECT_EQ(1u, callSitesCount);
+    EXPECT_EQ(10u, callSites[0].shortLivedAllocationsCount);
+
+    // Lifetimes of one nanosecond are not measurable, so no allocation counts as short-lived
+    EXPECT_OAKUM_SUCCESS(oakumGetChurnCallSites(1u, nullptr, &callSitesCount));
+    EXPECT_EQ(0u, callSitesCount);
+
+    // Live allocations are counted, once they are freed
+    liveMemory.reset();
+    EXPECT_EQ(11u, getChurnCallSites(oneHourNs)[0].freedAllocationsCount);
+}
+
+TEST_F(OakumCallSitesTest, givenTrendSamplingDisabledOrNoCallSitesWhenCallingOakumGetGrowingCallSitesThenReturnFeatureNotSupported) {
+    size_t callSitesCount{};
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumGetGrowingCallSites(nullptr, &callSitesCount));
+
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumGetGrowingCallSites(nullptr, &callSitesCount));
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+
+    initArgs.trendSamplingIntervalMs = 1;
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_FULL;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumGetGrowingCallSites(nullptr, &callSitesCount));
+}
+
+TEST_F(OakumCallSitesTest, givenTooShortTrendWindowWhenInitializingThenReturnInvalidValue) {
+    initArgs.trendSamplingIntervalMs = 1;
+    initArgs.trendWindowSamplesCount = 1;
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumInit(&initArgs));
+}
+
+TEST_F(OakumCallSitesTest, givenTrendSamplingWhenLiveBytesKeepGrowingThenReturnGrowingCallSite) {
+    initArgs.trendSamplingIntervalMs = 1;
+    initArgs.trendWindowSamplesCount = 3;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    size_t callSitesCount{};
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumGetGrowingCallSites(nullptr, nullptr));
+
+    std::vector<std::unique_ptr<char[]>> memory{};
+    {
+        RaiiOakumIgnore ignore{};
+        memory.reserve(10000);
+    }
+    OakumGrowingCallSite growingCallSite{};
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (callSitesCount == 0 && memory.size() < memory.capacity() && std::chrono::steady_clock::now() < deadline) {
+        memory.emplace_back(allocateMemoryFromCallSite(16));
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        callSitesCount = 1;
+        EXPECT_OAKUM_SUCCESS(oakumGetGrowingCallSites(&growingCallSite, &callSitesCount));
+    }
+    const size_t allocatedBytes = memory.size() * 16;
+    memory.clear();
+
+    ASSERT_EQ(1u, callSitesCount);
+    EXPECT_NE(nullptr, growingCallSite.address);
+    EXPECT_NE(OAKUM_UNKNOWN_MODULE_INDEX, growingCallSite.moduleIndex);
+    EXPECT_LE(growingCallSite.liveBytes, allocatedBytes);
+    EXPECT_LT(0u, growingCallSite.growthBytes);
+    EXPECT_LE(growingCallSite.growthBytes, growingCallSite.liveBytes);
+}
@@ -1,3 +1,4 @@
+#include "source/thread_safety_policy.h"
 #include "tests/common/fixtures.h"
 
 using OakumCapabilitiesTest = OakumTest;
@@ -10,7 +11,7 @@ TEST_F(OakumCapabilitiesTest, givenDefaultInitArgsWhenQueryingCapabilitiesThenRe
     EXPECT_FALSE(capabilities.supportStackTraces);
     EXPECT_FALSE(capabilities.supportStackTracesSourceLocations);
     EXPECT_FALSE(capabilities.supportStackTracesSymbols);
-    EXPECT_FALSE(capabilities.threadSafe);
+    EXPECT_EQ(Oakum::ThreadSafety::isThreadSafe(false), capabilities.threadSafe);
 }
 
 TEST_F(OakumCapabilitiesTest, givenThreadSafetyRequestedWhenQueryingCapabilitiesThenReturnCapabilitiesWithThreadSafetyEnabled) {
@@ -22,7 +23,7 @@ TEST_F(OakumCapabilitiesTest, givenThreadSafetyRequestedWhenQueryingCapabilities
     EXPECT_FALSE(capabilities.supportStackTraces);
     EXPECT_FALSE(capabilities.supportStackTracesSourceLocations);
     EXPECT_FALSE(capabilities.supportStackTracesSymbols);
-    EXPECT_TRUE(capabilities.threadSafe);
+    EXPECT_EQ(Oakum::ThreadSafety::isThreadSafe(true), capabilities.threadSafe);
 }
 
 TEST_F(OakumCapabilitiesTest, givenStackTracesRequestedWhenQueryingCapabilitiesThenReturnCapabilitiesWithStackTraceTrackingEnabled) {
@@ -34,5 +35,5 @@ TEST_F(OakumCapabilitiesTest, givenStackTracesRequestedWhenQueryingCapabilitiesT
     EXPECT_TRUE(capabilities.supportStackTraces);
     EXPECT_EQ(bool(OAKUM_SOURCE_LOCATIONS_AVAILABLE), capabilities.supportStackTracesSourceLocations);
     EXPECT_EQ(bool(OAKUM_SYMBOLS_AVAILABLE), capabilities.supportStackTracesSymbols);
-    EXPECT_FALSE(capabilities.threadSafe);
+    EXPECT_EQ(Oakum::ThreadSafety::isThreadSafe(false), capabilities.threadSafe);
 }
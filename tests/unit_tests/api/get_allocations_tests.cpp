@@ -1,5 +1,9 @@
+#include "tests/common/allocate_memory_function.h"
 #include "tests/common/fixtures.h"
 
+#include <thread>
+#include <vector>
+
 struct OakumGetAllocationsTest : OakumTest {
     void validateStackFrames(OakumAllocation &allocation) {
         EXPECT_GE(allocation.stackFramesCount, 0u);
@@ -186,6 +190,99 @@ TEST_F(OakumGetAllocationsTest, givenStackTracesWhenCallingOakumGetAllocationsTh
     EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
 }
 
+TEST_F(OakumGetAllocationsTest, givenMaxStackFramesCountWhenCallingOakumGetAllocationsThenReturnAtMostThatManyFrames) {
+    initArgs.trackStackTraces = true;
+    initArgs.maxStackFramesCount = 2;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    auto memory = allocateMemoryFunction();
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_EQ(2u, allocations[0].stackFramesCount);
+    validateStackFrames(allocations[0]);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumGetAllocationsTest, givenDifferentMaxStackFramesCountsWhenCallingOakumGetAllocationsThenReturnDeeperStackTracesForHigherCounts) {
+    initArgs.trackStackTraces = true;
+    size_t framesCounts[2] = {};
+    const size_t maxStackFramesCounts[2] = {4, 64};
+    for (size_t i = 0; i < 2; i++) {
+        initArgs.maxStackFramesCount = maxStackFramesCounts[i];
+        EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+        auto memory = allocateMemoryFunction();
+
+        OakumAllocation *allocations = nullptr;
+        size_t allocationCount = 0u;
+        EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+        ASSERT_EQ(1u, allocationCount);
+        framesCounts[i] = allocations[0].stackFramesCount;
+        validateStackFrames(allocations[0]);
+        EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+
+        memory.reset();
+        EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+    }
+
+    EXPECT_EQ(4u, framesCounts[0]);
+    EXPECT_LT(framesCounts[0], framesCounts[1]);
+    EXPECT_GE(64u, framesCounts[1]);
+}
+
+TEST_F(OakumGetAllocationsTest, givenStackTracesFreedByAnotherThreadWhenAllocatingAgainThenStackTracesAreNotMixed) {
+    initArgs.trackStackTraces = true;
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    // Stack frame slots of the worker are freed by this thread, so they are reused for allocations made here
+    constexpr size_t allocationsCount = 64;
+    std::vector<std::unique_ptr<char[]>> workerMemory(allocationsCount);
+    std::thread thread{[&workerMemory]() {
+        for (auto &memory : workerMemory) {
+            memory = allocateMemoryFunction(1);
+        }
+    }};
+    thread.join();
+    for (size_t i = 0; i < allocationsCount; i += 2) {
+        workerMemory[i].reset();
+    }
+    std::vector<std::unique_ptr<char[]>> ownMemory(allocationsCount / 2);
+    for (auto &memory : ownMemory) {
+        memory = allocateMemoryFunction(2);
+    }
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    size_t checkedAllocationsCount = 0u;
+    const OakumAllocation *expectedAllocations[3] = {};
+    for (size_t i = 0u; i < allocationCount; i++) {
+        if (allocations[i].size > 2) {
+            continue; // vectors holding the memory
+        }
+        checkedAllocationsCount++;
+        const OakumAllocation *&expected = expectedAllocations[allocations[i].size];
+        if (expected == nullptr) {
+            expected = &allocations[i];
+            continue;
+        }
+        ASSERT_EQ(expected->stackFramesCount, allocations[i].stackFramesCount);
+        for (size_t frameIndex = 0u; frameIndex < expected->stackFramesCount; frameIndex++) {
+            EXPECT_EQ(expected->stackFrames[frameIndex].address, allocations[i].stackFrames[frameIndex].address);
+        }
+    }
+    EXPECT_EQ(allocationsCount, checkedAllocationsCount);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
 TEST_F(OakumGetAllocationsTest, givenOakumNotInitializedWhenCallingOakumDetectLeaksThenFail) {
     EXPECT_EQ(OAKUM_UNINITIALIZED, oakumReleaseAllocations(nullptr, 0u));
     EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
@@ -0,0 +1,96 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <vector>
+
+using OakumGetModulesTest = OakumTest;
+
+TEST_F(OakumGetModulesTest, givenOakumNotInitializedWhenCallingOakumGetModulesThenFail) {
+    size_t modulesCount{};
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumGetModules(nullptr, &modulesCount));
+}
+
+TEST_F(OakumGetModulesTest, givenNullCountWhenCallingOakumGetModulesThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumGetModules(nullptr, nullptr));
+}
+
+TEST_F(OakumGetModulesTest, givenNullModulesWhenCallingOakumGetModulesThenReturnModulesCount) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    size_t modulesCount{};
+    EXPECT_OAKUM_SUCCESS(oakumGetModules(nullptr, &modulesCount));
+    EXPECT_LT(0u, modulesCount);
+}
+
+TEST_F(OakumGetModulesTest, givenSmallerArrayWhenCallingOakumGetModulesThenFillOnlyAvailableEntries) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    size_t modulesCount{};
+    EXPECT_OAKUM_SUCCESS(oakumGetModules(nullptr, &modulesCount));
+    ASSERT_LT(1u, modulesCount);
+
+    OakumModule modules[2] = {};
+    modulesCount = 1;
+    EXPECT_OAKUM_SUCCESS(oakumGetModules(modules, &modulesCount));
+    EXPECT_EQ(1u, modulesCount);
+    EXPECT_NE(nullptr, modules[0].path);
+    EXPECT_EQ(nullptr, modules[1].path);
+}
+
+TEST_F(OakumGetModulesTest, givenStackTracesEnabledWhenGettingAllocationsThenFramesReferToModules) {
+    initArgs.trackStackTraces = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    auto memory = allocateMemoryFunction();
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+
+    size_t modulesCount{};
+    EXPECT_OAKUM_SUCCESS(oakumGetModules(nullptr, &modulesCount));
+    {
+        RaiiOakumIgnore ignore{};
+        std::vector<OakumModule> modules(modulesCount);
+        EXPECT_OAKUM_SUCCESS(oakumGetModules(modules.data(), &modulesCount));
+        ASSERT_LT(0u, allocations[0].stackFramesCount);
+        for (size_t i = 0; i < allocations[0].stackFramesCount; i++) {
+            const OakumStackFrame &frame = allocations[0].stackFrames[i];
+            ASSERT_LT(frame.moduleIndex, modulesCount);
+            const OakumModule &module = modules[frame.moduleIndex];
+            EXPECT_TRUE(module.loaded);
+            EXPECT_NE(nullptr, module.buildId);
+            EXPECT_LE(module.addressBegin, frame.address);
+            EXPECT_GT(module.addressEnd, frame.address);
+            EXPECT_EQ(frame.address, static_cast<char *>(module.baseAddress) + frame.moduleOffset);
+        }
+    }
+
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumGetModulesTest, givenStackTracesEnabledWhenGettingAllocationsTwiceThenFramesReferToTheSameModules) {
+    initArgs.trackStackTraces = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    auto memory = allocateMemoryFunction();
+    OakumAllocation *allocations0 = nullptr;
+    OakumAllocation *allocations1 = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations0, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations1, &allocationCount));
+    ASSERT_EQ(2u, allocationCount); // first report array is also an allocation
+
+    const OakumAllocation &allocation0 = allocations0[0];
+    const OakumAllocation &allocation1 = allocations1[0].pointer == allocation0.pointer ? allocations1[0] : allocations1[1];
+    ASSERT_EQ(allocation0.pointer, allocation1.pointer);
+    for (size_t i = 0; i < allocation0.stackFramesCount; i++) {
+        EXPECT_EQ(allocation0.stackFrames[i].moduleIndex, allocation1.stackFrames[i].moduleIndex);
+        EXPECT_EQ(allocation0.stackFrames[i].moduleOffset, allocation1.stackFrames[i].moduleOffset);
+    }
+
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations1, allocationCount));
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations0, 1u));
+}
@@ -0,0 +1,132 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define RETURN_ADDRESS() _ReturnAddress()
+#else
+#define RETURN_ADDRESS() __builtin_return_address(0)
+#endif
+
+using OakumIgnoreRulesTest = OakumTest;
+
+// Stores an address inside the calling function just after the call, so a rule can match only the frame of that function.
+// It writes the address instead of returning it, so the compiler cannot merge several calls into one.
+NO_INLINE_1 static void storeReturnAddress(void *&outAddress) {
+    outAddress = RETURN_ADDRESS();
+}
+
+// Sets the range of the rule to cover the call to allocateMemoryFunction, but not allocateMemoryFunction itself
+NO_INLINE_1 static std::unique_ptr<char[]> allocateMemoryWithinRange(OakumIgnoreRule &rule) {
+    storeReturnAddress(rule.addressBegin);
+    auto memory = allocateMemoryFunction();
+    storeReturnAddress(rule.addressEnd);
+    return memory;
+}
+
+TEST_F(OakumIgnoreRulesTest, givenOakumNotInitializedWhenCallingOakumAddIgnoreRuleThenFail) {
+    OakumIgnoreRule rule{};
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumAddIgnoreRule(&rule));
+}
+
+TEST_F(OakumIgnoreRulesTest, givenInvalidRuleWhenCallingOakumAddIgnoreRuleThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumAddIgnoreRule(nullptr));
+
+    OakumIgnoreRule rule{};
+    rule.type = static_cast<OakumIgnoreRuleType>(100);
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumAddIgnoreRule(&rule));
+
+    rule.type = OAKUM_IGNORE_RULE_MODULE;
+    rule.moduleName = nullptr;
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumAddIgnoreRule(&rule));
+
+    rule.type = OAKUM_IGNORE_RULE_ADDRESS_RANGE;
+    rule.addressBegin = reinterpret_cast<void *>(0x2000);
+    rule.addressEnd = reinterpret_cast<void *>(0x1000);
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumAddIgnoreRule(&rule));
+}
+
+TEST_F(OakumIgnoreRulesTest, givenModuleRuleForNotLoadedModuleWhenCallingOakumAddIgnoreRuleThenReturnResolvingFailed) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    OakumIgnoreRule rule{};
+    rule.type = OAKUM_IGNORE_RULE_MODULE;
+    rule.moduleName = "thisModuleDoesNotExist";
+    EXPECT_EQ(OAKUM_RESOLVING_FAILED, oakumAddIgnoreRule(&rule));
+}
+
+TEST_F(OakumIgnoreRulesTest, givenModuleRuleMatchingTestBinaryWhenMemoryIsAllocatedThenItIsNotRecorded) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    OakumIgnoreRule rule{};
+    rule.type = OAKUM_IGNORE_RULE_MODULE;
+    rule.moduleName = "OakumUnitTests";
+    EXPECT_OAKUM_SUCCESS(oakumAddIgnoreRule(&rule));
+
+    auto memory = allocateMemoryFunction();
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+    memory.reset();
+}
+
+TEST_F(OakumIgnoreRulesTest, givenAddressRangeRuleWhenMemoryIsAllocatedThenOnlyMatchingAllocationsAreNotRecorded) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    OakumIgnoreRule rule{};
+    rule.type = OAKUM_IGNORE_RULE_ADDRESS_RANGE;
+    rule.addressBegin = reinterpret_cast<void *>(0x1000);
+    rule.addressEnd = reinterpret_cast<void *>(0x2000);
+    EXPECT_OAKUM_SUCCESS(oakumAddIgnoreRule(&rule));
+
+    auto memory0 = allocateMemoryFunction();
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectLeaks());
+    memory0.reset();
+
+    rule.addressBegin = reinterpret_cast<void *>(0x1500);
+    rule.addressEnd = reinterpret_cast<void *>(UINTPTR_MAX);
+    EXPECT_OAKUM_SUCCESS(oakumAddIgnoreRule(&rule));
+
+    auto memory1 = allocateMemoryFunction();
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+    memory1.reset();
+}
+
+TEST_F(OakumIgnoreRulesTest, givenRuleMatchingOnlyDeeperFrameWhenMemoryIsAllocatedThenItIsRecordedOnlyIfDeeperFramesAreMatched) {
+    initArgs.ignoreRulesFramesCount = 1;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    OakumIgnoreRule rule{};
+    rule.type = OAKUM_IGNORE_RULE_ADDRESS_RANGE;
+    auto memory = allocateMemoryWithinRange(rule);
+    memory.reset();
+    EXPECT_OAKUM_SUCCESS(oakumAddIgnoreRule(&rule));
+
+    memory = allocateMemoryWithinRange(rule);
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectLeaks());
+    memory.reset();
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(false));
+
+    initArgs.ignoreRulesFramesCount = 0;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_OAKUM_SUCCESS(oakumAddIgnoreRule(&rule));
+    memory = allocateMemoryWithinRange(rule);
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+    memory.reset();
+}
+
+TEST_F(OakumIgnoreRulesTest, givenCallerOnlyMatchingWhenMemoryIsAllocatedByMatchingCallerThenItIsNotRecorded) {
+    initArgs.ignoreRulesFramesCount = 1;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    OakumIgnoreRule rule{};
+    rule.type = OAKUM_IGNORE_RULE_MODULE;
+    rule.moduleName = "OakumUnitTests";
+    EXPECT_OAKUM_SUCCESS(oakumAddIgnoreRule(&rule));
+
+    auto memory = allocateMemoryFunction();
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+    memory.reset();
+}
@@ -1,6 +1,8 @@
 #include "tests/common/allocate_memory_function.h"
 #include "tests/common/fixtures.h"
 
+#include <thread>
+
 using OakumIgnoreTest = OakumTest;
 
 TEST_F(OakumIgnoreTest, givenOakumNotInitializedWhenCallingOakumIgnoreFunctionsThenFail) {
@@ -79,3 +81,145 @@ TEST_F(OakumIgnoreTest, givenOakumStopIgnoreIsCalledWhenIgnoreCountIsZeroThenRet
 
     EXPECT_EQ(OAKUM_NOT_IGNORING, oakumStopIgnore());
 }
+
+TEST_F(OakumIgnoreTest, givenOakumNotInitializedWhenCallingOakumIgnoreTokenFunctionsThenFail) {
+    OakumIgnoreToken token{};
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumGetIgnoreToken(&token));
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumSetIgnoreToken(token));
+}
+
+TEST_F(OakumIgnoreTest, givenNullArgumentWhenCallingOakumGetIgnoreTokenThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumGetIgnoreToken(nullptr));
+}
+
+TEST_F(OakumIgnoreTest, givenIgnoreTokenFromIgnoringThreadWhenItIsSetOnAnotherThreadThenAllocationsAreNotRecorded) {
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    OakumIgnoreToken ignoringToken{};
+    OakumIgnoreToken nonIgnoringToken{};
+    EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&nonIgnoringToken));
+    EXPECT_OAKUM_SUCCESS(oakumStartIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&ignoringToken));
+
+    std::unique_ptr<char[]> memory0 = {};
+    std::unique_ptr<char[]> memory1 = {};
+    std::thread thread{[&]() {
+        EXPECT_OAKUM_SUCCESS(oakumSetIgnoreToken(ignoringToken));
+        memory0 = allocateMemoryFunction();
+        memory0.reset();
+        memory0 = allocateMemoryFunction();
+        EXPECT_OAKUM_SUCCESS(oakumSetIgnoreToken(nonIgnoringToken));
+        memory1 = allocateMemoryFunction();
+    }};
+    thread.join();
+    EXPECT_OAKUM_SUCCESS(oakumStopIgnore());
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_EQ(memory1.get(), allocations[0].pointer);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+
+    {
+        RaiiOakumIgnore ignore{};
+        memory0.reset();
+    }
+    memory1.reset();
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
+
+TEST_F(OakumIgnoreTest, givenIgnoreTokenOfEndedRegionWhenItIsSetOnAnotherThreadThenAllocationsAreRecorded) {
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    OakumIgnoreToken token{};
+    EXPECT_OAKUM_SUCCESS(oakumStartIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumStartIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&token));
+    EXPECT_OAKUM_SUCCESS(oakumStopIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumStopIgnore());
+
+    std::unique_ptr<char[]> memory = {};
+    std::thread thread{[&]() {
+        EXPECT_OAKUM_SUCCESS(oakumSetIgnoreToken(token));
+        memory = allocateMemoryFunction();
+    }};
+    thread.join();
+
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectLeaks());
+    memory.reset();
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
+
+TEST_F(OakumIgnoreTest, givenIgnoreRegionStartedAgainWhenGettingIgnoreTokenThenItDiffersFromTokenOfEndedRegion) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    OakumIgnoreToken token0{};
+    OakumIgnoreToken token1{};
+    OakumIgnoreToken token2{};
+    EXPECT_OAKUM_SUCCESS(oakumStartIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&token0));
+    EXPECT_OAKUM_SUCCESS(oakumStartIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&token1));
+    EXPECT_OAKUM_SUCCESS(oakumStopIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumStopIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumStartIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&token2));
+    EXPECT_OAKUM_SUCCESS(oakumStopIgnore());
+
+    EXPECT_NE(0u, token0);
+    EXPECT_EQ(token0, token1);
+    EXPECT_NE(token0, token2);
+}
+
+TEST_F(OakumIgnoreTest, givenThreadWithAdoptedIgnoreTokenWhenGettingIgnoreTokenThenReturnAdoptedToken) {
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    OakumIgnoreToken token{};
+    EXPECT_OAKUM_SUCCESS(oakumStartIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&token));
+
+    OakumIgnoreToken forwardedToken{};
+    std::thread thread{[&]() {
+        EXPECT_OAKUM_SUCCESS(oakumSetIgnoreToken(token));
+        EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&forwardedToken));
+    }};
+    thread.join();
+    EXPECT_OAKUM_SUCCESS(oakumStopIgnore());
+    EXPECT_EQ(token, forwardedToken);
+
+    thread = std::thread{[&]() {
+        EXPECT_OAKUM_SUCCESS(oakumSetIgnoreToken(token));
+        EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&forwardedToken));
+    }};
+    thread.join();
+    EXPECT_EQ(0u, forwardedToken);
+}
+
+TEST_F(OakumIgnoreTest, givenIgnoreTokenFromPreviousInitializationWhenItIsSetThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    OakumIgnoreToken token{};
+    EXPECT_OAKUM_SUCCESS(oakumStartIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumGetIgnoreToken(&token));
+    EXPECT_OAKUM_SUCCESS(oakumStopIgnore());
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(false));
+
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumSetIgnoreToken(token));
+}
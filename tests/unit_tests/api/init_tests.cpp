@@ -1,5 +1,6 @@
 #include "tests/common/allocate_memory_function.h"
 #include "tests/common/fixtures.h"
+#include "tests/unit_tests/mock_syscalls.h"
 
 TEST(OakumInitTest, givenOakumInitAndDeinitCalledWhenEnvironmentIsCleanThenSuccessIsReturned) {
     OakumInitArgs defaultInitArgs{};
@@ -18,6 +19,36 @@ TEST(OakumInitTest, givenOakumInitCalledMultipleTimesWhenEnvironmentIsCleanThenO
     EXPECT_OAKUM_SUCCESS(oakumDeinit(false));
 }
 
+TEST(OakumInitTest, givenTooManyStackFramesWhenOakumInitIsCalledThenReturnInvalidValue) {
+    OakumInitArgs initArgs{};
+    initArgs.maxStackFramesCount = OAKUM_STACK_FRAMES_COUNT_LIMIT + 1;
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumInit(&initArgs));
+
+    initArgs.maxStackFramesCount = OAKUM_STACK_FRAMES_COUNT_LIMIT;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(false));
+}
+
+TEST(OakumInitTest, givenTooManyIgnoreRulesFramesWhenOakumInitIsCalledThenReturnInvalidValue) {
+    OakumInitArgs initArgs{};
+    initArgs.ignoreRulesFramesCount = OAKUM_STACK_FRAMES_COUNT_LIMIT + 1;
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumInit(&initArgs));
+
+    initArgs.ignoreRulesFramesCount = OAKUM_STACK_FRAMES_COUNT_LIMIT;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(false));
+}
+
+TEST(OakumInitTest, givenUnknownStackTraceModeWhenOakumInitIsCalledThenReturnInvalidValue) {
+    OakumInitArgs initArgs{};
+    initArgs.stackTraceMode = static_cast<OakumStackTraceMode>(1234);
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumInit(&initArgs));
+
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_ADAPTIVE;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(false));
+}
+
 TEST(OakumInitTest, givenOakumDeinitCalledWhenOakumIsNotInitializedThenFail) {
     EXPECT_EQ(OAKUM_UNINITIALIZED, oakumDeinit(false));
 }
@@ -33,3 +64,14 @@ TEST(OakumInitTest, givenLeaksDetectionEnabledWhenOakumDeinitIsCalledThenDetectL
     memory.reset();
     EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
 }
+
+TEST(OakumInitTest, givenStackTracesEnabledWhenOakumInitIsCalledRepeatedlyThenNoChildProcessesAreSpawned) {
+    RaiiSyscallsBackup backup = MockSyscalls::mockChildProcessesForbidden();
+
+    OakumInitArgs initArgs{};
+    initArgs.trackStackTraces = true;
+    for (int i = 0; i < 3; i++) {
+        EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+        EXPECT_OAKUM_SUCCESS(oakumDeinit(false));
+    }
+}
@@ -79,6 +79,51 @@ TEST_F(OakumResolveStackTraceSymbolsSupportedTest, givenSymbolsResolvingSuccessW
     EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
 }
 
+TEST_F(OakumResolveStackTraceSymbolsSupportedTest, givenFramesWithTheSameSymbolWhenOakumResolveStackTraceSymbolsIsCalledThenTheyShareTheString) {
+    initArgs.trackStackTraces = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    RaiiSyscallsBackup backup = MockSyscalls::mockSymbolResolvingSuccess("mySymbol");
+
+    auto memory0 = allocateMemoryFunction();
+    auto memory1 = allocateMemoryFunction();
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(2u, allocationCount);
+
+    EXPECT_OAKUM_SUCCESS(oakumResolveStackTraceSymbols(allocations, allocationCount));
+    const char *symbolName = allocations[0].stackFrames[0].symbolName;
+    for (size_t allocationIndex = 0; allocationIndex < allocationCount; allocationIndex++) {
+        for (size_t i = 0; i < allocations[allocationIndex].stackFramesCount; i++) {
+            EXPECT_EQ(symbolName, allocations[allocationIndex].stackFrames[i].symbolName);
+        }
+    }
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumResolveStackTraceSymbolsSupportedTest, givenPartOfReportWhenOakumResolveStackTraceSymbolsIsCalledThenResolveOnlyThatPart) {
+    initArgs.trackStackTraces = true;
+    initArgs.sortAllocations = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    RaiiSyscallsBackup backup = MockSyscalls::mockSymbolResolvingSuccess("mySymbol");
+
+    auto memory0 = allocateMemoryFunction();
+    auto memory1 = allocateMemoryFunction();
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(2u, allocationCount);
+
+    EXPECT_OAKUM_SUCCESS(oakumResolveStackTraceSymbols(allocations + 1, 1u));
+    EXPECT_EQ(nullptr, allocations[0].stackFrames[0].symbolName);
+    EXPECT_STREQ("mySymbol", allocations[1].stackFrames[0].symbolName);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
 TEST_F(OakumResolveStackTraceSymbolsSupportedTest, givenSymbolsResolvingFailWhenOakumResolveStackTraceSymbolsIsCalledThenReturnError) {
     initArgs.trackStackTraces = true;
     EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
@@ -242,6 +287,32 @@ TEST_F(OakumResolveStackTraceSymbolsSupportedTest, givenSourceLocationsResolvedW
     EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
 }
 
+TEST_F(OakumResolveStackTraceSymbolsSupportedTest, givenBackgroundSymbolizationWhenOakumResolveStackTraceSymbolsIsCalledThenReturnCorrectStackTrace) {
+    initArgs.trackStackTraces = true;
+    initArgs.backgroundSymbolization = true;
+    initArgs.fallbackSymbolName = "<fallback>";
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    auto memory = allocateMemoryFunction();
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+
+    // Background thread may or may not have resolved the stack yet, the result has to be the same
+    EXPECT_OAKUM_SUCCESS(oakumResolveStackTraceSymbols(allocations, allocationCount));
+    size_t allocateMemoryFunctionFramesCount = 0u;
+    for (size_t i = 0; i < allocations[0].stackFramesCount; i++) {
+        allocateMemoryFunctionFramesCount += strstr(allocations[0].stackFrames[i].symbolName, "allocateMemoryFunction") != nullptr;
+    }
+    EXPECT_LE(allocateMemoryFunctionDepth, allocateMemoryFunctionFramesCount);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+
+    memory.reset();
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+}
+
 TEST_F(OakumResolveStackTraceSymbolsSupportedTest, givenStackTracesNotEnabledWhenCallingResolveStackTraceSymbolsThenReturnFeatureUnsupported) {
     EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
 
@@ -0,0 +1,112 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <thread>
+
+using OakumScopeTest = OakumTest;
+
+TEST_F(OakumScopeTest, givenOakumNotInitializedWhenCallingOakumScopeFunctionsThenFail) {
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumBeginScope("scope"));
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumEndScope());
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumDetectScopeLeaks("scope"));
+}
+
+TEST_F(OakumScopeTest, givenNullScopeNameWhenCallingOakumScopeFunctionsThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumBeginScope(nullptr));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumDetectScopeLeaks(nullptr));
+}
+
+TEST_F(OakumScopeTest, givenOakumEndScopeIsCalledWhenNotInScopeThenReturnError) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    EXPECT_EQ(OAKUM_NOT_IN_SCOPE, oakumEndScope());
+    EXPECT_OAKUM_SUCCESS(oakumBeginScope("scope"));
+    EXPECT_OAKUM_SUCCESS(oakumBeginScope("scope"));
+    EXPECT_OAKUM_SUCCESS(oakumEndScope());
+    EXPECT_OAKUM_SUCCESS(oakumEndScope());
+    EXPECT_EQ(OAKUM_NOT_IN_SCOPE, oakumEndScope());
+}
+
+TEST_F(OakumScopeTest, givenScopeWhenMemoryIsAllocatedInsideThenDetectLeaksOnlyInThatScope) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    auto memoryOutside = allocateMemoryFunction();
+
+    EXPECT_OAKUM_SUCCESS(oakumBeginScope("request"));
+    auto memoryInside = allocateMemoryFunction();
+    EXPECT_OAKUM_SUCCESS(oakumEndScope());
+
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectScopeLeaks("request"));
+    EXPECT_OAKUM_SUCCESS(oakumDetectScopeLeaks("unknownScope"));
+
+    memoryInside.reset();
+    EXPECT_OAKUM_SUCCESS(oakumDetectScopeLeaks("request"));
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectLeaks());
+}
+
+TEST_F(OakumScopeTest, givenNestedScopesWhenMemoryIsAllocatedThenItIsAttributedToInnermostScope) {
+    initArgs.sortAllocations = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    EXPECT_OAKUM_SUCCESS(oakumBeginScope("outer"));
+    auto memory0 = allocateMemoryFunction();
+    EXPECT_OAKUM_SUCCESS(oakumBeginScope("inner"));
+    auto memory1 = allocateMemoryFunction();
+    EXPECT_OAKUM_SUCCESS(oakumEndScope());
+    EXPECT_OAKUM_SUCCESS(oakumEndScope());
+    auto memory2 = allocateMemoryFunction();
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(3u, allocationCount);
+    EXPECT_STREQ("outer", allocations[0].scopeName);
+    EXPECT_STREQ("inner", allocations[1].scopeName);
+    EXPECT_EQ(nullptr, allocations[2].scopeName);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+
+    memory1.reset();
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectScopeLeaks("outer"));
+    EXPECT_OAKUM_SUCCESS(oakumDetectScopeLeaks("inner"));
+    memory0.reset();
+    EXPECT_OAKUM_SUCCESS(oakumDetectScopeLeaks("outer"));
+}
+
+TEST_F(OakumScopeTest, givenScopeEnteredOnOneThreadWhenMemoryIsAllocatedOnAnotherThreadThenItIsNotAttributedToTheScope) {
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    EXPECT_OAKUM_SUCCESS(oakumBeginScope("request"));
+    std::unique_ptr<char[]> memory = {};
+    std::thread thread{[&memory]() {
+        memory = allocateMemoryFunction();
+    }};
+    thread.join();
+    EXPECT_OAKUM_SUCCESS(oakumEndScope());
+
+    EXPECT_OAKUM_SUCCESS(oakumDetectScopeLeaks("request"));
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectLeaks());
+}
+
+TEST_F(OakumScopeTest, givenThreadCacheWhenScopedMemoryIsFreedThenScopeCounterIsUpdated) {
+    initArgs.threadCacheSize = 2;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    EXPECT_OAKUM_SUCCESS(oakumBeginScope("request"));
+    std::unique_ptr<char[]> memory[4] = {};
+    for (auto &allocation : memory) {
+        allocation = allocateMemoryFunction();
+    }
+    EXPECT_OAKUM_SUCCESS(oakumEndScope());
+
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectScopeLeaks("request"));
+    for (auto &allocation : memory) {
+        allocation.reset();
+    }
+    EXPECT_OAKUM_SUCCESS(oakumDetectScopeLeaks("request"));
+}
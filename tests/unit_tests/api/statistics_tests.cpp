@@ -0,0 +1,104 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <thread>
+
+using OakumStatisticsTest = OakumTest;
+
+TEST_F(OakumStatisticsTest, givenOakumNotInitializedWhenCallingOakumGetStatisticsThenFail) {
+    OakumStatistics statistics{};
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumGetStatistics(&statistics));
+}
+
+TEST_F(OakumStatisticsTest, givenNullArgumentWhenCallingOakumGetStatisticsThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumGetStatistics(nullptr));
+}
+
+TEST_F(OakumStatisticsTest, givenAllocationsAndDeallocationsWhenCallingOakumGetStatisticsThenReturnCorrectCounters) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    OakumStatistics statistics{};
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(0u, statistics.liveAllocationsCount);
+    EXPECT_EQ(0u, statistics.liveBytes);
+    EXPECT_EQ(0u, statistics.peakLiveBytes);
+    EXPECT_EQ(0u, statistics.totalAllocationsCount);
+    EXPECT_EQ(0u, statistics.totalDeallocationsCount);
+    EXPECT_EQ(0u, statistics.failedNoThrowAllocationsCount);
+
+    auto memory0 = allocateMemoryFunction(100);
+    auto memory1 = allocateMemoryFunction(30);
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(2u, statistics.liveAllocationsCount);
+    EXPECT_EQ(130u, statistics.liveBytes);
+    EXPECT_EQ(130u, statistics.peakLiveBytes);
+    EXPECT_EQ(2u, statistics.totalAllocationsCount);
+    EXPECT_EQ(0u, statistics.totalDeallocationsCount);
+
+    memory0.reset();
+    auto memory2 = allocateMemoryFunction(20);
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(2u, statistics.liveAllocationsCount);
+    EXPECT_EQ(50u, statistics.liveBytes);
+    EXPECT_EQ(130u, statistics.peakLiveBytes);
+    EXPECT_EQ(3u, statistics.totalAllocationsCount);
+    EXPECT_EQ(1u, statistics.totalDeallocationsCount);
+
+    memory1.reset();
+    memory2.reset();
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(0u, statistics.liveAllocationsCount);
+    EXPECT_EQ(0u, statistics.liveBytes);
+    EXPECT_EQ(130u, statistics.peakLiveBytes);
+    EXPECT_EQ(3u, statistics.totalAllocationsCount);
+    EXPECT_EQ(3u, statistics.totalDeallocationsCount);
+}
+
+TEST_F(OakumStatisticsTest, givenIgnoredAllocationsWhenCallingOakumGetStatisticsThenTheyAreNotCounted) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    {
+        RaiiOakumIgnore ignore{};
+        auto memory = allocateMemoryFunction(100);
+    }
+
+    OakumStatistics statistics{};
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(0u, statistics.totalAllocationsCount);
+    EXPECT_EQ(0u, statistics.totalDeallocationsCount);
+    EXPECT_EQ(0u, statistics.peakLiveBytes);
+}
+
+TEST_F(OakumStatisticsTest, givenFailedNoThrowAllocationWhenCallingOakumGetStatisticsThenItIsCounted) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    const size_t hugeSize = std::numeric_limits<size_t>::max() / 2;
+    EXPECT_EQ(nullptr, allocateMemoryFunctionNoThrow(hugeSize));
+
+    OakumStatistics statistics{};
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(1u, statistics.failedNoThrowAllocationsCount);
+    EXPECT_EQ(0u, statistics.totalAllocationsCount);
+}
+
+TEST_F(OakumStatisticsTest, givenMemoryFreedByAnotherThreadWhenCallingOakumGetStatisticsThenReturnCorrectCounters) {
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    auto memory = allocateMemoryFunction(10);
+    std::thread thread{[&memory]() {
+        memory.reset();
+    }};
+    thread.join();
+
+    OakumStatistics statistics{};
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(0u, statistics.liveAllocationsCount);
+    EXPECT_EQ(0u, statistics.liveBytes);
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
@@ -0,0 +1,185 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <thread>
+
+using OakumThreadCacheTest = OakumTest;
+
+TEST_F(OakumThreadCacheTest, givenThreadCacheWhenAllocationsAreMadeThenTheyAreReturnedByOakumGetAllocations) {
+    initArgs.threadCacheSize = 4;
+    initArgs.sortAllocations = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    // Some of these allocations will be spilled to the shared registry, the rest stays in the cache
+    std::unique_ptr<char[]> memory[6] = {};
+    for (auto &allocation : memory) {
+        allocation = allocateMemoryFunction();
+    }
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectLeaks());
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(6u, allocationCount);
+    for (size_t i = 0u; i < allocationCount; i++) {
+        EXPECT_EQ(i + 1, allocations[i].allocationId);
+        EXPECT_EQ(memory[i].get(), allocations[i].pointer);
+    }
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+
+    for (auto &allocation : memory) {
+        allocation.reset();
+    }
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
+
+TEST_F(OakumThreadCacheTest, givenThreadCacheWhenShortLivedAllocationsAreFreedThenNoLeaksAreDetected) {
+    initArgs.threadCacheSize = 4;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    for (size_t i = 0u; i < 20; i++) {
+        auto memory = allocateMemoryFunction();
+        EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectLeaks());
+    }
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
+
+TEST_F(OakumThreadCacheTest, givenThreadCacheWhenMemoryIsFreedByAnotherThreadThenNoLeaksAreDetected) {
+    initArgs.threadCacheSize = 4;
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    std::unique_ptr<char[]> memory = {};
+    std::thread thread{[&memory]() {
+        memory = allocateMemoryFunction();
+    }};
+    thread.join();
+    EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectLeaks());
+
+    memory.reset();
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
+
+TEST_F(OakumThreadCacheTest, givenThreadCacheWhenMultiThreadedAllocationsAreDoneThenCorrectlyDetectLeaks) {
+    initArgs.threadCacheSize = 8;
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    auto threadFunction = []() {
+        constexpr size_t allocCount = 20;
+        std::unique_ptr<char[]> allocs[allocCount] = {};
+        for (size_t i = 0; i < allocCount; i++) {
+            allocs[i] = allocateMemoryFunction();
+            EXPECT_EQ(OAKUM_LEAKS_DETECTED, oakumDetectLeaks());
+        }
+        for (size_t i = 0; i < allocCount; i++) {
+            allocs[i].reset();
+        }
+    };
+
+    constexpr size_t threadCount = 4;
+    std::thread threads[threadCount] = {};
+    for (size_t i = 0; i < threadCount; i++) {
+        threads[i] = std::thread{threadFunction};
+    }
+    for (size_t i = 0; i < threadCount; i++) {
+        threads[i].join();
+    }
+
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
+
+TEST_F(OakumThreadCacheTest, givenThreadCacheWhenThreadsExitThenTheirCachedAllocationsAreStillTracked) {
+    initArgs.threadCacheSize = 4;
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    // Each thread exits with its allocations still cached. The next thread reuses the released cache.
+    constexpr size_t threadCount = 8;
+    std::unique_ptr<char[]> memory[threadCount] = {};
+    for (size_t i = 0; i < threadCount; i++) {
+        std::thread thread{[&memory, i]() {
+            memory[i] = allocateMemoryFunction(i + 1);
+        }};
+        thread.join();
+    }
+
+    OakumStatistics statistics{};
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(threadCount, statistics.liveAllocationsCount);
+    for (size_t i = 0; i < threadCount; i++) {
+        memory[i].reset();
+    }
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(0u, statistics.liveAllocationsCount);
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
+
+TEST_F(OakumThreadCacheTest, givenThreadCacheWhenUntrackedMemoryIsFreedThenCountersAreNotChanged) {
+    initArgs.threadCacheSize = 4;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    auto trackedMemory = allocateMemoryFunction(7);
+    std::unique_ptr<char[]> untrackedMemory{};
+    {
+        RaiiOakumIgnore ignore{};
+        untrackedMemory = allocateMemoryFunction(5);
+    }
+    untrackedMemory.reset();
+
+    OakumStatistics statistics{};
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(1u, statistics.liveAllocationsCount);
+    EXPECT_EQ(7u, statistics.liveBytes);
+    EXPECT_EQ(0u, statistics.totalDeallocationsCount);
+}
+
+TEST_F(OakumThreadCacheTest, givenThreadCacheWhenAllocationsAreFreedOutOfOrderThenRemainingOnesAreReturnedByOakumGetAllocations) {
+    initArgs.threadCacheSize = 4;
+    initArgs.sortAllocations = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    // Freed allocations leave empty slots in the cache, which are skipped when the remaining ones are moved to the registry
+    constexpr size_t allocationsCount = 12;
+    std::unique_ptr<char[]> memory[allocationsCount] = {};
+    for (size_t i = 0u; i < allocationsCount; i++) {
+        memory[i] = allocateMemoryFunction(i + 1);
+        if (i % 3 == 1) {
+            memory[i - 1].reset();
+        }
+    }
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(allocationsCount / 3 * 2, allocationCount);
+    size_t allocationIndex = 0u;
+    for (size_t i = 0u; i < allocationsCount; i++) {
+        if (memory[i] != nullptr) {
+            EXPECT_EQ(memory[i].get(), allocations[allocationIndex].pointer);
+            EXPECT_EQ(i + 1, allocations[allocationIndex].size);
+            allocationIndex++;
+        }
+    }
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+
+    for (auto &allocation : memory) {
+        allocation.reset();
+    }
+    OakumStatistics statistics{};
+    EXPECT_OAKUM_SUCCESS(oakumGetStatistics(&statistics));
+    EXPECT_EQ(0u, statistics.liveAllocationsCount);
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
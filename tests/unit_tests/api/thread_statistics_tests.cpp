@@ -0,0 +1,146 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <thread>
+#include <vector>
+
+struct OakumThreadStatisticsTest : OakumTest {
+    void SetUp() override {
+        initArgs.trackThreads = true;
+    }
+
+    std::vector<OakumThreadStatistics> getThreadStatistics() {
+        size_t threadsCount{};
+        EXPECT_OAKUM_SUCCESS(oakumGetThreadStatistics(nullptr, &threadsCount));
+        RaiiOakumIgnore ignore{};
+        std::vector<OakumThreadStatistics> threads(threadsCount);
+        EXPECT_OAKUM_SUCCESS(oakumGetThreadStatistics(threads.data(), &threadsCount));
+        threads.resize(threadsCount);
+        return threads;
+    }
+
+    const OakumThreadStatistics *findThread(const std::vector<OakumThreadStatistics> &threads, uint64_t threadId) {
+        for (const OakumThreadStatistics &thread : threads) {
+            if (thread.threadId == threadId) {
+                return &thread;
+            }
+        }
+        return nullptr;
+    }
+
+    uint64_t getAllocatingThreadId(size_t size) {
+        OakumAllocation *allocations = nullptr;
+        size_t allocationCount = 0u;
+        EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+        uint64_t threadId = 0u;
+        for (size_t i = 0u; i < allocationCount; i++) {
+            if (allocations[i].size == size) {
+                threadId = allocations[i].threadId;
+                EXPECT_NE(nullptr, allocations[i].threadName);
+            }
+        }
+        EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+        return threadId;
+    }
+};
+
+TEST_F(OakumThreadStatisticsTest, givenOakumNotInitializedWhenCallingOakumGetThreadStatisticsThenFail) {
+    size_t threadsCount{};
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumGetThreadStatistics(nullptr, &threadsCount));
+}
+
+TEST_F(OakumThreadStatisticsTest, givenNullCountWhenCallingOakumGetThreadStatisticsThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumGetThreadStatistics(nullptr, nullptr));
+}
+
+TEST_F(OakumThreadStatisticsTest, givenThreadTrackingDisabledWhenCallingOakumGetThreadStatisticsThenReturnFeatureNotSupported) {
+    initArgs.trackThreads = false;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    size_t threadsCount{};
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumGetThreadStatistics(nullptr, &threadsCount));
+}
+
+TEST_F(OakumThreadStatisticsTest, givenThreadTrackingDisabledWhenGettingAllocationsThenThreadIsNotReported) {
+    initArgs.trackThreads = false;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    auto memory = allocateMemoryFunction(13);
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_EQ(0u, allocations[0].threadId);
+    EXPECT_EQ(nullptr, allocations[0].threadName);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumThreadStatisticsTest, givenAllocationsWhenCallingOakumGetThreadStatisticsThenReturnCountersOfAllocatingThread) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    auto memory1 = allocateMemoryFunction(13);
+    auto memory2 = allocateMemoryFunction(20);
+
+    std::vector<OakumThreadStatistics> threads = getThreadStatistics();
+    ASSERT_EQ(1u, threads.size());
+    EXPECT_NE(0u, threads[0].threadId);
+    EXPECT_EQ(2u, threads[0].liveAllocationsCount);
+    EXPECT_EQ(33u, threads[0].liveBytes);
+    EXPECT_EQ(2u, threads[0].totalAllocationsCount);
+
+    memory1.reset();
+    threads = getThreadStatistics();
+    ASSERT_EQ(1u, threads.size());
+    EXPECT_EQ(1u, threads[0].liveAllocationsCount);
+    EXPECT_EQ(20u, threads[0].liveBytes);
+    EXPECT_EQ(2u, threads[0].totalAllocationsCount);
+    EXPECT_EQ(threads[0].threadId, getAllocatingThreadId(20));
+}
+
+TEST_F(OakumThreadStatisticsTest, givenSmallerOutputArrayWhenCallingOakumGetThreadStatisticsThenCopyOnlyAsManyThreadsAsFit) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    auto memory = allocateMemoryFunction(13);
+
+    OakumThreadStatistics thread{};
+    size_t threadsCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetThreadStatistics(&thread, &threadsCount));
+    EXPECT_EQ(0u, threadsCount);
+}
+
+TEST_F(OakumThreadStatisticsTest, givenMemoryAllocatedByAnotherThreadWhenCallingOakumGetThreadStatisticsThenAttributeItToAllocatingThread) {
+    initArgs.threadSafe = true;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    std::unique_ptr<char[]> memory{};
+    std::thread thread{[&memory]() {
+        memory = allocateMemoryFunction(13);
+    }};
+    thread.join();
+
+    auto mainThreadMemory = allocateMemoryFunction(20);
+    const uint64_t workerThreadId = getAllocatingThreadId(13);
+    const uint64_t mainThreadId = getAllocatingThreadId(20);
+    EXPECT_NE(workerThreadId, mainThreadId);
+
+    std::vector<OakumThreadStatistics> threads = getThreadStatistics();
+    const OakumThreadStatistics *workerThread = findThread(threads, workerThreadId);
+    ASSERT_NE(nullptr, workerThread);
+    EXPECT_EQ(1u, workerThread->liveAllocationsCount);
+    EXPECT_EQ(13u, workerThread->liveBytes);
+    EXPECT_EQ(1u, workerThread->totalAllocationsCount);
+
+    // Memory freed by the main thread is still accounted to the thread, which allocated it
+    memory.reset();
+    threads = getThreadStatistics();
+    workerThread = findThread(threads, workerThreadId);
+    ASSERT_NE(nullptr, workerThread);
+    EXPECT_EQ(0u, workerThread->liveAllocationsCount);
+    EXPECT_EQ(0u, workerThread->liveBytes);
+    EXPECT_EQ(1u, workerThread->totalAllocationsCount);
+    const OakumThreadStatistics *mainThread = findThread(threads, mainThreadId);
+    ASSERT_NE(nullptr, mainThread);
+    EXPECT_EQ(20u, mainThread->liveBytes);
+}
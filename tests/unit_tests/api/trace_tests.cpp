@@ -0,0 +1,100 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+struct OakumTraceTest : OakumTest {
+    void SetUp() override {
+        initArgs.traceFilePath = tracePath.pathString.c_str();
+    }
+
+    void TearDown() override {
+        OakumTest::TearDown();
+        std::error_code error{};
+        std::filesystem::remove(tracePath.path, error);
+    }
+
+    std::string readTrace() {
+        std::ifstream file{tracePath.path, std::ios::binary};
+        return std::string{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    static size_t countOccurrences(const std::string &trace, const std::string &text) {
+        size_t result = 0;
+        for (size_t position = trace.find(text); position != std::string::npos; position = trace.find(text, position + 1)) {
+            result++;
+        }
+        return result;
+    }
+
+    const TemporaryPath tracePath{"OakumTraceTest", ".json"};
+};
+
+TEST_F(OakumTraceTest, givenUnwritableTracePathWhenInitializingThenReturnIoErrorAndStayUninitialized) {
+    const std::string path = (tracePath.path / "missing_directory" / "trace.json").string();
+    initArgs.traceFilePath = path.c_str();
+    EXPECT_EQ(OAKUM_IO_ERROR, oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumDetectLeaks());
+}
+
+TEST_F(OakumTraceTest, givenNoAllocationsWhenDeinitializingThenWriteEmptyArray) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+    EXPECT_EQ("[\n\n]\n", readTrace());
+}
+
+TEST_F(OakumTraceTest, givenAllocationsWhenDeinitializingThenWriteAllocationAndDeallocationEvents) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    delete[] allocateMemoryFromCallSite(13);
+    std::unique_ptr<char[]> memory{allocateMemoryFromCallSite(17)};
+    {
+        RaiiOakumIgnore ignore{};
+        delete[] allocateMemoryFromCallSite(19);
+    }
+    memory.reset();
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+
+    const std::string trace = readTrace();
+    EXPECT_EQ(0u, trace.find("[\n{"));
+    EXPECT_EQ(trace.size() - 4, trace.rfind("}\n]\n"));
+    EXPECT_EQ(2u, countOccurrences(trace, "{\"name\":\"alloc\""));
+    EXPECT_EQ(2u, countOccurrences(trace, "{\"name\":\"free\""));
+    EXPECT_EQ(4u, countOccurrences(trace, "{\"name\":\"Live bytes\",\"cat\":\"oakum\",\"ph\":\"C\""));
+    EXPECT_EQ(2u, countOccurrences(trace, "\"size\":13"));
+    EXPECT_EQ(2u, countOccurrences(trace, "\"size\":17"));
+    EXPECT_EQ(0u, countOccurrences(trace, "\"size\":19"));
+    EXPECT_EQ(1u, countOccurrences(trace, "\"args\":{\"bytes\":17}"));
+    EXPECT_EQ(trace.rfind("\"args\":{\"bytes\":"), trace.rfind("\"args\":{\"bytes\":0}"));
+}
+
+TEST_F(OakumTraceTest, givenScopesWhenAllocatingThenWriteScopeEventsAndScopeNames) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_OAKUM_SUCCESS(oakumBeginScope("request \"a\""));
+    delete[] allocateMemoryFromCallSite(3);
+    EXPECT_OAKUM_SUCCESS(oakumEndScope());
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+
+    const std::string trace = readTrace();
+    EXPECT_EQ(1u, countOccurrences(trace, "{\"name\":\"request \\\"a\\\"\",\"cat\":\"oakum.scope\",\"ph\":\"B\""));
+    EXPECT_EQ(1u, countOccurrences(trace, "{\"name\":\"request \\\"a\\\"\",\"cat\":\"oakum.scope\",\"ph\":\"E\""));
+    EXPECT_EQ(2u, countOccurrences(trace, "\"scope\":\"request \\\"a\\\"\""));
+    EXPECT_LT(trace.find("\"ph\":\"B\""), trace.find("\"name\":\"alloc\""));
+    EXPECT_LT(trace.find("\"name\":\"free\""), trace.find("\"ph\":\"E\""));
+}
+
+TEST_F(OakumTraceTest, givenManyAllocationsWhenTracingThenEventsAreWrittenBeforeDeinitialization) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    for (int i = 0; i < 1000; i++) {
+        delete[] allocateMemoryFromCallSite(8);
+    }
+    EXPECT_LT(1024u, std::filesystem::file_size(tracePath.path));
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+
+    const std::string trace = readTrace();
+    EXPECT_EQ(1000u, countOccurrences(trace, "{\"name\":\"alloc\""));
+    EXPECT_EQ(1000u, countOccurrences(trace, "{\"name\":\"free\""));
+}
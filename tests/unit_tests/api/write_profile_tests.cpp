@@ -0,0 +1,428 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Decodes the parts of profile.proto needed by the tests. Unknown fields are skipped.
+struct DecodedProfile {
+    std::vector<std::string> strings = {};
+    std::vector<std::pair<uint64_t, uint64_t>> sampleTypes = {}; // type and unit string indices
+    std::vector<std::vector<uint64_t>> sampleValues = {};
+    std::vector<std::vector<uint64_t>> sampleLocations = {};
+    size_t mappingsCount = 0;
+    size_t locationsCount = 0;
+    size_t functionsCount = 0;
+    bool valid = true;
+
+    bool hasString(const std::string &string) const {
+        return std::find(strings.begin(), strings.end(), string) != strings.end();
+    }
+
+    int findSampleType(const std::string &type) const {
+        for (size_t typeIndex = 0; typeIndex < sampleTypes.size(); typeIndex++) {
+            if (sampleTypes[typeIndex].first < strings.size() && strings[sampleTypes[typeIndex].first] == type) {
+                return static_cast<int>(typeIndex);
+            }
+        }
+        return -1;
+    }
+
+    uint64_t sumValues(const std::string &type) const {
+        const int typeIndex = findSampleType(type);
+        uint64_t sum = 0;
+        for (const std::vector<uint64_t> &values : sampleValues) {
+            sum += typeIndex >= 0 && static_cast<size_t>(typeIndex) < values.size() ? values[typeIndex] : 0;
+        }
+        return sum;
+    }
+};
+
+struct ProtobufReader {
+    const std::string &buffer;
+    size_t offset;
+    size_t end;
+
+    bool readVarint(uint64_t &value) {
+        value = 0;
+        for (unsigned int shift = 0; offset < end && shift < 64; shift += 7) {
+            const uint8_t byte = static_cast<uint8_t>(buffer[offset++]);
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename FieldFunctionT>
+    bool readFields(FieldFunctionT &&fieldFunction) {
+        while (offset < end) {
+            uint64_t tag{};
+            if (!readVarint(tag)) {
+                return false;
+            }
+            uint64_t value{};
+            if (!readVarint(value)) {
+                return false;
+            }
+            if ((tag & 7) == 2) {
+                if (value > end - offset) {
+                    return false;
+                }
+                fieldFunction(static_cast<uint32_t>(tag >> 3), 0u, ProtobufReader{buffer, offset, offset + value});
+                offset += value;
+            } else if ((tag & 7) == 0) {
+                fieldFunction(static_cast<uint32_t>(tag >> 3), value, ProtobufReader{buffer, offset, offset});
+            } else {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<uint64_t> readPackedVarints() {
+        std::vector<uint64_t> values{};
+        uint64_t value{};
+        while (offset < end && readVarint(value)) {
+            values.push_back(value);
+        }
+        return values;
+    }
+};
+
+struct OakumWriteProfileTest : OakumTest {
+    void SetUp() override {
+        initArgs.trackStackTraces = true;
+    }
+
+    void TearDown() override {
+        OakumTest::TearDown();
+        std::error_code error{};
+        std::filesystem::remove(profilePath.path, error);
+    }
+
+    DecodedProfile readProfile() {
+        RaiiOakumIgnore ignore{};
+        std::ifstream file{profilePath.path, std::ios::binary};
+        const std::string buffer{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        DecodedProfile profile{};
+        ProtobufReader reader{buffer, 0, buffer.size()};
+        profile.valid = reader.readFields([&](uint32_t field, uint64_t, ProtobufReader message) {
+            switch (field) {
+            case 1: {
+                std::pair<uint64_t, uint64_t> sampleType{};
+                message.readFields([&](uint32_t field, uint64_t value, ProtobufReader) {
+                    (field == 1 ? sampleType.first : sampleType.second) = value;
+                });
+                profile.sampleTypes.push_back(sampleType);
+                break;
+            }
+            case 2:
+                profile.sampleValues.emplace_back();
+                profile.sampleLocations.emplace_back();
+                message.readFields([&](uint32_t field, uint64_t, ProtobufReader values) {
+                    (field == 1 ? profile.sampleLocations : profile.sampleValues).back() = values.readPackedVarints();
+                });
+                break;
+            case 3:
+                profile.mappingsCount++;
+                break;
+            case 4:
+                profile.locationsCount++;
+                break;
+            case 5:
+                profile.functionsCount++;
+                break;
+            case 6:
+                profile.strings.push_back(message.buffer.substr(message.offset, message.end - message.offset));
+                break;
+            }
+        });
+        return profile;
+    }
+
+    std::vector<std::string> readFoldedStacks() {
+        RaiiOakumIgnore ignore{};
+        std::ifstream file{profilePath.path};
+        std::vector<std::string> lines{};
+        for (std::string line{}; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    static uint64_t sumFoldedStacks(const std::vector<std::string> &lines) {
+        uint64_t sum = 0;
+        for (const std::string &line : lines) {
+            sum += std::stoull(line.substr(line.find_last_of(' ') + 1));
+        }
+        return sum;
+    }
+
+    const TemporaryPath profilePath{"OakumWriteProfileTest", ".pb"};
+};
+
+TEST_F(OakumWriteProfileTest, givenOakumNotInitializedWhenCallingOakumWriteProfileThenFail) {
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumWriteProfile(OAKUM_PROFILE_FORMAT_PPROF, profilePath.pathString.c_str()));
+}
+
+TEST_F(OakumWriteProfileTest, givenInvalidArgumentsWhenCallingOakumWriteProfileThenReturnInvalidValue) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumWriteProfile(OAKUM_PROFILE_FORMAT_PPROF, nullptr));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumWriteProfile(static_cast<OakumProfileFormat>(100), profilePath.pathString.c_str()));
+}
+
+TEST_F(OakumWriteProfileTest, givenNoStackTracesWhenCallingOakumWriteProfileThenReturnFeatureNotSupported) {
+    initArgs.trackStackTraces = false;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumWriteProfile(OAKUM_PROFILE_FORMAT_PPROF, profilePath.pathString.c_str()));
+}
+
+TEST_F(OakumWriteProfileTest, givenUnwritablePathWhenCallingOakumWriteProfileThenReturnIoError) {
+    const std::string path = (profilePath.path / "missing_directory" / "profile.pb").string();
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_IO_ERROR, oakumWriteProfile(OAKUM_PROFILE_FORMAT_PPROF, path.c_str()));
+}
+
+TEST_F(OakumWriteProfileTest, givenNoAllocationsWhenWritingProfileThenWriteEmptyProfile) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_PPROF, profilePath.pathString.c_str()));
+
+    const DecodedProfile profile = readProfile();
+    ASSERT_TRUE(profile.valid);
+    ASSERT_FALSE(profile.strings.empty());
+    EXPECT_EQ("", profile.strings[0]);
+    EXPECT_EQ(0u, profile.sampleValues.size());
+    EXPECT_EQ(0, profile.findSampleType("inuse_objects"));
+    EXPECT_EQ(1, profile.findSampleType("inuse_space"));
+    EXPECT_EQ(-1, profile.findSampleType("alloc_space"));
+}
+
+TEST_F(OakumWriteProfileTest, givenLiveAllocationsWhenWritingProfileThenAggregateThemPerStackTrace) {
+    // Optimized builds may unroll the loop below, so only single frame stacks are guaranteed to be the same
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_CALLER;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::vector<std::unique_ptr<char[]>> memory{};
+    {
+        RaiiOakumIgnore ignore{};
+        memory.reserve(4);
+    }
+    for (int i = 0; i < 3; i++) {
+        memory.emplace_back(allocateMemoryFromCallSite(7));
+    }
+    memory.push_back(allocateMemoryFunction(5));
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_PPROF, profilePath.pathString.c_str()));
+    memory.clear();
+
+    const DecodedProfile profile = readProfile();
+    ASSERT_TRUE(profile.valid);
+    EXPECT_EQ(4u, profile.sumValues("inuse_objects"));
+    EXPECT_EQ(26u, profile.sumValues("inuse_space"));
+    EXPECT_EQ(2u, profile.sampleValues.size());
+    for (const std::vector<uint64_t> &locations : profile.sampleLocations) {
+        EXPECT_FALSE(locations.empty());
+        for (uint64_t locationId : locations) {
+            EXPECT_LE(1u, locationId);
+            EXPECT_GE(profile.locationsCount, locationId);
+        }
+    }
+    EXPECT_LT(0u, profile.mappingsCount);
+    EXPECT_TRUE(profile.hasString("inuse_space"));
+    EXPECT_TRUE(profile.hasString("bytes"));
+}
+
+TEST_F(OakumWriteProfileTest, givenSymbolsAvailableWhenWritingProfileThenWriteFunctionNames) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isSymbolLocationResolvingSupported()) {
+        GTEST_SKIP();
+    }
+
+    std::unique_ptr<char[]> memory{allocateMemoryFromCallSite(3)};
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_PPROF, profilePath.pathString.c_str()));
+    memory.reset();
+
+    const DecodedProfile profile = readProfile();
+    ASSERT_TRUE(profile.valid);
+    EXPECT_LT(0u, profile.functionsCount);
+    EXPECT_TRUE(std::any_of(profile.strings.begin(), profile.strings.end(), [](const std::string &string) {
+        return string.find("allocateMemoryFromCallSite") != std::string::npos;
+    }));
+}
+
+TEST_F(OakumWriteProfileTest, givenCallerModeWhenWritingProfileThenWriteCumulativeAllocations) {
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_CALLER;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    delete[] allocateMemoryFromCallSite(11);
+    std::unique_ptr<char[]> memory{allocateMemoryFromCallSite(13)};
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_PPROF, profilePath.pathString.c_str()));
+    memory.reset();
+
+    const DecodedProfile profile = readProfile();
+    ASSERT_TRUE(profile.valid);
+    EXPECT_EQ(2, profile.findSampleType("alloc_objects"));
+    EXPECT_EQ(3, profile.findSampleType("alloc_space"));
+    EXPECT_EQ(1u, profile.sumValues("inuse_objects"));
+    EXPECT_EQ(13u, profile.sumValues("inuse_space"));
+    EXPECT_LE(2u, profile.sumValues("alloc_objects"));
+    EXPECT_LE(24u, profile.sumValues("alloc_space"));
+}
+
+TEST_F(OakumWriteProfileTest, givenFullStackTracesWhenWritingFoldedTotalBytesThenReturnFeatureNotSupported) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumWriteProfile(OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES, profilePath.pathString.c_str()));
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES, profilePath.pathString.c_str()));
+}
+
+TEST_F(OakumWriteProfileTest, givenNoAllocationsWhenWritingFoldedStacksThenWriteEmptyFile) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES, profilePath.pathString.c_str()));
+    EXPECT_TRUE(readFoldedStacks().empty());
+}
+
+TEST_F(OakumWriteProfileTest, givenFullStackTracesWhenWritingFoldedLiveBytesThenWriteOneLinePerStackWithMultipleFrames) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::unique_ptr<char[]> memory{allocateMemoryFromCallSite(9)};
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES, profilePath.pathString.c_str()));
+    memory.reset();
+
+    const std::vector<std::string> lines = readFoldedStacks();
+    ASSERT_EQ(1u, lines.size());
+    EXPECT_EQ(" 9", lines[0].substr(lines[0].size() - 2));
+    EXPECT_NE(std::string::npos, lines[0].find(';'));
+    if (isSymbolLocationResolvingSupported()) {
+        // Callers are written before callees
+        const size_t testFrameBegin = lines[0].find("OakumWriteProfileTest");
+        ASSERT_NE(std::string::npos, testFrameBegin);
+        EXPECT_NE(std::string::npos, lines[0].find("allocateMemoryFromCallSite", testFrameBegin));
+    }
+}
+
+TEST_F(OakumWriteProfileTest, givenCallerModeWhenWritingFoldedStacksThenAggregateLiveAndTotalBytesPerCallSite) {
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_CALLER;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::vector<std::unique_ptr<char[]>> memory{};
+    {
+        RaiiOakumIgnore ignore{};
+        memory.reserve(4);
+    }
+    delete[] allocateMemoryFromCallSite(11);
+    for (int i = 0; i < 3; i++) {
+        memory.emplace_back(allocateMemoryFromCallSite(7));
+    }
+    memory.push_back(allocateMemoryFunction(5));
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES, profilePath.pathString.c_str()));
+    const std::vector<std::string> liveLines = readFoldedStacks();
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES, profilePath.pathString.c_str()));
+    const std::vector<std::string> totalLines = readFoldedStacks();
+    memory.clear();
+
+    EXPECT_EQ(2u, liveLines.size());
+    EXPECT_EQ(26u, sumFoldedStacks(liveLines));
+    EXPECT_LE(2u, totalLines.size());
+    EXPECT_LE(37u, sumFoldedStacks(totalLines));
+    for (const std::string &line : liveLines) {
+        EXPECT_EQ(std::string::npos, line.find(';'));
+    }
+}
+
+TEST_F(OakumWriteProfileTest, givenPeakSnapshotsDisabledWhenCallingPeakSnapshotApisThenReturnFeatureNotSupported) {
+    OakumPeakSnapshotInfo info{};
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumGetPeakSnapshotInfo(&info));
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumWritePeakProfile(OAKUM_PROFILE_FORMAT_PPROF, profilePath.pathString.c_str()));
+
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumGetPeakSnapshotInfo(&info));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumWritePeakProfile(OAKUM_PROFILE_FORMAT_PPROF, profilePath.pathString.c_str()));
+}
+
+TEST_F(OakumWriteProfileTest, givenInvalidArgumentsWhenCallingPeakSnapshotApisThenReturnError) {
+    initArgs.peakSnapshotMargin = 100;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumGetPeakSnapshotInfo(nullptr));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumWritePeakProfile(OAKUM_PROFILE_FORMAT_PPROF, nullptr));
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumWritePeakProfile(static_cast<OakumProfileFormat>(100), profilePath.pathString.c_str()));
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumWritePeakProfile(OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES, profilePath.pathString.c_str()));
+}
+
+TEST_F(OakumWriteProfileTest, givenNoStackTracesWhenUsingPeakSnapshotsThenReportInfoButDoNotWriteProfile) {
+    initArgs.trackStackTraces = false;
+    initArgs.peakSnapshotMargin = 100;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    delete[] allocateMemoryFromCallSite(150);
+    OakumPeakSnapshotInfo info{};
+    EXPECT_OAKUM_SUCCESS(oakumGetPeakSnapshotInfo(&info));
+    EXPECT_EQ(1u, info.capturesCount);
+    EXPECT_EQ(150u, info.liveBytes);
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumWritePeakProfile(OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES, profilePath.pathString.c_str()));
+}
+
+TEST_F(OakumWriteProfileTest, givenLiveBytesGrowingByMarginWhenAllocatingThenCaptureNewPeakSnapshot) {
+    initArgs.peakSnapshotMargin = 1000;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    OakumPeakSnapshotInfo info{};
+    EXPECT_OAKUM_SUCCESS(oakumGetPeakSnapshotInfo(&info));
+    EXPECT_EQ(0u, info.capturesCount);
+    EXPECT_OAKUM_SUCCESS(oakumWritePeakProfile(OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES, profilePath.pathString.c_str()));
+    EXPECT_TRUE(readFoldedStacks().empty());
+
+    std::unique_ptr<char[]> memory1{allocateMemoryFromCallSite(600)};
+    std::unique_ptr<char[]> memory2{allocateMemoryFromCallSite(400)};
+    EXPECT_OAKUM_SUCCESS(oakumGetPeakSnapshotInfo(&info));
+    EXPECT_EQ(1u, info.capturesCount);
+    EXPECT_EQ(2u, info.liveAllocationsCount);
+    EXPECT_EQ(1000u, info.liveBytes);
+    EXPECT_EQ(2u, info.stacksCount); // called from two places
+    const OakumAllocationIdType firstSnapshotAllocationId = info.lastAllocationId;
+
+    // Previous peak has to be exceeded by the margin
+    memory1.reset();
+    memory1.reset(allocateMemoryFromCallSite(1500));
+    EXPECT_OAKUM_SUCCESS(oakumGetPeakSnapshotInfo(&info));
+    EXPECT_EQ(1u, info.capturesCount);
+
+    std::unique_ptr<char[]> memory3{allocateMemoryFromCallSite(100)};
+    EXPECT_OAKUM_SUCCESS(oakumGetPeakSnapshotInfo(&info));
+    EXPECT_EQ(2u, info.capturesCount);
+    EXPECT_EQ(3u, info.liveAllocationsCount);
+    EXPECT_EQ(2000u, info.liveBytes);
+    EXPECT_EQ(firstSnapshotAllocationId + 2, info.lastAllocationId);
+}
+
+TEST_F(OakumWriteProfileTest, givenPeakSnapshotWhenAllocationsAreFreedThenWritePeakProfileWithAllocationsLiveAtPeak) {
+    initArgs.peakSnapshotMargin = 1000;
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    std::unique_ptr<char[]> memory{allocateMemoryFromCallSite(3000)};
+    memory.reset();
+    memory.reset(allocateMemoryFunction(5).release());
+    EXPECT_OAKUM_SUCCESS(oakumWritePeakProfile(OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES, profilePath.pathString.c_str()));
+    const std::vector<std::string> peakLines = readFoldedStacks();
+    EXPECT_OAKUM_SUCCESS(oakumWriteProfile(OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES, profilePath.pathString.c_str()));
+    const std::vector<std::string> currentLines = readFoldedStacks();
+    memory.reset();
+
+    ASSERT_EQ(1u, peakLines.size());
+    EXPECT_EQ(" 3000", peakLines[0].substr(peakLines[0].size() - 5));
+    if (isSymbolLocationResolvingSupported()) {
+        EXPECT_NE(std::string::npos, peakLines[0].find("allocateMemoryFromCallSite"));
+    }
+    ASSERT_EQ(1u, currentLines.size());
+    EXPECT_EQ(" 5", currentLines[0].substr(currentLines[0].size() - 2));
+
+    EXPECT_OAKUM_SUCCESS(oakumWritePeakProfile(OAKUM_PROFILE_FORMAT_PPROF, profilePath.pathString.c_str()));
+    const DecodedProfile profile = readProfile();
+    EXPECT_TRUE(profile.valid);
+    ASSERT_EQ(1u, profile.sampleValues.size());
+}
@@ -0,0 +1,110 @@
+#include "source/background_symbolizer.h"
+#include "tests/common/fixtures.h"
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct BackgroundSymbolizerTest : OakumTest {
+    void SetUp() override {
+        // Background thread marks its allocations as ignored, which requires an initialized library
+        EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    }
+
+    void TearDown() override {
+        symbolizer.stop();
+        OakumTest::TearDown();
+    }
+
+    std::vector<void *> getResolvedAddresses() {
+        std::lock_guard lockGuard{resolvedAddressesLock};
+        return resolvedAddresses;
+    }
+
+    std::mutex resolvedAddressesLock{};
+    std::vector<void *> resolvedAddresses{};
+    std::atomic<bool> pauseOnResolve = false;
+    Oakum::BackgroundSymbolizer symbolizer{[this](void *address) {
+        {
+            std::lock_guard lockGuard{resolvedAddressesLock};
+            resolvedAddresses.push_back(address);
+        }
+        if (pauseOnResolve.exchange(false)) {
+            symbolizer.pause();
+        }
+    }};
+};
+
+TEST_F(BackgroundSymbolizerTest, givenNewStackWhenItIsCapturedThenResolveAllItsAddresses) {
+    void *frames[] = {reinterpret_cast<void *>(0x1000), reinterpret_cast<void *>(0x2000), reinterpret_cast<void *>(0x3000)};
+    symbolizer.start();
+    symbolizer.onStack(frames, 3);
+    symbolizer.waitUntilIdle();
+
+    const std::vector<void *> expected{frames[0], frames[1], frames[2]};
+    EXPECT_EQ(expected, getResolvedAddresses());
+}
+
+TEST_F(BackgroundSymbolizerTest, givenTheSameStackCapturedRepeatedlyWhenResolvingThenResolveItOnce) {
+    void *frames[] = {reinterpret_cast<void *>(0x1000), reinterpret_cast<void *>(0x2000)};
+    symbolizer.start();
+    for (int i = 0; i < 5; i++) {
+        symbolizer.onStack(frames, 2);
+    }
+    symbolizer.waitUntilIdle();
+
+    EXPECT_EQ(2u, getResolvedAddresses().size());
+}
+
+TEST_F(BackgroundSymbolizerTest, givenStacksSharingFramesWhenResolvingThenResolveEachAddressOnce) {
+    void *frames0[] = {reinterpret_cast<void *>(0x1000), reinterpret_cast<void *>(0x2000), reinterpret_cast<void *>(0x3000)};
+    void *frames1[] = {reinterpret_cast<void *>(0x4000), reinterpret_cast<void *>(0x2000), reinterpret_cast<void *>(0x3000)};
+    symbolizer.start();
+    symbolizer.onStack(frames0, 3);
+    symbolizer.onStack(frames1, 3);
+    symbolizer.waitUntilIdle();
+
+    std::vector<void *> resolved = getResolvedAddresses();
+    std::sort(resolved.begin(), resolved.end());
+    const std::vector<void *> expected{frames0[0], frames0[1], frames0[2], frames1[0]};
+    EXPECT_EQ(expected, resolved);
+}
+
+TEST_F(BackgroundSymbolizerTest, givenStacksCapturedBeforeStartWhenStartingThenResolveThem) {
+    void *frames[] = {reinterpret_cast<void *>(0x1000)};
+    symbolizer.onStack(frames, 1);
+    symbolizer.start();
+    symbolizer.waitUntilIdle();
+
+    EXPECT_EQ(1u, getResolvedAddresses().size());
+}
+
+TEST_F(BackgroundSymbolizerTest, givenPausedSymbolizerWhenStackIsCapturedThenResolveItAfterResume) {
+    void *frames[] = {reinterpret_cast<void *>(0x1000)};
+    symbolizer.start();
+    {
+        const Oakum::BackgroundSymbolizer::RaiiPause pause{&symbolizer};
+        symbolizer.onStack(frames, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_TRUE(getResolvedAddresses().empty());
+    }
+    symbolizer.waitUntilIdle();
+
+    EXPECT_EQ(1u, getResolvedAddresses().size());
+}
+
+TEST_F(BackgroundSymbolizerTest, givenSymbolizerPausedWhileResolvingWhenResumingThenResolveRemainingAddresses) {
+    void *frames[] = {reinterpret_cast<void *>(0x1000), reinterpret_cast<void *>(0x2000), reinterpret_cast<void *>(0x3000)};
+    pauseOnResolve = true;
+    symbolizer.start();
+    symbolizer.onStack(frames, 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(1u, getResolvedAddresses().size());
+
+    symbolizer.resume();
+    symbolizer.waitUntilIdle();
+    const std::vector<void *> expected{frames[0], frames[1], frames[2]};
+    EXPECT_EQ(expected, getResolvedAddresses());
+}
@@ -0,0 +1,87 @@
+#include "source/background_thread.h"
+#include "tests/common/fixtures.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+struct BackgroundThreadTest : OakumTest {
+    void SetUp() override {
+        // Thread marks its allocations as ignored, which requires an initialized library
+        EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    }
+
+    void TearDown() override {
+        thread.stop();
+        OakumTest::TearDown();
+    }
+
+    Oakum::BackgroundThread thread{};
+};
+
+TEST_F(BackgroundThreadTest, givenThreadWaitingForLongIntervalWhenStoppingThenWakeItUp) {
+    std::atomic<size_t> wakeUpsCount = 0;
+    thread.start([&]() {
+        auto lockGuard = thread.lock();
+        while (thread.waitFor(lockGuard, std::chrono::hours(1))) {
+            wakeUpsCount++;
+        }
+    });
+    EXPECT_TRUE(thread.isStarted());
+
+    const auto stopStartTime = std::chrono::steady_clock::now();
+    thread.stop();
+    EXPECT_GT(std::chrono::seconds(10), std::chrono::steady_clock::now() - stopStartTime);
+    EXPECT_EQ(0u, wakeUpsCount);
+    EXPECT_TRUE(thread.isStopRequested());
+}
+
+TEST_F(BackgroundThreadTest, givenThreadWaitingForPredicateWhenNotifiedThenWakeItUp) {
+    bool requested = false;
+    std::atomic<size_t> servedCount = 0;
+    thread.start([&]() {
+        auto lockGuard = thread.lock();
+        while (thread.wait(lockGuard, [&]() { return requested; })) {
+            requested = false;
+            servedCount++;
+        }
+    });
+
+    {
+        const auto lockGuard = thread.lock();
+        requested = true;
+    }
+    thread.notify();
+    while (servedCount == 0) {
+        std::this_thread::yield();
+    }
+    thread.stop();
+    EXPECT_EQ(1u, servedCount);
+}
+
+TEST_F(BackgroundThreadTest, givenThreadBlockedElsewhereWhenStoppingThenCallWakeUpFunctionAfterRequestingStop) {
+    std::atomic<bool> wokenUp = false;
+    thread.start([&]() {
+        while (!wokenUp) {
+            std::this_thread::yield();
+        }
+    });
+
+    bool stopRequestedOnWakeUp = false;
+    thread.stop([&]() {
+        stopRequestedOnWakeUp = thread.isStopRequested();
+        wokenUp = true;
+    });
+    EXPECT_TRUE(stopRequestedOnWakeUp);
+}
+
+TEST_F(BackgroundThreadTest, givenMemoryAllocatedByThreadWhenDetectingLeaksThenDoNotReportIt) {
+    std::unique_ptr<char[]> memory{};
+    thread.start([&]() { memory = std::make_unique<char[]>(16); });
+    thread.stop();
+
+    ASSERT_NE(nullptr, memory);
+    EXPECT_OAKUM_SUCCESS(oakumDetectLeaks());
+}
@@ -0,0 +1,69 @@
+#include "source/linux/elf_symbol_table.h"
+#include "source/module_registry.h"
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+
+static int nonExportedFunction(int value) {
+    return value * 3;
+}
+
+struct ElfSymbolResolverTest : OakumTest {
+    const char *lookup(const void *address) {
+        modules.refresh();
+        size_t moduleIndex{};
+        uintptr_t offset{};
+        if (!modules.findModule(address, moduleIndex, offset)) {
+            return nullptr;
+        }
+        return Oakum::ElfSymbolResolver::lookup(modules.getModule(moduleIndex)->path.c_str(), offset);
+    }
+
+    Oakum::ModuleRegistry modules{};
+};
+
+TEST_F(ElfSymbolResolverTest, givenNonExportedFunctionWhenLookingUpSymbolThenReturnItsName) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    // Static function is not visible to the dynamic linker, only to the ELF symbol table
+    auto function = nonExportedFunction;
+    Dl_info dlInfo{};
+    dladdr(reinterpret_cast<void *>(function), &dlInfo);
+    EXPECT_EQ(nullptr, dlInfo.dli_sname);
+
+    const char *symbol = lookup(reinterpret_cast<void *>(function));
+    ASSERT_NE(nullptr, symbol);
+    EXPECT_NE(nullptr, strstr(symbol, "nonExportedFunction"));
+}
+
+TEST_F(ElfSymbolResolverTest, givenAddressInsideFunctionWhenLookingUpSymbolThenReturnFunctionName) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    auto function = allocateMemoryFunctionNoThrow;
+    const char *symbol = lookup(reinterpret_cast<char *>(function) + 1);
+    ASSERT_NE(nullptr, symbol);
+    EXPECT_NE(nullptr, strstr(symbol, "allocateMemoryFunctionNoThrow"));
+}
+
+TEST_F(ElfSymbolResolverTest, givenAddressOutsideOfAnyModuleWhenLookingUpSymbolThenReturnNull) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    int stackVariable{};
+    EXPECT_EQ(nullptr, lookup(&stackVariable));
+}
+
+TEST_F(ElfSymbolResolverTest, givenSharedLibraryFunctionWhenLookingUpSymbolThenReturnItsName) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    const char *symbol = lookup(reinterpret_cast<void *>(&qsort));
+    ASSERT_NE(nullptr, symbol);
+    EXPECT_NE(nullptr, strstr(symbol, "qsort"));
+}
+
+TEST(ElfSymbolTableTest, givenInvalidFileWhenLoadingSymbolTableThenReturnNull) {
+    EXPECT_EQ(nullptr, Oakum::ElfSymbolTable::load("/proc/self/cmdline"));
+    EXPECT_EQ(nullptr, Oakum::ElfSymbolTable::load("/nonexistent/path/to/module"));
+}
@@ -5,9 +5,8 @@
 RaiiSyscallsBackup MockSyscalls::mockSymbolResolvingSuccess(const char *valueToReturn) {
     RaiiSyscallsBackup backup{};
 
-    Oakum::syscalls.dladdr = [](const void *addr, Dl_info *info) -> int {
-        info->dli_sname = "__MangledSymbolName__";
-        return 1;
+    Oakum::syscalls.lookupElfSymbol = [](const char *modulePath, uintptr_t offset) -> const char * {
+        return "__MangledSymbolName__";
     };
 
     Oakum::syscalls.demangleSymbol = [valueToReturn](const char *mangled_name, char *output_buffer, size_t *length, int *status) -> char * {
@@ -26,6 +25,10 @@ RaiiSyscallsBackup MockSyscalls::mockSymbolResolvingSuccess(const char *valueToR
 RaiiSyscallsBackup MockSyscalls::mockSymbolResolvingFail() {
     RaiiSyscallsBackup backup{};
 
+    Oakum::syscalls.lookupElfSymbol = [](const char *modulePath, uintptr_t offset) -> const char * {
+        return nullptr;
+    };
+
     Oakum::syscalls.dladdr = [](const void *addr, Dl_info *info) -> int {
         return 0;
     };
@@ -36,6 +39,10 @@ RaiiSyscallsBackup MockSyscalls::mockSymbolResolvingFail() {
 RaiiSyscallsBackup MockSyscalls::mockSymbolResolvingToNullptr() {
     RaiiSyscallsBackup backup{};
 
+    Oakum::syscalls.lookupElfSymbol = [](const char *modulePath, uintptr_t offset) -> const char * {
+        return nullptr;
+    };
+
     Oakum::syscalls.dladdr = [](const void *addr, Dl_info *info) -> int {
         info->dli_sname = nullptr;
         return 1;
@@ -47,19 +54,7 @@ RaiiSyscallsBackup MockSyscalls::mockSymbolResolvingToNullptr() {
 RaiiSyscallsBackup MockSyscalls::mockSourceLocationResolvingSuccess(const char *fileToReturn, size_t lineToReturn) {
     RaiiSyscallsBackup backup{};
 
-    Oakum::syscalls.dladdr1 = [](const void *addr, Dl_info *info, void **extra_info, int flags) -> int {
-        info->dli_fname = "NiceBinary";
-
-        static link_map linkMap{};
-        *reinterpret_cast<link_map **>(extra_info) = &linkMap;
-
-        return 1;
-    };
-
     Oakum::syscalls.runProcessForOutput = [fileToReturn, lineToReturn](std::string_view binaryName, std::initializer_list<std::string_view> args) -> std::string {
-        if (binaryName == "which") {
-            return "1";
-        }
         if (binaryName == "addr2line") {
             // EXPECT_EQ("-e", args.data()[0]);
             //  EXPECT_EQ(binaryName, args.data()[1]);
@@ -76,8 +71,22 @@ RaiiSyscallsBackup MockSyscalls::mockSourceLocationResolvingSuccess(const char *
 RaiiSyscallsBackup MockSyscalls::mockSourceLocationResolvingFail() {
     RaiiSyscallsBackup backup{};
 
-    Oakum::syscalls.dladdr1 = [](const void *addr, Dl_info *info, void **extra_info, int flags) -> int {
-        return 0;
+    Oakum::syscalls.runProcessForOutput = [](std::string_view binaryName, std::initializer_list<std::string_view> args) -> std::string {
+        if (binaryName == "addr2line") {
+            return "??:0";
+        }
+        FATAL_ERROR("Unreachable code in syscall mock");
+    };
+
+    return backup;
+}
+
+RaiiSyscallsBackup MockSyscalls::mockChildProcessesForbidden() {
+    RaiiSyscallsBackup backup{};
+
+    Oakum::syscalls.runProcessForOutput = [](std::string_view binaryName, std::initializer_list<std::string_view> args) -> std::string {
+        ADD_FAILURE() << "Unexpected child process " << binaryName;
+        return "";
     };
 
     return backup;
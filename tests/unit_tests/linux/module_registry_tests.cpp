@@ -0,0 +1,159 @@
+#include "source/module_registry.h"
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+
+using ModuleRegistryTest = OakumTest;
+
+struct ModuleRegistryWhitebox : Oakum::ModuleRegistry {
+    // Simulates unloading of a module and loading of another one at the same range, without refreshing
+    size_t replaceModule(size_t moduleIndex) {
+        RaiiOakumIgnore ignore{};
+        std::lock_guard lockGuard{lock};
+        Module replacement = modules[moduleIndex];
+        replacement.path = "replacement";
+        modules[moduleIndex].loaded = false;
+        modules.push_back(replacement);
+
+        auto currentLoadedModules = std::make_unique<LoadedModules>(*loadedModules.load());
+        for (LoadedModule &loadedModule : *currentLoadedModules) {
+            if (loadedModule.moduleIndex == moduleIndex) {
+                loadedModule.moduleIndex = modules.size() - 1;
+            }
+        }
+        loadedModules.store(currentLoadedModules.get());
+        loadedModulesSnapshots.push_back(std::move(currentLoadedModules));
+        return modules.size() - 1;
+    }
+};
+
+TEST_F(ModuleRegistryTest, givenFunctionAddressWhenFindingModuleThenReturnModuleContainingIt) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    Oakum::ModuleRegistry modules{};
+    modules.refresh();
+
+    const void *address = reinterpret_cast<const void *>(allocateMemoryFunctionNoThrow);
+    size_t moduleIndex{};
+    uintptr_t offset{};
+    ASSERT_TRUE(modules.findModule(address, moduleIndex, offset));
+
+    const Oakum::ModuleRegistry::Module *module = modules.getModule(moduleIndex);
+    ASSERT_NE(nullptr, module);
+    EXPECT_TRUE(module->loaded);
+    EXPECT_FALSE(module->path.empty());
+    EXPECT_LE(module->begin, reinterpret_cast<uintptr_t>(address));
+    EXPECT_GT(module->end, reinterpret_cast<uintptr_t>(address));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(address), module->baseAddress + offset);
+}
+
+TEST_F(ModuleRegistryTest, givenFunctionsFromDifferentModulesWhenFindingModulesThenReturnDifferentIndices) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    Oakum::ModuleRegistry modules{};
+    modules.refresh();
+
+    size_t executableModuleIndex{};
+    size_t libraryModuleIndex{};
+    uintptr_t offset{};
+    ASSERT_TRUE(modules.findModule(reinterpret_cast<const void *>(allocateMemoryFunctionNoThrow), executableModuleIndex, offset));
+    ASSERT_TRUE(modules.findModule(reinterpret_cast<const void *>(&qsort), libraryModuleIndex, offset));
+    EXPECT_NE(executableModuleIndex, libraryModuleIndex);
+}
+
+TEST_F(ModuleRegistryTest, givenAddressOutsideOfAnyModuleWhenFindingModuleThenReturnFalse) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    Oakum::ModuleRegistry modules{};
+    modules.refresh();
+
+    int stackVariable{};
+    size_t moduleIndex{};
+    uintptr_t offset{};
+    EXPECT_FALSE(modules.findModule(&stackVariable, moduleIndex, offset));
+    EXPECT_EQ(nullptr, modules.getModule(OAKUM_UNKNOWN_MODULE_INDEX));
+}
+
+TEST_F(ModuleRegistryTest, givenMultipleRefreshesWhenNoModuleWasLoadedThenIndicesDoNotChange) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    Oakum::ModuleRegistry modules{};
+    modules.refresh();
+
+    size_t modulesCount{};
+    modules.getModules(nullptr, modulesCount);
+    size_t moduleIndex{};
+    uintptr_t offset{};
+    ASSERT_TRUE(modules.findModule(reinterpret_cast<const void *>(&qsort), moduleIndex, offset));
+
+    modules.refresh();
+    size_t modulesCountAfterRefresh{};
+    modules.getModules(nullptr, modulesCountAfterRefresh);
+    size_t moduleIndexAfterRefresh{};
+    ASSERT_TRUE(modules.findModule(reinterpret_cast<const void *>(&qsort), moduleIndexAfterRefresh, offset));
+    EXPECT_EQ(modulesCount, modulesCountAfterRefresh);
+    EXPECT_EQ(moduleIndex, moduleIndexAfterRefresh);
+}
+
+TEST_F(ModuleRegistryTest, givenFunctionAddressWhenGettingRelativeAddressThenResolveItBackToTheSameAddressAndModule) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    Oakum::ModuleRegistry modules{};
+    modules.refreshIfChanged();
+
+    void *address = reinterpret_cast<void *>(allocateMemoryFunctionNoThrow);
+    void *relativeAddress = nullptr;
+    modules.getRelativeAddresses(&address, 1u, &relativeAddress);
+    EXPECT_NE(address, relativeAddress);
+
+    size_t expectedModuleIndex{};
+    uintptr_t expectedOffset{};
+    ASSERT_TRUE(modules.findModule(address, expectedModuleIndex, expectedOffset));
+    void *resolvedAddress = nullptr;
+    size_t moduleIndex{};
+    uintptr_t offset{};
+    ASSERT_TRUE(modules.resolveRelativeAddress(relativeAddress, resolvedAddress, moduleIndex, offset));
+    EXPECT_EQ(address, resolvedAddress);
+    EXPECT_EQ(expectedModuleIndex, moduleIndex);
+    EXPECT_EQ(expectedOffset, offset);
+}
+
+TEST_F(ModuleRegistryTest, givenAddressOutsideOfAnyModuleWhenGettingRelativeAddressThenKeepItUnchanged) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    Oakum::ModuleRegistry modules{};
+    modules.refreshIfChanged();
+
+    int stackVariable{};
+    void *address = &stackVariable;
+    void *relativeAddress = nullptr;
+    modules.getRelativeAddresses(&address, 1u, &relativeAddress);
+    EXPECT_EQ(address, relativeAddress);
+
+    void *resolvedAddress = nullptr;
+    size_t moduleIndex{};
+    uintptr_t offset{};
+    EXPECT_FALSE(modules.resolveRelativeAddress(relativeAddress, resolvedAddress, moduleIndex, offset));
+    EXPECT_EQ(address, resolvedAddress);
+}
+
+TEST_F(ModuleRegistryTest, givenModuleReplacedAtTheSameRangeWhenResolvingRelativeAddressCapturedBeforeThenReturnOriginalModule) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    ModuleRegistryWhitebox modules{};
+    modules.refreshIfChanged();
+
+    void *address = reinterpret_cast<void *>(&qsort);
+    void *relativeAddress = nullptr;
+    modules.getRelativeAddresses(&address, 1u, &relativeAddress);
+    size_t originalModuleIndex{};
+    uintptr_t offset{};
+    ASSERT_TRUE(modules.findModule(address, originalModuleIndex, offset));
+    const size_t replacementModuleIndex = modules.replaceModule(originalModuleIndex);
+
+    // Absolute address is attributed to the module mapped now, relative one to the module it was captured in
+    size_t moduleIndex{};
+    ASSERT_TRUE(modules.findModule(address, moduleIndex, offset));
+    EXPECT_EQ(replacementModuleIndex, moduleIndex);
+    void *resolvedAddress = nullptr;
+    ASSERT_TRUE(modules.resolveRelativeAddress(relativeAddress, resolvedAddress, moduleIndex, offset));
+    EXPECT_EQ(originalModuleIndex, moduleIndex);
+    EXPECT_EQ(address, resolvedAddress);
+    EXPECT_FALSE(modules.getModule(moduleIndex)->loaded);
+}
@@ -0,0 +1,280 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+struct OakumQueryServerTest : OakumTest {
+    void SetUp() override {
+        initArgs.querySocketPath = socketPath.pathString.c_str();
+    }
+
+    bool initialize() {
+        const OakumResult result = oakumInit(&initArgs);
+        EXPECT_TRUE(result == OAKUM_SUCCESS || result == OAKUM_FEATURE_NOT_SUPPORTED);
+        return result == OAKUM_SUCCESS;
+    }
+
+    std::string query(const std::string &queryLine) {
+        RaiiOakumIgnore ignore{};
+        const int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+        EXPECT_NE(-1, descriptor);
+        const sockaddr_un address = getAddress();
+        EXPECT_EQ(0, connect(descriptor, reinterpret_cast<const sockaddr *>(&address), sizeof(address)));
+
+        const std::string request = queryLine + "\n";
+        EXPECT_EQ(static_cast<ssize_t>(request.size()), send(descriptor, request.data(), request.size(), 0));
+        std::string response{};
+        char buffer[4096];
+        for (ssize_t readSize; (readSize = recv(descriptor, buffer, sizeof(buffer), 0)) > 0;) {
+            response.append(buffer, readSize);
+        }
+        close(descriptor);
+        return response;
+    }
+
+    sockaddr_un getAddress() const {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, socketPath.pathString.c_str(), sizeof(address.sun_path) - 1);
+        return address;
+    }
+
+    int bindSocket() const {
+        const int descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+        EXPECT_NE(-1, descriptor);
+        const sockaddr_un address = getAddress();
+        EXPECT_EQ(0, bind(descriptor, reinterpret_cast<const sockaddr *>(&address), sizeof(address)));
+        return descriptor;
+    }
+
+    const TemporaryPath socketPath{"OakumQueryServerTest", ".socket"};
+};
+
+TEST_F(OakumQueryServerTest, givenInvalidSocketPathWhenInitializingThenReturnIoError) {
+    const std::string path = (socketPath.path / "missing_directory" / "socket").string();
+    initArgs.querySocketPath = path.c_str();
+    const OakumResult result = oakumInit(&initArgs);
+    EXPECT_TRUE(result == OAKUM_IO_ERROR || result == OAKUM_FEATURE_NOT_SUPPORTED);
+    EXPECT_EQ(OAKUM_UNINITIALIZED, oakumDetectLeaks());
+}
+
+TEST_F(OakumQueryServerTest, givenRegularFileAtSocketPathWhenInitializingThenReturnIoErrorAndKeepFile) {
+    std::ofstream{socketPath.path} << "data";
+    const OakumResult result = oakumInit(&initArgs);
+    EXPECT_TRUE(result == OAKUM_IO_ERROR || result == OAKUM_FEATURE_NOT_SUPPORTED);
+    EXPECT_TRUE(std::filesystem::is_regular_file(socketPath.path));
+    EXPECT_EQ(4u, std::filesystem::file_size(socketPath.path));
+    std::filesystem::remove(socketPath.path);
+}
+
+TEST_F(OakumQueryServerTest, givenSocketOfRunningServerAtSocketPathWhenInitializingThenReturnIoErrorAndKeepSocket) {
+    const int descriptor = bindSocket();
+    EXPECT_EQ(0, listen(descriptor, 1));
+    struct stat statusBefore = {};
+    EXPECT_EQ(0, lstat(socketPath.pathString.c_str(), &statusBefore));
+
+    const OakumResult result = oakumInit(&initArgs);
+    EXPECT_TRUE(result == OAKUM_IO_ERROR || result == OAKUM_FEATURE_NOT_SUPPORTED);
+    struct stat statusAfter = {};
+    EXPECT_EQ(0, lstat(socketPath.pathString.c_str(), &statusAfter));
+    EXPECT_EQ(statusBefore.st_ino, statusAfter.st_ino);
+
+    close(descriptor);
+    std::filesystem::remove(socketPath.path);
+}
+
+TEST_F(OakumQueryServerTest, givenSocketLeftByCrashedProcessAtSocketPathWhenInitializingThenReplaceIt) {
+    close(bindSocket()); // nothing listens on it, so connections are refused
+    if (!initialize()) {
+        std::filesystem::remove(socketPath.path);
+        GTEST_SKIP();
+    }
+    EXPECT_NE(std::string::npos, query("stats").find("liveAllocationsCount 0\n"));
+}
+
+TEST_F(OakumQueryServerTest, givenQueryServerWhenDeinitializingThenRemoveSocket) {
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    EXPECT_TRUE(std::filesystem::is_socket(socketPath.path));
+    EXPECT_EQ(std::filesystem::perms::owner_read | std::filesystem::perms::owner_write, std::filesystem::status(socketPath.path).permissions());
+    EXPECT_TRUE(isThreadSafe());
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+    EXPECT_FALSE(std::filesystem::exists(socketPath.path));
+}
+
+TEST_F(OakumQueryServerTest, givenStatsQueryWhenQueryingThenReturnStatistics) {
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    std::unique_ptr<char[]> memory{allocateMemoryFromCallSite(23)};
+    const std::string response = query("stats");
+    memory.reset();
+
+    EXPECT_NE(std::string::npos, response.find("liveAllocationsCount 1\n"));
+    EXPECT_NE(std::string::npos, response.find("liveBytes 23\n"));
+    EXPECT_NE(std::string::npos, response.find("totalAllocationsCount 1\n"));
+}
+
+TEST_F(OakumQueryServerTest, givenUnknownQueryWhenQueryingThenReturnError) {
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    EXPECT_EQ(0u, query("unknown").find("error: unknown query\n"));
+    EXPECT_EQ(0u, query("top many").find("error: unknown query\n"));
+    EXPECT_EQ(0u, query("since").find("error: unknown query\n"));
+}
+
+TEST_F(OakumQueryServerTest, givenTopQueryWhenQueryingThenReturnCallSitesSortedByLiveBytes) {
+    for (OakumStackTraceMode mode : {OAKUM_STACK_TRACE_MODE_FULL, OAKUM_STACK_TRACE_MODE_CALLER}) {
+        initArgs.trackStackTraces = true;
+        initArgs.stackTraceMode = mode;
+        if (!initialize()) {
+            GTEST_SKIP();
+        }
+        std::unique_ptr<char[]> small{allocateMemoryFunction(3)};
+        std::unique_ptr<char[]> large1{allocateMemoryFromCallSite(40)};
+        std::unique_ptr<char[]> large2{allocateMemoryFromCallSite(60)};
+        const std::string response = query("top 1");
+        const std::string allResponse = query("top");
+        small.reset();
+        large1.reset();
+        large2.reset();
+
+        EXPECT_EQ(0u, response.find("liveBytes liveAllocationsCount callSite\n100 2 0x"));
+        EXPECT_EQ(2u, std::count(response.begin(), response.end(), '\n'));
+        EXPECT_NE(std::string::npos, allResponse.find("\n3 1 0x"));
+        if (isSymbolLocationResolvingSupported()) {
+            EXPECT_NE(std::string::npos, response.find("allocateMemoryFromCallSite"));
+        }
+        EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+    }
+}
+
+TEST_F(OakumQueryServerTest, givenCheckpointWhenQueryingAllocationsSinceThenReturnOnlyNewerAllocations) {
+    initArgs.trackStackTraces = true;
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    std::unique_ptr<char[]> older{allocateMemoryFromCallSite(11)};
+    const std::string checkpointResponse = query("checkpoint");
+    std::unique_ptr<char[]> newer{allocateMemoryFromCallSite(13)};
+
+    ASSERT_EQ(0u, checkpointResponse.find("checkpoint "));
+    const std::string checkpoint = checkpointResponse.substr(11, checkpointResponse.size() - 12);
+    const std::string sinceResponse = query("since " + checkpoint);
+    const std::string reportResponse = query("report");
+    older.reset();
+    newer.reset();
+
+    EXPECT_EQ(std::string::npos, sinceResponse.find(" size 11 "));
+    EXPECT_EQ(0u, sinceResponse.find("allocation " + checkpoint + " size 13 pointer 0x"));
+    EXPECT_NE(std::string::npos, sinceResponse.find("\n    0x"));
+    EXPECT_NE(std::string::npos, reportResponse.find(" size 11 "));
+    EXPECT_NE(std::string::npos, reportResponse.find(" size 13 "));
+}
+
+TEST_F(OakumQueryServerTest, givenManyAllocationsWhenQueryingReportThenStreamAllOfThem) {
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    std::vector<std::unique_ptr<char[]>> memory{};
+    {
+        RaiiOakumIgnore ignore{};
+        memory.reserve(2000);
+    }
+    for (int i = 0; i < 2000; i++) {
+        memory.emplace_back(allocateMemoryFromCallSite(1));
+    }
+    const std::string response = query("report");
+    memory.clear();
+
+    size_t allocationsCount = 0;
+    for (size_t position = response.find("allocation "); position != std::string::npos; position = response.find("allocation ", position + 1)) {
+        allocationsCount++;
+    }
+    EXPECT_EQ(2000u, allocationsCount);
+}
+
+TEST_F(OakumQueryServerTest, givenAllocationsMadeDuringQueryWhenQueryingReportThenStreamEachLiveAllocationExactlyOnce) {
+    initArgs.threadSafe = true;
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    std::vector<std::unique_ptr<char[]>> memory{};
+    {
+        RaiiOakumIgnore ignore{};
+        memory.reserve(2000);
+    }
+    for (int i = 0; i < 2000; i++) {
+        memory.emplace_back(allocateMemoryFromCallSite(3));
+    }
+
+    // Registry grows while the report is streamed, so it is rehashed between chunks
+    std::atomic_bool stop = false;
+    std::thread allocatingThread{[&stop]() {
+        std::vector<std::unique_ptr<char[]>> temporaryMemory{};
+        {
+            RaiiOakumIgnore ignore{};
+            temporaryMemory.reserve(4000);
+        }
+        while (!stop.load()) {
+            for (int i = 0; i < 4000; i++) {
+                temporaryMemory.emplace_back(allocateMemoryFromCallSite(1));
+            }
+            temporaryMemory.clear();
+        }
+    }};
+    const std::string response = query("report");
+    stop = true;
+    allocatingThread.join();
+    memory.clear();
+
+    RaiiOakumIgnore ignore{};
+    std::set<unsigned long long> allocationIds{};
+    unsigned long long previousAllocationId = 0;
+    size_t allocationsCount = 0;
+    for (size_t position = response.find("allocation "); position != std::string::npos; position = response.find("allocation ", position + 1)) {
+        const unsigned long long allocationId = std::stoull(response.substr(position + strlen("allocation ")));
+        EXPECT_LT(previousAllocationId, allocationId);
+        previousAllocationId = allocationId;
+        if (response.compare(response.find(' ', position + strlen("allocation ")), strlen(" size 3 "), " size 3 ") == 0) {
+            allocationIds.insert(allocationId);
+            allocationsCount++;
+        }
+    }
+    EXPECT_EQ(2000u, allocationsCount);
+    EXPECT_EQ(2000u, allocationIds.size());
+}
+
+TEST_F(OakumQueryServerTest, givenThreadTrackingWhenQueryingThreadsThenReturnLiveBytesPerThread) {
+    initArgs.trackThreads = true;
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    std::unique_ptr<char[]> memory{allocateMemoryFromCallSite(13)};
+    const std::string threadsResponse = query("threads");
+    const std::string reportResponse = query("report");
+    memory.reset();
+
+    EXPECT_EQ(0u, threadsResponse.find("liveBytes liveAllocationsCount totalAllocationsCount thread name\n13 1 1 "));
+    EXPECT_NE(std::string::npos, reportResponse.find(" size 13 pointer 0x"));
+    EXPECT_NE(std::string::npos, reportResponse.find(" thread "));
+}
+
+TEST_F(OakumQueryServerTest, givenThreadTrackingDisabledWhenQueryingThreadsThenReturnError) {
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    EXPECT_EQ("error: threads are not tracked\n", query("threads"));
+}
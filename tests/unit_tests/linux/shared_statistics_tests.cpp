@@ -0,0 +1,206 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <random>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+struct OakumSharedStatisticsTest : OakumTest {
+    void SetUp() override {
+        name = "/OakumSharedStatisticsTest" + std::to_string(std::random_device{}());
+        initArgs.sharedStatisticsName = name.c_str();
+        initArgs.sharedStatisticsIntervalMs = 1;
+    }
+
+    void TearDown() override {
+        unmap();
+        OakumTest::TearDown();
+    }
+
+    bool initialize() {
+        const OakumResult result = oakumInit(&initArgs);
+        EXPECT_TRUE(result == OAKUM_SUCCESS || result == OAKUM_FEATURE_NOT_SUPPORTED);
+        if (result != OAKUM_SUCCESS) {
+            return false;
+        }
+
+        // Monitor does not use the library, so it maps the object in the same way as another process would
+        const int descriptor = shm_open(name.c_str(), O_RDONLY, 0);
+        EXPECT_NE(-1, descriptor);
+        void *mapping = mmap(nullptr, sizeof(OakumSharedStatistics), PROT_READ, MAP_SHARED, descriptor, 0);
+        EXPECT_NE(MAP_FAILED, mapping);
+        close(descriptor);
+        page = static_cast<const OakumSharedStatistics *>(mapping);
+        return true;
+    }
+
+    void unmap() {
+        if (page != nullptr) {
+            munmap(const_cast<OakumSharedStatistics *>(page), sizeof(OakumSharedStatistics));
+            page = nullptr;
+        }
+    }
+
+    OakumSharedStatistics read() {
+        const auto &sequence = *reinterpret_cast<const std::atomic<uint64_t> *>(&page->sequence);
+        OakumSharedStatistics result{};
+        while (true) {
+            const uint64_t sequenceBefore = sequence.load(std::memory_order_acquire);
+            memcpy(&result, page, sizeof(result));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequenceBefore % 2 == 0 && sequenceBefore == sequence.load(std::memory_order_relaxed)) {
+                return result;
+            }
+        }
+    }
+
+    // Waits until two updates have started after the call, so both counters and rates reflect only the state after it
+    OakumSharedStatistics readFreshStatistics() {
+        const uint64_t updatesCount = read().updatesCount;
+        OakumSharedStatistics result{};
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while ((result = read()).updatesCount < updatesCount + 3 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_LE(updatesCount + 3, result.updatesCount);
+        return result;
+    }
+
+    bool sharedMemoryExists() {
+        const int descriptor = shm_open(name.c_str(), O_RDONLY, 0);
+        if (descriptor == -1) {
+            EXPECT_EQ(ENOENT, errno);
+            return false;
+        }
+        close(descriptor);
+        return true;
+    }
+
+    void createExistingObject(uint64_t magic, pid_t ownerProcessId) {
+        const int descriptor = shm_open(name.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+        ASSERT_NE(-1, descriptor);
+        OakumSharedStatistics header{};
+        header.magic = magic;
+        header.version = OAKUM_SHARED_STATISTICS_VERSION;
+        header.size = sizeof(OakumSharedStatistics);
+        header.ownerProcessId = static_cast<uint64_t>(ownerProcessId);
+        EXPECT_EQ(static_cast<ssize_t>(sizeof(header)), pwrite(descriptor, &header, sizeof(header), 0));
+        close(descriptor);
+    }
+
+    static pid_t getExitedProcessId() {
+        const pid_t processId = fork();
+        if (processId == 0) {
+            _exit(0);
+        }
+        EXPECT_EQ(processId, waitpid(processId, nullptr, 0));
+        return processId;
+    }
+
+    void expectInitializationFailureKeepingObject() {
+        const OakumResult result = oakumInit(&initArgs);
+        EXPECT_TRUE(result == OAKUM_IO_ERROR || result == OAKUM_FEATURE_NOT_SUPPORTED);
+        EXPECT_TRUE(sharedMemoryExists());
+        shm_unlink(name.c_str());
+    }
+
+    std::string name{};
+    const OakumSharedStatistics *page = nullptr;
+};
+
+TEST_F(OakumSharedStatisticsTest, givenZeroIntervalWhenInitializingThenReturnInvalidValue) {
+    initArgs.sharedStatisticsIntervalMs = 0;
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumInit(&initArgs));
+    EXPECT_FALSE(sharedMemoryExists());
+}
+
+TEST_F(OakumSharedStatisticsTest, givenSharedStatisticsWhenInitializingThenCreateObjectWithHeaderAndRemoveItOnDeinit) {
+    // Object left by a crashed process is replaced
+    createExistingObject(OAKUM_SHARED_STATISTICS_MAGIC, getExitedProcessId());
+
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    EXPECT_EQ(OAKUM_SHARED_STATISTICS_MAGIC, page->magic);
+    EXPECT_EQ(OAKUM_SHARED_STATISTICS_VERSION, page->version);
+    EXPECT_EQ(sizeof(OakumSharedStatistics), page->size);
+    EXPECT_EQ(static_cast<uint64_t>(getpid()), page->ownerProcessId);
+
+    struct stat status = {};
+    const int descriptor = shm_open(name.c_str(), O_RDONLY, 0);
+    ASSERT_NE(-1, descriptor);
+    EXPECT_EQ(0, fstat(descriptor, &status));
+    close(descriptor);
+    EXPECT_EQ(static_cast<mode_t>(S_IRUSR | S_IWUSR), status.st_mode & 0777);
+    EXPECT_LE(sizeof(OakumSharedStatistics), static_cast<size_t>(status.st_size));
+
+    unmap();
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+    EXPECT_FALSE(sharedMemoryExists());
+}
+
+TEST_F(OakumSharedStatisticsTest, givenObjectOfRunningProcessWhenInitializingThenReturnIoErrorAndKeepObject) {
+    createExistingObject(OAKUM_SHARED_STATISTICS_MAGIC, getpid());
+    expectInitializationFailureKeepingObject();
+}
+
+TEST_F(OakumSharedStatisticsTest, givenObjectNotPublishedByLibraryWhenInitializingThenReturnIoErrorAndKeepObject) {
+    createExistingObject(0u, getExitedProcessId());
+    expectInitializationFailureKeepingObject();
+}
+
+TEST_F(OakumSharedStatisticsTest, givenAllocationsWhenReadingSharedStatisticsThenReturnCurrentCounters) {
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    std::unique_ptr<char[]> memory1{allocateMemoryFromCallSite(23)};
+    std::unique_ptr<char[]> memory2{allocateMemoryFromCallSite(7)};
+    memory2.reset();
+    OakumSharedStatistics statistics = readFreshStatistics();
+    EXPECT_EQ(1u, statistics.liveAllocationsCount);
+    EXPECT_EQ(23u, statistics.liveBytes);
+    EXPECT_EQ(30u, statistics.peakLiveBytes);
+    EXPECT_EQ(2u, statistics.totalAllocationsCount);
+    EXPECT_EQ(1u, statistics.totalDeallocationsCount);
+    EXPECT_EQ(0u, statistics.topCallSitesCount);
+    EXPECT_NE(0u, statistics.updateTimeNs);
+
+    memory1.reset();
+    statistics = readFreshStatistics();
+    EXPECT_EQ(0u, statistics.liveAllocationsCount);
+    EXPECT_EQ(0u, statistics.liveBytes);
+    EXPECT_EQ(0u, statistics.allocationsPerSecond);
+    EXPECT_EQ(0u, statistics.deallocationsPerSecond);
+}
+
+TEST_F(OakumSharedStatisticsTest, givenCallerModeWhenReadingSharedStatisticsThenReturnTopCallSitesSortedByLiveBytes) {
+    initArgs.trackStackTraces = true;
+    initArgs.stackTraceMode = OAKUM_STACK_TRACE_MODE_CALLER;
+    if (!initialize()) {
+        GTEST_SKIP();
+    }
+    std::unique_ptr<char[]> small{allocateMemoryFunction(3)};
+    std::unique_ptr<char[]> large1{allocateMemoryFromCallSite(40)};
+    std::unique_ptr<char[]> large2{allocateMemoryFromCallSite(60)};
+    const OakumSharedStatistics statistics = readFreshStatistics();
+    small.reset();
+    large1.reset();
+    large2.reset();
+
+    ASSERT_EQ(2u, statistics.topCallSitesCount);
+    EXPECT_NE(0u, statistics.topCallSites[0].address);
+    EXPECT_EQ(2u, statistics.topCallSites[0].liveAllocationsCount);
+    EXPECT_EQ(100u, statistics.topCallSites[0].liveBytes);
+    EXPECT_EQ(2u, statistics.topCallSites[0].totalAllocationsCount);
+    EXPECT_EQ(1u, statistics.topCallSites[1].liveAllocationsCount);
+    EXPECT_EQ(3u, statistics.topCallSites[1].liveBytes);
+}
@@ -0,0 +1,106 @@
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+struct OakumSignalReportTest : OakumTest {
+    void SetUp() override {
+        initArgs.trackStackTraces = true;
+        initArgs.reportSignal = SIGUSR2;
+        initArgs.reportFilePath = reportPath.pathString.c_str();
+        initArgs.reportFormat = OAKUM_PROFILE_FORMAT_FOLDED_LIVE_BYTES;
+    }
+
+    void TearDown() override {
+        OakumTest::TearDown();
+        std::error_code error{};
+        std::filesystem::remove(reportPath.path, error);
+    }
+
+    bool waitForReport() {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!std::filesystem::exists(reportPath.path)) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    std::string readReport() {
+        RaiiOakumIgnore ignore{};
+        std::ifstream file{reportPath.path};
+        return std::string{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    const TemporaryPath reportPath{"OakumSignalReportTest", ".folded"};
+};
+
+TEST_F(OakumSignalReportTest, givenInvalidReportArgumentsWhenInitializingThenFail) {
+    initArgs.reportFilePath = nullptr;
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumInit(&initArgs));
+
+    initArgs.reportFilePath = reportPath.pathString.c_str();
+    initArgs.reportFormat = static_cast<OakumProfileFormat>(100);
+    EXPECT_EQ(OAKUM_INVALID_VALUE, oakumInit(&initArgs));
+
+    initArgs.reportFormat = OAKUM_PROFILE_FORMAT_FOLDED_TOTAL_BYTES;
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumInit(&initArgs));
+
+    initArgs.reportFormat = OAKUM_PROFILE_FORMAT_PPROF;
+    initArgs.trackStackTraces = false;
+    EXPECT_EQ(OAKUM_FEATURE_NOT_SUPPORTED, oakumInit(&initArgs));
+}
+
+TEST_F(OakumSignalReportTest, givenReportSignalWhenInitializingThenEnableThreadSafety) {
+    initArgs.threadSafe = false;
+    const OakumResult result = oakumInit(&initArgs);
+    if (result == OAKUM_FEATURE_NOT_SUPPORTED) {
+        GTEST_SKIP(); // library compiled without thread safety
+    }
+    EXPECT_OAKUM_SUCCESS(result);
+    EXPECT_TRUE(isThreadSafe());
+}
+
+TEST_F(OakumSignalReportTest, givenReportSignalWhenSignalIsRaisedThenWriteReportOnReporterThread) {
+    const OakumResult result = oakumInit(&initArgs);
+    if (result == OAKUM_FEATURE_NOT_SUPPORTED) {
+        GTEST_SKIP();
+    }
+    EXPECT_OAKUM_SUCCESS(result);
+
+    std::unique_ptr<char[]> memory{allocateMemoryFromCallSite(23)};
+    EXPECT_FALSE(std::filesystem::exists(reportPath.path));
+    ASSERT_EQ(0, raise(SIGUSR2));
+    ASSERT_TRUE(waitForReport());
+    memory.reset();
+
+    const std::string report = readReport();
+    EXPECT_NE(std::string::npos, report.find(" 23\n"));
+    EXPECT_FALSE(std::filesystem::exists(reportPath.pathString + ".tmp"));
+}
+
+TEST_F(OakumSignalReportTest, givenReportSignalWhenDeinitializingThenRestorePreviousHandler) {
+    static volatile std::sig_atomic_t previousHandlerCalls = 0;
+    auto previousHandler = std::signal(SIGUSR2, [](int) { previousHandlerCalls = previousHandlerCalls + 1; });
+
+    const OakumResult result = oakumInit(&initArgs);
+    if (result == OAKUM_FEATURE_NOT_SUPPORTED) {
+        std::signal(SIGUSR2, previousHandler);
+        GTEST_SKIP();
+    }
+    EXPECT_OAKUM_SUCCESS(result);
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+
+    ASSERT_EQ(0, raise(SIGUSR2));
+    EXPECT_EQ(1, previousHandlerCalls);
+    EXPECT_FALSE(std::filesystem::exists(reportPath.path));
+    std::signal(SIGUSR2, previousHandler);
+}
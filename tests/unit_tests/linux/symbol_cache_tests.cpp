@@ -0,0 +1,160 @@
+#include "source/symbol_cache.h"
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+#include "tests/unit_tests/mock_syscalls.h"
+
+#include <cstring>
+#include <filesystem>
+
+#ifdef NDEBUG
+constexpr size_t firstAllocateMemoryFunctionFrame = 0; // operator new is inlined
+#else
+constexpr size_t firstAllocateMemoryFunctionFrame = 1;
+#endif
+
+struct OakumSymbolCacheTest : OakumTest {
+    void SetUp() override {
+        initArgs.trackStackTraces = true;
+        initArgs.symbolCacheDirectory = cacheDirectory.pathString.c_str();
+
+        // Only frames inside allocateMemoryFunction are the same in all runs. Callers of it are not cached.
+        initArgs.fallbackSymbolName = "<fallback>";
+        initArgs.fallbackSourceFileName = "<fallback>";
+    }
+
+    void TearDown() override {
+        OakumTest::TearDown();
+        std::error_code error{};
+        std::filesystem::remove_all(cacheDirectory.path, error);
+    }
+
+    size_t countCacheFiles() {
+        size_t result = 0;
+        for (const auto &entry : std::filesystem::directory_iterator(cacheDirectory.path)) {
+            result += entry.path().extension() == ".oakumcache";
+        }
+        return result;
+    }
+
+    void expectAllocateMemoryFunctionSymbols(const OakumAllocation &allocation) {
+        for (size_t i = 0; i < allocateMemoryFunctionDepth; i++) {
+            const OakumStackFrame &frame = allocation.stackFrames[i + firstAllocateMemoryFunctionFrame];
+            ASSERT_NE(nullptr, frame.symbolName);
+            EXPECT_NE(nullptr, strstr(frame.symbolName, allocateMemoryFunctionNames[i]));
+        }
+    }
+
+    const TemporaryPath cacheDirectory{"OakumSymbolCacheTest"};
+};
+
+TEST_F(OakumSymbolCacheTest, givenSymbolsResolvedInPreviousRunWhenResolvingFailsThenReturnCachedSymbols) {
+    // First run resolves symbols for real and stores them in the cache
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    {
+        auto memory = allocateMemoryFunction();
+        OakumAllocation *allocations = nullptr;
+        size_t allocationCount = 0u;
+        EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+        EXPECT_OAKUM_SUCCESS(oakumResolveStackTraceSymbols(allocations, allocationCount));
+        expectAllocateMemoryFunctionSymbols(allocations[0]);
+        EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+    }
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+    EXPECT_LE(1u, countCacheFiles());
+
+    // Second run cannot resolve anything, so it has to use the cache
+    RaiiSyscallsBackup backup = MockSyscalls::mockSymbolResolvingFail();
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    auto memory = allocateMemoryFunction();
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_OAKUM_SUCCESS(oakumResolveStackTraceSymbols(allocations, allocationCount));
+    expectAllocateMemoryFunctionSymbols(allocations[0]);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumSymbolCacheTest, givenSourceLocationsResolvedInPreviousRunWhenResolvingFailsThenReturnCachedSourceLocations) {
+    {
+        EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+        RaiiSyscallsBackup backup = MockSyscalls::mockSourceLocationResolvingSuccess("cachedFile", 19);
+        auto memory = allocateMemoryFunction();
+        OakumAllocation *allocations = nullptr;
+        size_t allocationCount = 0u;
+        EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+        EXPECT_OAKUM_SUCCESS(oakumResolveStackTraceSourceLocations(allocations, allocationCount));
+        EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+        memory.reset();
+        EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+    }
+
+    RaiiSyscallsBackup backup = MockSyscalls::mockSourceLocationResolvingFail();
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    auto memory = allocateMemoryFunction();
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_OAKUM_SUCCESS(oakumResolveStackTraceSourceLocations(allocations, allocationCount));
+    for (size_t i = 0; i < allocateMemoryFunctionDepth; i++) {
+        EXPECT_STREQ("cachedFile", allocations[0].stackFrames[i + firstAllocateMemoryFunctionFrame].fileName);
+        EXPECT_EQ(19u, allocations[0].stackFrames[i + firstAllocateMemoryFunctionFrame].fileLine);
+    }
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumSymbolCacheTest, givenDamagedCacheFileWhenResolvingSymbolsThenIgnoreIt) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    {
+        auto memory = allocateMemoryFunction();
+        OakumAllocation *allocations = nullptr;
+        size_t allocationCount = 0u;
+        EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+        EXPECT_OAKUM_SUCCESS(oakumResolveStackTraceSymbols(allocations, allocationCount));
+        EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+    }
+    EXPECT_OAKUM_SUCCESS(oakumDeinit(true));
+
+    for (const auto &entry : std::filesystem::directory_iterator(cacheDirectory.path)) {
+        std::filesystem::resize_file(entry.path(), 13);
+    }
+
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    auto memory = allocateMemoryFunction();
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_OAKUM_SUCCESS(oakumResolveStackTraceSymbols(allocations, allocationCount));
+    expectAllocateMemoryFunctionSymbols(allocations[0]);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumSymbolCacheTest, givenTwoProcessesFlushingSameModuleWhenReadingCacheThenResultsOfBothAreKept) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    RaiiOakumIgnore ignore{};
+
+    // Both caches map the module file before any of them flushes, as concurrent runs of the same binary would
+    Oakum::SymbolCache firstCache{cacheDirectory.pathString};
+    Oakum::SymbolCache secondCache{cacheDirectory.pathString};
+    EXPECT_FALSE(firstCache.findSymbol("module", 0x10).has_value());
+    EXPECT_FALSE(secondCache.findSymbol("module", 0x20).has_value());
+    firstCache.storeSymbol("module", 0x10, "firstSymbol");
+    secondCache.storeSymbol("module", 0x20, "secondSymbol");
+    secondCache.storeSourceLocation("module", 0x10, "secondFile", 7);
+    firstCache.flush();
+    secondCache.flush();
+
+    Oakum::SymbolCache readCache{cacheDirectory.pathString};
+    const std::optional<const char *> firstSymbol = readCache.findSymbol("module", 0x10);
+    ASSERT_TRUE(firstSymbol.has_value());
+    EXPECT_STREQ("firstSymbol", firstSymbol.value());
+    const std::optional<const char *> secondSymbol = readCache.findSymbol("module", 0x20);
+    ASSERT_TRUE(secondSymbol.has_value());
+    EXPECT_STREQ("secondSymbol", secondSymbol.value());
+    const std::optional<Oakum::SymbolCache::SourceLocation> sourceLocation = readCache.findSourceLocation("module", 0x10);
+    ASSERT_TRUE(sourceLocation.has_value());
+    EXPECT_STREQ("secondFile", sourceLocation->fileName);
+    EXPECT_EQ(7u, sourceLocation->fileLine);
+}
@@ -0,0 +1,119 @@
+#include "source/thread_registry.h"
+#include "tests/common/allocate_memory_function.h"
+#include "tests/common/fixtures.h"
+
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+struct OakumThreadNamesTest : OakumTest {
+    void SetUp() override {
+        initArgs.trackThreads = true;
+        initArgs.threadSafe = true;
+    }
+};
+
+TEST_F(OakumThreadNamesTest, givenNamedThreadWhenReportingAllocationsThenReturnThreadIdAndName) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    std::unique_ptr<char[]> memory{};
+    uint64_t workerThreadId = 0u;
+    std::thread thread{[&]() {
+        pthread_setname_np(pthread_self(), "OakumWorker");
+        workerThreadId = static_cast<uint64_t>(syscall(SYS_gettid));
+        memory = allocateMemoryFunction(13);
+    }};
+    thread.join();
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_EQ(workerThreadId, allocations[0].threadId);
+    EXPECT_STREQ("OakumWorker", allocations[0].threadName);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+
+    // Main thread is registered as well, because it allocated the state of std::thread
+    size_t threadsCount{};
+    EXPECT_OAKUM_SUCCESS(oakumGetThreadStatistics(nullptr, &threadsCount));
+    RaiiOakumIgnore ignore{};
+    std::vector<OakumThreadStatistics> threads(threadsCount);
+    EXPECT_OAKUM_SUCCESS(oakumGetThreadStatistics(threads.data(), &threadsCount));
+    ASSERT_EQ(2u, threadsCount);
+    EXPECT_EQ(workerThreadId, threads[1].threadId);
+    EXPECT_STREQ("OakumWorker", threads[1].threadName);
+    EXPECT_EQ(13u, threads[1].liveBytes);
+}
+
+TEST_F(OakumThreadNamesTest, givenThreadRenamedAfterAllocatingWhenReportingAllocationsThenReturnCurrentName) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+
+    const pthread_t self = pthread_self();
+    char originalName[16] = {};
+    ASSERT_EQ(0, pthread_getname_np(self, originalName, sizeof(originalName)));
+
+    auto memory = allocateMemoryFunction(13);
+    pthread_setname_np(self, "OakumRenamed");
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    pthread_setname_np(self, originalName);
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_STREQ("OakumRenamed", allocations[0].threadName);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
+
+TEST_F(OakumThreadNamesTest, givenExitedThreadWhenRefreshingNamesThenDoNotReadNameOfThreadWithTheSameId) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    // Kernel reuses ids of exited threads, which is simulated by renaming the thread after marking it as exited
+    Oakum::ThreadRegistry registry{};
+    const char *exitedThreadName = nullptr;
+    std::thread thread{[&]() {
+        pthread_setname_np(pthread_self(), "OakumWorker");
+        Oakum::ThreadRegistry::Thread &registeredThread = registry.registerCurrentThread();
+        Oakum::ThreadRegistry::markExited(registeredThread);
+        pthread_setname_np(pthread_self(), "OakumNewThread");
+        registry.refreshNames();
+        exitedThreadName = registeredThread.name.load();
+    }};
+    thread.join();
+    EXPECT_STREQ("OakumWorker", exitedThreadName);
+}
+
+TEST_F(OakumThreadNamesTest, givenThreadExitedWhenReportingAllocationsThenKeepItsName) {
+    EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    if (!isThreadSafe()) {
+        RaiiOakumIgnore ignore;
+        GTEST_SKIP();
+    }
+
+    std::unique_ptr<char[]> memory{};
+    std::thread thread{[&memory]() {
+        pthread_setname_np(pthread_self(), "OakumWorker");
+        memory = allocateMemoryFunction(13);
+    }};
+    thread.join();
+    std::thread newThread{[]() {
+        pthread_setname_np(pthread_self(), "OakumNewThread");
+    }};
+    newThread.join();
+
+    OakumAllocation *allocations = nullptr;
+    size_t allocationCount = 0u;
+    EXPECT_OAKUM_SUCCESS(oakumGetAllocations(&allocations, &allocationCount));
+    ASSERT_EQ(1u, allocationCount);
+    EXPECT_STREQ("OakumWorker", allocations[0].threadName);
+    EXPECT_OAKUM_SUCCESS(oakumReleaseAllocations(allocations, allocationCount));
+}
@@ -33,4 +33,6 @@ struct MockSyscalls {
 
     static RaiiSyscallsBackup mockSourceLocationResolvingSuccess(const char *fileToReturn, size_t lineToReturn);
     static RaiiSyscallsBackup mockSourceLocationResolvingFail();
+
+    static RaiiSyscallsBackup mockChildProcessesForbidden();
 };
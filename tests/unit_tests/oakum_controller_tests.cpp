@@ -15,12 +15,12 @@ TEST_F(OakumControllerTest, givenThreadUnsafeOakumWhenAcquiringLockThenItIsNotLo
     OakumInitArgs args{};
     args.threadSafe = false;
     OakumControllerWhitebox oakum{args};
-    EXPECT_FALSE(oakum.getAllocationsLock().owns_lock());
+    EXPECT_EQ(Oakum::ThreadSafety::isThreadSafe(false), oakum.getAllocationsLock().owns_lock());
 }
 
 TEST_F(OakumControllerTest, givenThreadSafeOakumWhenAcquiringLockThenItIsLocked) {
     OakumInitArgs args{};
     args.threadSafe = true;
     OakumControllerWhitebox oakum{args};
-    EXPECT_TRUE(oakum.getAllocationsLock().owns_lock());
+    EXPECT_EQ(Oakum::ThreadSafety::isThreadSafe(true), oakum.getAllocationsLock().owns_lock());
 }
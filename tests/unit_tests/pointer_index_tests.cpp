@@ -0,0 +1,68 @@
+#include "source/pointer_index.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace Oakum;
+
+struct PointerIndexTest : ::testing::Test {
+    using Index = PointerIndex<int>;
+
+    static void *getPointer(size_t index) {
+        return reinterpret_cast<void *>(static_cast<uintptr_t>(index + 1) * 16);
+    }
+
+    int owner = 0;
+    Index index{false};
+};
+
+TEST_F(PointerIndexTest, givenEmptyIndexWhenTakingPointerThenReturnFalse) {
+    Index::Location location{};
+    EXPECT_FALSE(index.take(getPointer(0), location));
+    index.remove(getPointer(0));
+}
+
+TEST_F(PointerIndexTest, givenAddedPointerWhenTakingItThenReturnItsLocationOnlyOnce) {
+    index.add(getPointer(0), {&owner, 7});
+
+    Index::Location location{};
+    ASSERT_TRUE(index.take(getPointer(0), location));
+    EXPECT_EQ(&owner, location.owner);
+    EXPECT_EQ(7u, location.slot);
+    EXPECT_FALSE(index.take(getPointer(0), location));
+}
+
+TEST_F(PointerIndexTest, givenRemovedPointerWhenTakingItThenReturnFalse) {
+    index.add(getPointer(0), {&owner, 1});
+    index.add(getPointer(1), {&owner, 2});
+    index.remove(getPointer(0));
+
+    Index::Location location{};
+    EXPECT_FALSE(index.take(getPointer(0), location));
+    ASSERT_TRUE(index.take(getPointer(1), location));
+    EXPECT_EQ(2u, location.slot);
+}
+
+TEST_F(PointerIndexTest, givenManyPointersAddedAndRemovedInterleavedWhenTakingThemThenReturnCorrectLocations) {
+    // Enough pointers to grow the shards several times and to create long probe sequences, which removals have to keep intact
+    constexpr size_t pointersCount = 20000;
+    for (size_t i = 0; i < pointersCount; i++) {
+        index.add(getPointer(i), {&owner, i});
+    }
+    for (size_t i = 0; i < pointersCount; i += 3) {
+        index.remove(getPointer(i));
+    }
+
+    Index::Location location{};
+    for (size_t i = 0; i < pointersCount; i++) {
+        if (i % 3 == 0) {
+            EXPECT_FALSE(index.take(getPointer(i), location));
+        } else {
+            ASSERT_TRUE(index.take(getPointer(i), location));
+            EXPECT_EQ(i, location.slot);
+        }
+    }
+    for (size_t i = 0; i < pointersCount; i++) {
+        EXPECT_FALSE(index.take(getPointer(i), location));
+    }
+}
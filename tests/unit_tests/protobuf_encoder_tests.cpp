@@ -0,0 +1,53 @@
+#include "source/protobuf_encoder.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+TEST(ProtobufEncoderTest, givenSmallValueWhenWritingVarintThenEncodeTagAndSingleByte) {
+    Oakum::ProtobufEncoder encoder{};
+    encoder.writeVarint(1, 150 & 0x7f);
+    EXPECT_EQ(std::string("\x08\x16", 2), encoder.getBuffer());
+}
+
+TEST(ProtobufEncoderTest, givenLargeValueWhenWritingVarintThenEncodeSevenBitsPerByte) {
+    Oakum::ProtobufEncoder encoder{};
+    encoder.writeVarint(1, 150);
+    EXPECT_EQ(std::string("\x08\x96\x01", 3), encoder.getBuffer());
+
+    encoder.clear();
+    encoder.writeVarint(2, UINT64_MAX);
+    EXPECT_EQ(std::string("\x10\xff\xff\xff\xff\xff\xff\xff\xff\xff\x01", 11), encoder.getBuffer());
+}
+
+TEST(ProtobufEncoderTest, givenHighFieldNumberWhenWritingThenTagIsVarint) {
+    Oakum::ProtobufEncoder encoder{};
+    encoder.writeBool(16, true);
+    EXPECT_EQ(std::string("\x80\x01\x01", 3), encoder.getBuffer());
+}
+
+TEST(ProtobufEncoderTest, givenStringWhenWritingBytesThenPrefixWithLength) {
+    Oakum::ProtobufEncoder encoder{};
+    encoder.writeBytes(2, "testing");
+    EXPECT_EQ(std::string("\x12\x07testing", 9), encoder.getBuffer());
+
+    encoder.clear();
+    encoder.writeBytes(6, "");
+    EXPECT_EQ(std::string("\x32\x00", 2), encoder.getBuffer());
+}
+
+TEST(ProtobufEncoderTest, givenValuesWhenWritingPackedVarintsThenEncodeThemAsSingleLengthDelimitedField) {
+    const std::vector<uint64_t> values = {3, 270, 86942};
+    Oakum::ProtobufEncoder encoder{};
+    encoder.writePackedVarints(4, values.begin(), values.end());
+    EXPECT_EQ(std::string("\x22\x06\x03\x8e\x02\x9e\xa7\x05", 8), encoder.getBuffer());
+}
+
+TEST(ProtobufEncoderTest, givenNestedMessageWhenWritingThenEmbedItsEncoding) {
+    Oakum::ProtobufEncoder nested{};
+    nested.writeVarint(1, 150);
+
+    Oakum::ProtobufEncoder encoder{};
+    encoder.writeMessage(3, nested);
+    EXPECT_EQ(std::string("\x1a\x03\x08\x96\x01", 5), encoder.getBuffer());
+}
@@ -0,0 +1,56 @@
+#include "source/report_arena.h"
+#include "tests/common/fixtures.h"
+
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+
+struct ReportArenaTest : OakumTest {
+    void SetUp() override {
+        // Arena marks its chunks as ignored, which requires an initialized library
+        EXPECT_OAKUM_SUCCESS(oakumInit(&initArgs));
+    }
+};
+
+TEST_F(ReportArenaTest, givenEmptyArrayWhenAllocatingThenReturnNull) {
+    Oakum::ReportArena arena{};
+    EXPECT_EQ(nullptr, arena.allocateArray<OakumStackFrame>(0));
+    EXPECT_EQ(0u, arena.getChunksCount());
+}
+
+TEST_F(ReportArenaTest, givenMultipleArraysWhenAllocatingThenTheyAreAlignedAndShareChunk) {
+    Oakum::ReportArena arena{};
+    char *characters = arena.allocateArray<char>(3);
+    OakumStackFrame *frames = arena.allocateArray<OakumStackFrame>(4);
+    uint64_t *values = arena.allocateArray<uint64_t>(1);
+
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(frames) % alignof(OakumStackFrame));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(values) % alignof(uint64_t));
+    EXPECT_LE(reinterpret_cast<uintptr_t>(characters + 3), reinterpret_cast<uintptr_t>(frames));
+    EXPECT_LE(reinterpret_cast<uintptr_t>(frames + 4), reinterpret_cast<uintptr_t>(values));
+    EXPECT_EQ(1u, arena.getChunksCount());
+}
+
+TEST_F(ReportArenaTest, givenArrayLargerThanChunkWhenAllocatingThenItIsAllocatedInWhole) {
+    Oakum::ReportArena arena{};
+    constexpr size_t count = 1024 * 1024;
+    char *characters = arena.allocateArray<char>(count);
+    memset(characters, 'a', count);
+    EXPECT_EQ(1u, arena.getChunksCount());
+}
+
+TEST_F(ReportArenaTest, givenTheSameStringCopiedRepeatedlyWhenCopyingThenReturnTheSameCopy) {
+    Oakum::ReportArena arena{};
+    std::string source0 = "symbol";
+    std::string source1 = "symbol";
+    char *copy0 = arena.copyString(source0.c_str());
+    char *copy1 = arena.copyString(source1.c_str());
+    char *copy2 = arena.copyString("otherSymbol");
+
+    EXPECT_NE(source0.c_str(), copy0);
+    EXPECT_STREQ("symbol", copy0);
+    EXPECT_EQ(copy0, copy1);
+    EXPECT_STREQ("otherSymbol", copy2);
+    EXPECT_NE(copy0, copy2);
+}
@@ -0,0 +1,71 @@
+#include "source/stack_frame_pool.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace Oakum;
+
+TEST(StackFramePoolTest, givenNoFramesWhenAllocatingThenReturnNull) {
+    StackFrameStore store{4};
+    StackFramePool pool{store, 4};
+    EXPECT_EQ(nullptr, pool.allocate(0));
+    pool.free(nullptr, 0);
+}
+
+TEST(StackFramePoolTest, givenMultipleAllocationsWhenAllocatingThenReturnDisjointSlots) {
+    StackFrameStore store{4};
+    StackFramePool pool{store, 4};
+    void **frames0 = pool.allocate(3);
+    void **frames1 = pool.allocate(4);
+    void **frames2 = pool.allocate(1);
+    EXPECT_TRUE(frames1 >= frames0 + 3 || frames1 + 4 <= frames0);
+    EXPECT_TRUE(frames2 >= frames1 + 4 || frames2 + 1 <= frames1);
+    EXPECT_TRUE(frames2 >= frames0 + 3 || frames2 + 1 <= frames0);
+}
+
+TEST(StackFramePoolTest, givenFreedSlotWhenAllocatingTheSameNumberOfFramesThenReuseIt) {
+    StackFrameStore store{4};
+    StackFramePool pool{store, 4};
+    void **frames0 = pool.allocate(3);
+    void **frames1 = pool.allocate(3);
+    pool.free(frames0, 3);
+
+    EXPECT_NE(frames0, pool.allocate(2));
+    EXPECT_EQ(frames0, pool.allocate(3));
+    EXPECT_NE(frames1, pool.allocate(3));
+}
+
+TEST(StackFramePoolTest, givenPoolsSharingStoreWhenAllocatingThenReturnDisjointSlots) {
+    StackFrameStore store{4};
+    StackFramePool pool0{store, 4};
+    StackFramePool pool1{store, 4};
+    void **frames0 = pool0.allocate(4);
+    void **frames1 = pool1.allocate(4);
+    EXPECT_TRUE(frames1 >= frames0 + 4 || frames1 + 4 <= frames0);
+}
+
+TEST(StackFramePoolTest, givenSlotsReleasedByAnotherPoolWhenAllocatingThenReuseThem) {
+    StackFrameStore store{4};
+    StackFramePool allocatingPool{store, 4};
+    StackFramePool freeingPool{store, 4};
+    void **frames = allocatingPool.allocate(2);
+    freeingPool.free(frames, 2);
+    EXPECT_NE(frames, allocatingPool.allocate(2));
+
+    freeingPool.releaseFreeSlots();
+    EXPECT_EQ(frames, allocatingPool.allocate(2));
+}
+
+TEST(StackFramePoolTest, givenManySlotsFreedByAnotherPoolWhenAllocatingThenReuseThemWithoutExplicitRelease) {
+    StackFrameStore store{4};
+    StackFramePool allocatingPool{store, 4};
+    StackFramePool freeingPool{store, 4};
+    std::vector<void **> frames{};
+    for (size_t i = 0; i < StackFrameStore::chunkSize / 4; i++) {
+        frames.push_back(allocatingPool.allocate(4));
+    }
+    for (void **slot : frames) {
+        freeingPool.free(slot, 4);
+    }
+    EXPECT_EQ(frames.back(), allocatingPool.allocate(4));
+}
@@ -0,0 +1,34 @@
+#include "source/thread_safety_policy.h"
+
+#include <gtest/gtest.h>
+
+using namespace Oakum;
+
+TEST(ThreadSafetyPolicyTest, givenRuntimePolicyWhenAcquiringLockThenItIsLockedOnlyIfRequested) {
+    using Policy = ThreadSafetyPolicy<ThreadSafetyMode::Runtime>;
+    std::mutex mutex{};
+    EXPECT_FALSE(Policy::isThreadSafe(false));
+    EXPECT_TRUE(Policy::isThreadSafe(true));
+    EXPECT_FALSE(Policy::lock(mutex, false).owns_lock());
+    EXPECT_TRUE(Policy::lock(mutex, true).owns_lock());
+}
+
+TEST(ThreadSafetyPolicyTest, givenSingleThreadedPolicyWhenAcquiringLockThenItIsNeverLocked) {
+    using Policy = ThreadSafetyPolicy<ThreadSafetyMode::SingleThreaded>;
+    std::mutex mutex{};
+    EXPECT_FALSE(Policy::isThreadSafe(false));
+    EXPECT_FALSE(Policy::isThreadSafe(true));
+    EXPECT_FALSE(Policy::lock(mutex, false).owns_lock());
+    EXPECT_FALSE(Policy::lock(mutex, true).owns_lock());
+    EXPECT_TRUE(mutex.try_lock());
+    mutex.unlock();
+}
+
+TEST(ThreadSafetyPolicyTest, givenMutexPolicyWhenAcquiringLockThenItIsAlwaysLocked) {
+    using Policy = ThreadSafetyPolicy<ThreadSafetyMode::Mutex>;
+    std::mutex mutex{};
+    EXPECT_TRUE(Policy::isThreadSafe(false));
+    EXPECT_TRUE(Policy::isThreadSafe(true));
+    EXPECT_TRUE(Policy::lock(mutex, false).owns_lock());
+    EXPECT_TRUE(Policy::lock(mutex, true).owns_lock());
+}
@@ -0,0 +1,64 @@
+#include "source/trend_sampler.h"
+#include "tests/common/fixtures.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+struct TrendSamplerTest : ::testing::Test {
+    Oakum::CallSiteTable::CallSite &allocate(uintptr_t address, size_t size) {
+        Oakum::CallSiteTable::CallSite &site = callSites.getCallSite(reinterpret_cast<void *>(address));
+        callSites.onAllocation(site, size);
+        return site;
+    }
+
+    Oakum::CallSiteTable callSites{0u, 0u, false};
+    Oakum::TrendSampler sampler{callSites, std::chrono::milliseconds(1), 3u};
+};
+
+TEST_F(TrendSamplerTest, givenIncompleteWindowWhenGettingGrowingSitesThenReturnNothing) {
+    allocate(0x1000, 10);
+    sampler.sample();
+    allocate(0x1000, 10);
+    sampler.sample();
+    EXPECT_TRUE(sampler.getGrowingSites().empty());
+}
+
+TEST_F(TrendSamplerTest, givenLiveBytesGrowingWithinWindowWhenGettingGrowingSitesThenReturnSiteWithGrowth) {
+    Oakum::CallSiteTable::CallSite &site = allocate(0x1000, 10);
+    sampler.sample();
+    sampler.sample(); // unchanged samples do not break the trend
+    allocate(0x1000, 15);
+    sampler.sample();
+
+    const std::vector<Oakum::TrendSampler::GrowingSite> growingSites = sampler.getGrowingSites();
+    ASSERT_EQ(1u, growingSites.size());
+    EXPECT_EQ(&site, growingSites[0].site);
+    EXPECT_EQ(25u, growingSites[0].liveBytes);
+    EXPECT_EQ(15u, growingSites[0].growthBytes);
+}
+
+TEST_F(TrendSamplerTest, givenLiveBytesDecreasingOrConstantWithinWindowWhenGettingGrowingSitesThenDoNotReturnSite) {
+    Oakum::CallSiteTable::CallSite &decreasingSite = allocate(0x1000, 10);
+    allocate(0x2000, 10);
+    sampler.sample();
+    allocate(0x1000, 10);
+    sampler.sample();
+    Oakum::CallSiteTable::onDeallocation(decreasingSite, 5);
+    sampler.sample();
+    EXPECT_TRUE(sampler.getGrowingSites().empty());
+}
+
+TEST_F(TrendSamplerTest, givenDecreaseOutsideOfWindowWhenGettingGrowingSitesThenReturnSite) {
+    Oakum::CallSiteTable::CallSite &site = allocate(0x1000, 10);
+    sampler.sample();
+    Oakum::CallSiteTable::onDeallocation(site, 5);
+    for (int i = 0; i < 3; i++) {
+        allocate(0x1000, 1);
+        sampler.sample();
+    }
+
+    const std::vector<Oakum::TrendSampler::GrowingSite> growingSites = sampler.getGrowingSites();
+    ASSERT_EQ(1u, growingSites.size());
+    EXPECT_EQ(8u, growingSites[0].liveBytes);
+    EXPECT_EQ(2u, growingSites[0].growthBytes);
+}
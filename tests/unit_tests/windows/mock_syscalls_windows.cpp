@@ -55,3 +55,8 @@ RaiiSyscallsBackup MockSyscalls::mockSourceLocationResolvingFail() {
 
     return backup;
 }
+
+RaiiSyscallsBackup MockSyscalls::mockChildProcessesForbidden() {
+    // Child processes are never spawned on Windows
+    return RaiiSyscallsBackup{};
+}
@@ -0,0 +1,74 @@
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Sends a query to a process running the Oakum library with OakumInitArgs::querySocketPath set and prints the response.
+static void printUsage(const char *programName) {
+    fprintf(stderr, "Usage: %s <socket path> <query>\n", programName);
+    fprintf(stderr, "Queries:\n");
+    fprintf(stderr, "  stats                  allocation counters\n");
+    fprintf(stderr, "  top [count]            call sites with the most live bytes, 10 by default\n");
+    fprintf(stderr, "  checkpoint             identifier to pass to the since query\n");
+    fprintf(stderr, "  since <checkpoint>     live allocations made after the checkpoint\n");
+    fprintf(stderr, "  report                 all live allocations\n");
+    fprintf(stderr, "  threads                live bytes per allocating thread\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::string query = argv[2];
+    for (int argIndex = 3; argIndex < argc; argIndex++) {
+        query = query + " " + argv[argIndex];
+    }
+    query += "\n";
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (strlen(argv[1]) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Socket path is too long\n");
+        return 1;
+    }
+    strcpy(address.sun_path, argv[1]);
+
+    const int descriptor = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (descriptor == -1 || connect(descriptor, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+        fprintf(stderr, "Cannot connect to %s: %s\n", argv[1], strerror(errno));
+        return 1;
+    }
+    if (send(descriptor, query.data(), query.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(query.size())) {
+        fprintf(stderr, "Cannot send the query: %s\n", strerror(errno));
+        close(descriptor);
+        return 1;
+    }
+
+    // Response is printed as it arrives, because it may be large
+    char buffer[64 * 1024];
+    bool firstChunk = true;
+    bool failed = false;
+    ssize_t readSize = 0;
+    while ((readSize = recv(descriptor, buffer, sizeof(buffer), 0)) != 0) {
+        if (readSize < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            fprintf(stderr, "Cannot receive the response: %s\n", strerror(errno));
+            failed = true;
+            break;
+        }
+        if (firstChunk) {
+            failed = readSize >= 6 && strncmp(buffer, "error:", 6) == 0;
+            firstChunk = false;
+        }
+        fwrite(buffer, 1, static_cast<size_t>(readSize), stdout);
+    }
+    close(descriptor);
+    return failed ? 1 : 0;
+}